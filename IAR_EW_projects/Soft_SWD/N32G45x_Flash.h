@@ -13,6 +13,9 @@
 #define FLASH_PAGE_SIZE             0x800u              //   Flash 
 #define FLASH_PAGE_COUNT            256                 //   Flash 
 
+/**   SRAM N32G45x (   Flash,  ) */
+#define SRAM_ADDRESS_START          0x20000000u         //   SRAM
+
 /**  32-  FLASH */
 #define FLASH_AC        0x40022000u     /** FLASH access control register */
 #define FLASH_KEY       0x40022004u     /** FLASH key register */
@@ -0,0 +1,180 @@
+/***********************************************************************************************************************
+*   Программирование Flash памяти нескольких таргетов сразу (см. programmer_gang_Flash.h)
+***********************************************************************************************************************/
+
+#include "programmer_gang_Flash.h"
+
+/************************************************************************************************ СТАТИЧЕСКИЕ ФУНКЦИИ */
+
+/** Запись 32-битного слова памяти всех таргетов */
+static void Gang_Write_Word(uint32_t address, uint32_t value)
+{
+    SoftSWD_Gang_WriteRegister(AP, AP_TAR, address);
+    SoftSWD_Gang_WriteRegister(AP, AP_DRW, value);
+}
+
+/** Разблокировка Flash-контроллеров и сброс флагов ошибок от прошлых операций */
+static void Gang_Unlock_Flash(void)
+{
+    SoftSWD_Gang_WriteRegister(AP, AP_TAR, FLASH_KEY);
+    SoftSWD_Gang_WriteRegister(AP, AP_DRW, KEY1);
+    SoftSWD_Gang_WriteRegister(AP, AP_DRW, KEY2);
+    Gang_Write_Word(FLASH_STS, FLASH_STS_PGERR | FLASH_STS_PVERR | FLASH_STS_WRPERR | FLASH_STS_EOP);
+}
+
+/** Ожидание сброса FLASH_STS_BUSY у всех таргетов: таргет с ошибкой записи или без конца операции исключается */
+static void Gang_Wait_FLASH(void)
+{
+    uint32_t status[SOFT_SWD_GANG_TARGETS];
+    uint32_t busy = soft_swd_gang.active;
+
+    for (uint32_t timeout = GANG_FLASH_TIMEOUT; busy && timeout; timeout--)
+    {
+        SoftSWD_Gang_WriteRegister(AP, AP_TAR, FLASH_STS);
+        SoftSWD_Gang_ReadRegister(AP, AP_DRW, status);
+        busy &= SoftSWD_Gang_ReadRegister(DP, DP_RDBUFF, status);
+
+        for (uint32_t t = 0; t < SOFT_SWD_GANG_TARGETS; t++)
+        {
+            uint32_t bit = 0x1U << t;
+            if (!(busy & bit)) continue;
+            if (status[t] & FLASH_STS_BUSY) continue;
+
+            uint32_t errors = status[t] & (FLASH_STS_PGERR | FLASH_STS_PVERR | FLASH_STS_WRPERR);
+            busy &= ~bit;
+            if (errors) SoftSWD_Gang_Fail(bit, errors);
+        }
+    }
+
+    SoftSWD_Gang_Fail(busy, SOFT_SWD_GANG_ERROR_TIMEOUT);
+}
+
+/** Слово образа, хвост дополняется 0xFF (стертое состояние Flash) */
+static uint32_t Gang_Image_Word(uint8_t* program_data, uint32_t program_size, uint32_t index)
+{
+    uint32_t data = 0xFFFFFFFF;
+    uint32_t bytes = program_size - (index * 4);
+    if (bytes > 4) bytes = 4;
+
+    for (uint32_t b = 0; b < bytes; b++)
+    {
+        data &= ~(0xFFU << (b * 8));
+        data |= (uint32_t)program_data[(index * 4) + b] << (b * 8);
+    }
+    return data;
+}
+/**********************************************************************************************************************/
+
+
+/************************************************************************************************* ГЛОБАЛЬНЫЕ ФУНКЦИИ */
+
+/** Стирание */
+uint32_t Erase_Flash_Gang(uint32_t start_address, uint32_t size)
+{
+    // 1. MEM-AP, CSW без автоинкремента, разблокировка
+    SoftSWD_Gang_set_MEM_AP();
+    SoftSWD_Gang_WriteRegister(AP, AP_CSW, MEM_AP_DEFAULT);
+    Gang_Unlock_Flash();
+
+    // 2. Страницы по очереди, все таргеты стирают одновременно
+    uint32_t num_pages = (size + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE;
+    for (uint32_t p = 0; (p < num_pages) && soft_swd_gang.active; p++)
+    {
+        Gang_Write_Word(FLASH_ADD, start_address + (p * FLASH_PAGE_SIZE));
+        Gang_Write_Word(FLASH_CTRL, FLASH_CTRL_PER | FLASH_CTRL_START);
+        Gang_Wait_FLASH();
+    }
+
+    // 3. Блокировка Flash
+    Gang_Write_Word(FLASH_CTRL, FLASH_CTRL_LOCK);
+    return soft_swd_gang.active;
+}
+
+/** Запись блоками */
+uint32_t Program_Flash_Gang(uint32_t start_address, uint8_t* program_data, uint32_t program_size)
+{
+    // 1. MEM-AP, CSW без автоинкремента: ключи разблокировки пишутся дважды в один и тот же FLASH_KEY
+    SoftSWD_Gang_set_MEM_AP();
+    SoftSWD_Gang_WriteRegister(AP, AP_CSW, MEM_AP_DEFAULT);
+    Gang_Unlock_Flash();
+
+    // 2. Режим программирования, автоинкремент TAR - один раз на весь образ
+    Gang_Write_Word(FLASH_CTRL, FLASH_CTRL_PG);
+    SoftSWD_Gang_WriteRegister(AP, AP_CSW, MEM_AP_DEFAULT | AP_CSW_ADDRINC);
+
+    // 3. Слова DRW подряд: пока контроллеры программируют слово, таргеты отвечают WAIT и повторяют транзакцию
+    //    отдельно от остальных. На границах 1 КБ - TAR, BUSY и ошибки каждого таргета
+    uint32_t operations = (program_size + 3) / 4;
+    for (uint32_t i = 0; (i < operations) && soft_swd_gang.active; i++)
+    {
+        uint32_t current_addr = start_address + (i * 4);
+
+        if (i == 0 || (current_addr & (SOFT_SWD_TAR_WRAP - 1)) == 0)
+        {
+            if (i != 0) Gang_Wait_FLASH();
+            SoftSWD_Gang_WriteRegister(AP, AP_TAR, current_addr);
+        }
+
+        SoftSWD_Gang_WriteRegister(AP, AP_DRW, Gang_Image_Word(program_data, program_size, i));
+    }
+
+    // 4. Последний блок, CSW без автоинкремента, блокировка
+    Gang_Wait_FLASH();
+    SoftSWD_Gang_WriteRegister(AP, AP_CSW, MEM_AP_DEFAULT);
+    Gang_Write_Word(FLASH_CTRL, FLASH_CTRL_LOCK);
+    return soft_swd_gang.active;
+}
+
+/** Сверка */
+uint32_t Verify_Flash_Gang(uint32_t start_address, uint8_t* program_data, uint32_t program_size)
+{
+    uint32_t values[SOFT_SWD_GANG_TARGETS];
+    uint32_t restart = 1;
+
+    SoftSWD_Gang_set_MEM_AP();
+    SoftSWD_Gang_WriteRegister(AP, AP_CSW, MEM_AP_DEFAULT | AP_CSW_ADDRINC);
+
+    // Первое чтение DRW блока только запускает обращение к шине, последнее слово блока - из RDBUFF
+    uint32_t operations = (program_size + 3) / 4;
+    for (uint32_t i = 0; (i < operations) && soft_swd_gang.active; i++)
+    {
+        uint32_t current_addr = start_address + (i * 4);
+        uint32_t block_last = ((current_addr + 4) & (SOFT_SWD_TAR_WRAP - 1)) == 0;
+
+        if (restart || (current_addr & (SOFT_SWD_TAR_WRAP - 1)) == 0)
+        {
+            SoftSWD_Gang_WriteRegister(AP, AP_TAR, current_addr);
+            SoftSWD_Gang_ReadRegister(AP, AP_DRW, values);
+            restart = 0;
+        }
+
+        if ((i + 1 < operations) && !block_last) SoftSWD_Gang_ReadRegister(AP, AP_DRW, values);
+        else SoftSWD_Gang_ReadRegister(DP, DP_RDBUFF, values);
+
+        uint32_t expected = Gang_Image_Word(program_data, program_size, i);
+        uint32_t bytes = program_size - (i * 4);
+        uint32_t mask = (bytes >= 4) ? 0xFFFFFFFF : ((0x1U << (bytes * 8)) - 1);
+        uint32_t mismatch = 0;
+
+        for (uint32_t t = 0; t < SOFT_SWD_GANG_TARGETS; t++)
+        {
+            if ((soft_swd_gang.active & (0x1U << t)) && ((values[t] ^ expected) & mask)) mismatch |= 0x1U << t;
+        }
+        if (!mismatch) continue;
+
+        // Повтор чтения слова по адресу: после ошибки четности повтор DRW уже сдвинул TAR этого таргета
+        SoftSWD_Gang_WriteRegister(AP, AP_TAR, current_addr);
+        SoftSWD_Gang_ReadRegister(AP, AP_DRW, values);
+        SoftSWD_Gang_ReadRegister(DP, DP_RDBUFF, values);
+        restart = 1;
+
+        for (uint32_t t = 0; t < SOFT_SWD_GANG_TARGETS; t++)
+        {
+            uint32_t bit = 0x1U << t;
+            if ((mismatch & bit) && ((values[t] ^ expected) & mask)) SoftSWD_Gang_Fail(bit, FLASH_ERROR_VERIFY);
+        }
+    }
+
+    SoftSWD_Gang_WriteRegister(AP, AP_CSW, MEM_AP_DEFAULT);
+    return soft_swd_gang.active;
+}
@@ -0,0 +1,34 @@
+/***********************************************************************************************************************
+*   Программирование Flash памяти нескольких таргетов сразу через soft_SWD_gang
+*       Та же последовательность, что Erase_Flash_size и Program_Flash_Block, но каждая транзакция идет всем
+*   таргетам в работе одновременно. FLASH_STS читается у каждого таргета: таргет с ошибкой Flash исключается
+*   из soft_swd_gang.active (флаги FLASH_STS - в soft_swd_gang.errors[t]), остальные дописываются до конца.
+*   Все функции возвращают маску таргетов, прошедших операцию без ошибок.
+*   Пример:
+*       SoftSWD_Gang_Init(SOFT_SWD_GANG_ALL);
+*       SoftSWD_Gang_Connect();
+*       Erase_Flash_Gang(FLASH_ADDRESS_START, size);
+*       Program_Flash_Gang(FLASH_ADDRESS_START, image, size);
+*       uint32_t good = Verify_Flash_Gang(FLASH_ADDRESS_START, image, size);
+***********************************************************************************************************************/
+
+#ifndef __PROGRAMMER_GANG_FLASH_H__
+#define __PROGRAMMER_GANG_FLASH_H__
+
+#include "soft_SWD_gang.h"
+#include "programmer_target_Flash.h"
+
+#define GANG_FLASH_TIMEOUT      (100000)    // Опросов FLASH_STS до исключения таргета с занятым контроллером
+
+/** Стирание страниц под образ размером size */
+uint32_t Erase_Flash_Gang(uint32_t start_address, uint32_t size);
+
+/** Запись блоками, как Program_Flash_Block: TAR на границах 1 КБ, там же проверка BUSY и ошибок каждого таргета.
+*   Хвост образа, не кратный 4 байтам, дополняется 0xFF */
+uint32_t Program_Flash_Gang(uint32_t start_address, uint8_t* program_data, uint32_t program_size);
+
+/** Сверка Flash с образом: слова читаются у всех таргетов одним чтением, при несовпадении таргет исключается
+*   с FLASH_ERROR_VERIFY */
+uint32_t Verify_Flash_Gang(uint32_t start_address, uint8_t* program_data, uint32_t program_size);
+
+#endif /* __PROGRAMMER_GANG_FLASH_H__ */
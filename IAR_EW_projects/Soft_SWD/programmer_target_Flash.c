@@ -4,14 +4,42 @@
 
 #include "programmer_target_Flash.h"
 #include "systick.h"
+#include "crc32.h"
+
+/**     (Program_Flash_Incremental) */
+Flash_Incremental_Stats_t flash_incremental = {0, 0, 0};
 /************************************************************************************************   */
 
-/**  Flash- */
-static void Unlock_Flash()
+/**     SWD: 0 - SOFT_SWD_OK,  FLASH_ERROR_SWD */
+static uint32_t Swd_Error(SoftSWD_Status_t status)
+{
+    return (status == SOFT_SWD_OK) ? 0 : FLASH_ERROR_SWD;
+}
+
+/**  32-    (TAR   ,       CSW) */
+static SoftSWD_Status_t Read_Target_Word(uint32_t address, uint32_t* value)
+{
+    SoftSWD_Status_t status = SoftSWD_Write(AP, AP_TAR, address);
+    if (status == SOFT_SWD_OK) status = SoftSWD_Read(AP, AP_DRW, value);
+    if (status == SOFT_SWD_OK) status = SoftSWD_Read(DP, DP_RDBUFF, value);
+    return status;
+}
+
+/**  32-    */
+static SoftSWD_Status_t Write_Target_Word(uint32_t address, uint32_t value)
+{
+    SoftSWD_Status_t status = SoftSWD_Write(AP, AP_TAR, address);
+    if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_DRW, value);
+    return status;
+}
+
+/**  Flash- (CSW  :   -      FLASH_KEY) */
+static SoftSWD_Status_t Unlock_Flash()
 {
-    SoftSWD_WriteRegister(AP, AP_TAR, FLASH_KEY);
-    SoftSWD_WriteRegister(AP, AP_DRW, KEY1);
-    SoftSWD_WriteRegister(AP, AP_DRW, KEY2);
+    SoftSWD_Status_t status = SoftSWD_Write(AP, AP_TAR, FLASH_KEY);
+    if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_DRW, KEY1);
+    if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_DRW, KEY2);
+    return status;
 }
 
 /**  Flash Option Bytes */
@@ -23,105 +51,292 @@ static void Unlock_Flash()
 //}
 
 /**  Flash- */
-static void Lock_Flash()
+static SoftSWD_Status_t Lock_Flash()
 {
-    SoftSWD_WriteRegister(AP, AP_TAR, FLASH_CTRL);
-    SoftSWD_WriteRegister(AP, AP_DRW, FLASH_CTRL_LOCK);
+    return Write_Target_Word(FLASH_CTRL, FLASH_CTRL_LOCK);
 }
 
 /**       (   FLASH_STS_BUSY) */
-static void Wait_FLASH_STS_BUSY()
+static SoftSWD_Status_t Wait_FLASH_STS_BUSY()
+{
+    uint32_t status = 0x01;
+    SoftSWD_Status_t swd = SoftSWD_Write(AP, AP_TAR, FLASH_STS);
+    while ((swd == SOFT_SWD_OK) && (status & 0x01))
+    {
+        swd = SoftSWD_Read(AP, AP_DRW, &status);
+        if (swd == SOFT_SWD_OK) swd = SoftSWD_Read(DP, DP_RDBUFF, &status);
+    }
+    return swd;
+}
+
+/**   FLASH_STS_BUSY      (FLASH_ERROR_SWD - FLASH_STS  ) */
+static uint32_t Wait_FLASH_Errors()
 {
     uint32_t status;
-    SoftSWD_WriteRegister(AP, AP_TAR, FLASH_STS);
     do
     {
-        SoftSWD_ReadRegister(AP, AP_DRW);
-        status = SoftSWD_ReadRegister(DP, DP_RDBUFF);
-    } while (status & 0x01);
+        if (Read_Target_Word(FLASH_STS, &status) != SOFT_SWD_OK) return FLASH_ERROR_SWD;
+    } while (status & FLASH_STS_BUSY);
+
+    return status & (FLASH_STS_PGERR | FLASH_STS_PVERR | FLASH_STS_WRPERR);
 }
 
-/**  4    32-  */
-static uint32_t pack_words(uint8_t* buffer)
+/**   4    32- :    (bytes < 4)  ,  
+*    - 0xFF (  Flash) */
+static uint32_t pack_words(uint8_t* buffer, uint32_t bytes)
 {
     uint32_t data = 0;
-    data |= (uint32_t)buffer[0];
-    data |= (uint32_t)buffer[1] << 8;
-    data |= (uint32_t)buffer[2] << 16;
-    data |= (uint32_t)buffer[3] << 24;
+    for (uint32_t i = 0; i < 4; i++) data |= (uint32_t)((i < bytes) ? buffer[i] : 0xFF) << (i * 8);
     return data;
 }
 
+/**   Flash (Thumb-2, Cortex-M3/M4),   LOADER_CODE_ADDRESS
+*       r0 -   Flash, r1 -   RAM, r2 -  , r3 - FLASH_AC, r7 -   */
+static const uint16_t loader_code[] =
+{
+    0x2401,             //          movs  r4, #1
+    0x611C,             //          str   r4, [r3, #0x10]     ; FLASH_CTRL = PG
+    0xF851, 0x4B04,     // copy:    ldr   r4, [r1], #4
+    0xF840, 0x4B04,     //          str   r4, [r0], #4
+    0x68DD,             // wait:    ldr   r5, [r3, #0x0C]     ; FLASH_STS
+    0x07EE,             //          lsls  r6, r5, #31         ; BUSY
+    0xD1FC,             //          bne   wait
+    0xF015, 0x0F1C,     //          tst   r5, #0x1C           ; PGERR | PVERR | WRPERR
+    0xD101,             //          bne   done
+    0x1E52,             //          subs  r2, r2, #1
+    0xD1F3,             //          bne   copy
+    0x2400,             // done:    movs  r4, #0
+    0x611C,             //          str   r4, [r3, #0x10]     ; FLASH_CTRL = 0
+    0xF005, 0x051C,     //          and   r5, r5, #0x1C
+    0x603D,             //          str   r5, [r7]            ;   =  
+    0xBE00              //          bkpt  #0                  ;  
+};
+
+/**       DCRDR/DCRSR, SOFT_SWD_ERROR_TIMEOUT -   
+*   S_REGRDY */
+static SoftSWD_Status_t Write_Core_Register(uint32_t reg, uint32_t value)
+{
+    SoftSWD_Status_t status = Write_Target_Word(DCRDR_ADDRESS, value);
+    if (status == SOFT_SWD_OK) status = Write_Target_Word(DCRSR_ADDRESS, reg | CoreDebug_DCRSR_REGWnR_Msk);
+
+    uint32_t timeout = 1000;
+    uint32_t dhcsr = 0;
+    while (status == SOFT_SWD_OK)
+    {
+        status = Read_Target_Word(CoreDebug_BASE, &dhcsr);
+        if ((status != SOFT_SWD_OK) || (dhcsr & CoreDebug_DHCSR_S_REGRDY_Msk)) break;
+        if (--timeout == 0) status = SOFT_SWD_ERROR_TIMEOUT;
+    }
+    return status;
+}
+
+/**    LOADER_CODE_ADDRESS  :  r0-r3, r7, PC, xPSR     */
+static SoftSWD_Status_t Core_Start(uint32_t r0, uint32_t r1, uint32_t r2, uint32_t r3, uint32_t r7)
+{
+    const uint32_t regs[][2] =
+    {
+        {CORE_REG_R0, r0}, {CORE_REG_R1, r1}, {CORE_REG_R2, r2}, {CORE_REG_R3, r3}, {CORE_REG_R7, r7},
+        {CORE_REG_PC, LOADER_CODE_ADDRESS}, {CORE_REG_XPSR, XPSR_THUMB}
+    };
+    SoftSWD_Status_t status = SOFT_SWD_OK;
+
+    for (uint32_t i = 0; (i < sizeof(regs) / sizeof(regs[0])) && (status == SOFT_SWD_OK); i++)
+    {
+        status = Write_Core_Register(regs[i][0], regs[i][1]);
+    }
+    if (status == SOFT_SWD_OK) status = Write_Target_Word(CoreDebug_BASE, DHCSR_CMD_RUN_MASKINTS);
+    return status;
+}
+
+/**     (,   4 ,  0xFF) */
+static SoftSWD_Status_t Loader_Fill_Buffer(uint32_t buffer_address, uint8_t* data, uint32_t size)
+{
+    SoftSWD_Status_t status = SOFT_SWD_OK;
+    uint32_t aligned = size & ~0x3u;
+    if (aligned) status = SoftSWD_WriteMemory_RAM(buffer_address, data, aligned);
+
+    if ((status == SOFT_SWD_OK) && (size != aligned))
+    {
+        status = Write_Target_Word(buffer_address + aligned, pack_words(data + aligned, size - aligned));
+    }
+    return status;
+}
+
+/**      */
+static SoftSWD_Status_t Loader_Start(uint32_t flash_address, uint32_t buffer_address, uint32_t size)
+{
+    SoftSWD_Status_t status = Write_Target_Word(LOADER_MAILBOX_ADDRESS, LOADER_MAILBOX_BUSY);
+    if (status == SOFT_SWD_OK)
+    {
+        status = Core_Start(flash_address, buffer_address, (size + 3) / 4, FLASH_AC, LOADER_MAILBOX_ADDRESS);
+    }
+    return status;
+}
+
+/**     BKPT, SOFT_SWD_ERROR_TIMEOUT -     LOADER_TIMEOUT  */
+static SoftSWD_Status_t Wait_Core_Halt()
+{
+    uint32_t timeout = LOADER_TIMEOUT;
+    uint32_t dhcsr = 0;
+    SoftSWD_Status_t status;
+
+    while ((status = Read_Target_Word(CoreDebug_BASE, &dhcsr)) == SOFT_SWD_OK)
+    {
+        if (dhcsr & CoreDebug_DHCSR_S_HALT_Msk) break;
+        if (--timeout == 0) return SOFT_SWD_ERROR_TIMEOUT;
+    }
+    return status;
+}
+
+/**     BKPT       */
+static uint32_t Loader_Wait()
+{
+    uint32_t mailbox = LOADER_MAILBOX_BUSY;
+    SoftSWD_Status_t status = Wait_Core_Halt();
+    if (status == SOFT_SWD_OK) status = Read_Target_Word(LOADER_MAILBOX_ADDRESS, &mailbox);
+
+    if (status == SOFT_SWD_ERROR_TIMEOUT) return LOADER_ERROR_TIMEOUT;
+    if (status != SOFT_SWD_OK) return FLASH_ERROR_SWD;
+    return (mailbox == LOADER_MAILBOX_BUSY) ? LOADER_ERROR_TIMEOUT : mailbox;
+}
+
+/**   CRC  Flash (Thumb-2),   LOADER_CODE_ADDRESS
+*       r0 -   Flash, r1 -   , r2 -  , r3 - , r7 - CRC32_Nibble_Table
+*     XOR-  CRC   8    -  ,  CRC32  4  little-endian */
+static const uint16_t crc_stub_code[] =
+{
+    0xF04F, 0x34FF,     // page:    mov.w r4, #0xFFFFFFFF     ; CRC32_INIT
+    0x460D,             //          mov   r5, r1
+    0xF850, 0x6B04,     // word:    ldr   r6, [r0], #4
+    0x4074,             //          eors  r4, r6
+    0x2608,             //          movs  r6, #8
+    0xF004, 0x080F,     // nibble:  and   r8, r4, #0x0F
+    0xF857, 0x8028,     //          ldr   r8, [r7, r8, lsl #2]
+    0xEA88, 0x1414,     //          eor   r4, r8, r4, lsr #4
+    0x1E76,             //          subs  r6, r6, #1
+    0xD1F7,             //          bne   nibble
+    0x1E6D,             //          subs  r5, r5, #1
+    0xD1F1,             //          bne   word
+    0x43E4,             //          mvns  r4, r4
+    0xF843, 0x4B04,     //          str   r4, [r3], #4        ; CRC 
+    0x1E52,             //          subs  r2, r2, #1
+    0xD1E9,             //          bne   page
+    0xBE00              //          bkpt  #0                  ;  
+};
+
+/** CRC    (    ,     ), 0 -  
+*        */
+static uint8_t Target_Page_CRC_Stub(uint32_t address, uint32_t pages, uint32_t* crcs)
+{
+    SoftSWD_Status_t status = Core_Start(address, FLASH_PAGE_SIZE / 4, pages, CRC_STUB_RESULT_ADDRESS,
+                                         CRC_STUB_TABLE_ADDRESS);
+    if (status == SOFT_SWD_OK) status = Wait_Core_Halt();
+
+    if (status != SOFT_SWD_OK)
+    {
+        Target_Halt();
+        return 0;
+    }
+    return SoftSWD_ReadMemory_Stream(CRC_STUB_RESULT_ADDRESS, (uint8_t*)crcs, pages * 4) == SOFT_SWD_OK;
+}
+
+/** CRC  :  ,    ,    .
+*    stub - 1,  CRC  .  FLASH_ERROR_SWD,     */
+static uint32_t Target_Page_CRC(uint32_t address, uint32_t pages, uint32_t* crcs, uint32_t* stub)
+{
+    static uint8_t page_buffer[FLASH_PAGE_SIZE];
+
+    *stub = Target_Page_CRC_Stub(address, pages, crcs);
+    if (*stub) return 0;
+
+    for (uint32_t p = 0; p < pages; p++)
+    {
+        SoftSWD_Status_t status = SoftSWD_ReadMemory_Stream(address + (p * FLASH_PAGE_SIZE), page_buffer, FLASH_PAGE_SIZE);
+        if (status != SOFT_SWD_OK) return FLASH_ERROR_SWD;
+        crcs[p] = CRC32(page_buffer, FLASH_PAGE_SIZE);
+    }
+    return 0;
+}
+
+/** CRC  :     -  Flash (0xFF) */
+static uint32_t Image_Page_CRC(uint8_t* data, uint32_t size)
+{
+    static const uint8_t erased = 0xFF;
+    uint32_t crc = CRC32_Update(CRC32_INIT, data, size);
+    for (uint32_t i = size; i < FLASH_PAGE_SIZE; i++) crc = CRC32_Update(crc, &erased, 1);
+    return crc ^ CRC32_INIT;
+}
+
 
 /*************************************************************************************************   */
 
 /**        */
-void Erase_Flash_size(uint32_t start_address, uint32_t size)
+uint32_t Erase_Flash_size(uint32_t start_address, uint32_t size)
 {
     // 1.      MEM-AP (  CTRL/STAT   AP 0, Bank 0)
-    SoftSWD_set_MEM_AP();
+    SoftSWD_Status_t status = SoftSWD_set_MEM_AP();
 
     // 2.   CSW
-    SoftSWD_WriteRegister(AP, AP_CSW, MEM_AP_DEFAULT);
+    if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_CSW, MEM_AP_DEFAULT);
 
     // 3.  Flash- (Unlock)
-    Unlock_Flash();
+    if (status == SOFT_SWD_OK) status = Unlock_Flash();
 
-    // 4.    
+    // 4.    ,    SWD
     uint32_t num_pages = (size + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE;
-    for (uint32_t p = 0; p < num_pages; p++)
+    for (uint32_t p = 0; (p < num_pages) && (status == SOFT_SWD_OK); p++)
     {
         uint32_t page_addr = start_address + (p * FLASH_PAGE_SIZE);
 
         //  
-        SoftSWD_WriteRegister(AP, AP_TAR, FLASH_ADD);
-        SoftSWD_WriteRegister(AP, AP_DRW, page_addr);
+        status = Write_Target_Word(FLASH_ADD, page_addr);
 
         //   (PER + START)
-        SoftSWD_WriteRegister(AP, AP_TAR, FLASH_CTRL);
-        SoftSWD_WriteRegister(AP, AP_DRW, FLASH_CTRL_PER | FLASH_CTRL_START);
+        if (status == SOFT_SWD_OK) status = Write_Target_Word(FLASH_CTRL, FLASH_CTRL_PER | FLASH_CTRL_START);
 
         //     FLASH_STS_BUSY
-        Wait_FLASH_STS_BUSY();
+        if (status == SOFT_SWD_OK) status = Wait_FLASH_STS_BUSY();
     }
 
-    // 5.  Flash
-    Lock_Flash();
+    // 5.  Flash (  )
+    SoftSWD_Status_t lock = Lock_Flash();
+    return Swd_Error((status == SOFT_SWD_OK) ? lock : status);
 }
 
 /**   Flash */
-void Erase_Flash_All()
+uint32_t Erase_Flash_All()
 {
     // 1.      MEM-AP (  CTRL/STAT   AP 0, Bank 0)
-    SoftSWD_set_MEM_AP();
+    SoftSWD_Status_t status = SoftSWD_set_MEM_AP();
 
     // 2.   CSW
-    SoftSWD_WriteRegister(AP, AP_CSW, MEM_AP_DEFAULT);
+    if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_CSW, MEM_AP_DEFAULT);
 
     // 3.  Flash
-    Unlock_Flash();
+    if (status == SOFT_SWD_OK) status = Unlock_Flash();
 
     // 4.    (MER + START)
     // 4.1       
-    SoftSWD_WriteRegister(AP, AP_TAR, FLASH_CTRL);
-    SoftSWD_WriteRegister(AP, AP_DRW, FLASH_CTRL_MER);
+    if (status == SOFT_SWD_OK) status = Write_Target_Word(FLASH_CTRL, FLASH_CTRL_MER);
 
     // 4.2     
-    SoftSWD_WriteRegister(AP, AP_TAR, FLASH_CTRL);
-    SoftSWD_WriteRegister(AP, AP_DRW, FLASH_CTRL_MER | FLASH_CTRL_START);
+    if (status == SOFT_SWD_OK) status = Write_Target_Word(FLASH_CTRL, FLASH_CTRL_MER | FLASH_CTRL_START);
 
     // 5.     FLASH_STS_BUSY
-    Wait_FLASH_STS_BUSY();
+    if (status == SOFT_SWD_OK) status = Wait_FLASH_STS_BUSY();
 
-    // 6.  Flash
-    Lock_Flash();
+    // 6.  Flash (  )
+    SoftSWD_Status_t lock = Lock_Flash();
+    if (status == SOFT_SWD_OK) status = lock;
 
     delay_ms(10);
     // 7.  
     SoftSWD_Reset_Target();
 
-    // 8.        ,     
-    Target_Halt();
+    // 8.        ,     . , 
+    //     , - :     
+    SoftSWD_Status_t halt = Target_Halt();
+    return Swd_Error((status == SOFT_SWD_OK) ? halt : status);
 }
 
 
@@ -147,7 +362,7 @@ void Program_Flash(uint32_t start_address, uint8_t* program_data, uint32_t progr
     uint32_t operations = (program_size + 3) / 4;
     for (uint32_t i = 0; i < operations; i++)
     {
-        uint32_t data_to_write = pack_words(program_data + (i * 4));
+        uint32_t data_to_write = pack_words(program_data + (i * 4), program_size - (i * 4));
         uint32_t current_addr = start_address + (i * 4);
 
         //  32-  
@@ -162,6 +377,199 @@ void Program_Flash(uint32_t start_address, uint8_t* program_data, uint32_t progr
     Lock_Flash();
 }
 
+/**   flash   */
+uint32_t Program_Flash_Block(uint32_t start_address, uint8_t* program_data, uint32_t program_size)
+{
+    uint32_t errors = 0;
+
+    // 1.      MEM-AP (  CTRL/STAT   AP 0, Bank 0)
+    SoftSWD_Status_t status = SoftSWD_set_MEM_AP();
+
+    // 2. CSW  :          FLASH_KEY
+    if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_CSW, MEM_AP_DEFAULT);
+
+    // 3.  Flash-        (  1)
+    if (status == SOFT_SWD_OK) status = Unlock_Flash();
+    if (status == SOFT_SWD_OK)
+    {
+        status = Write_Target_Word(FLASH_STS, FLASH_STS_PGERR | FLASH_STS_PVERR | FLASH_STS_WRPERR | FLASH_STS_EOP);
+    }
+
+    // 4.   (PG)
+    if (status == SOFT_SWD_OK) status = Write_Target_Word(FLASH_CTRL, FLASH_CTRL_PG);
+
+    // 5.  TAR -     
+    if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_CSW, MEM_AP_DEFAULT | AP_CSW_ADDRINC);
+
+    // 6.  :  DRW ,    ,    
+    //     ( ACK WAIT   SoftSWD_Write),  FLASH_STS    
+    //    . TAR      1 ,    BUSY   .
+    //       (   WAIT   )  :   ,  
+    //         
+    uint32_t operations = (program_size + 3) / 4;
+    for (uint32_t i = 0; (i < operations) && (status == SOFT_SWD_OK); i++)
+    {
+        uint32_t current_addr = start_address + (i * 4);
+
+        if (i == 0 || (current_addr & (SOFT_SWD_TAR_WRAP - 1)) == 0)
+        {
+            if (i != 0)
+            {
+                errors |= Wait_FLASH_Errors();
+                if (errors) break;
+            }
+            status = SoftSWD_Write(AP, AP_TAR, current_addr);
+        }
+
+        //  ,   4 ,  0xFF (  Flash)
+        if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_DRW, pack_words(program_data + (i * 4), program_size - (i * 4)));
+    }
+
+    // 7.  , CSW   (    )   Flash -  
+    //    ,  Flash   
+    if (status == SOFT_SWD_OK) errors |= Wait_FLASH_Errors();
+    SoftSWD_Status_t restore = SoftSWD_Write(AP, AP_CSW, MEM_AP_DEFAULT);
+    if (restore == SOFT_SWD_OK) restore = Lock_Flash();
+    if (status == SOFT_SWD_OK) status = restore;
+
+    return errors | Swd_Error(status);
+}
+
+/**   flash    RAM  */
+uint32_t Program_Flash_Loader(uint32_t start_address, uint8_t* program_data, uint32_t program_size)
+{
+    uint32_t errors = 0;
+    const uint32_t buffers[2] = {LOADER_BUFFER0_ADDRESS, LOADER_BUFFER1_ADDRESS};
+
+    // 1.      MEM-AP, CSW  
+    SoftSWD_Status_t status = SoftSWD_set_MEM_AP();
+    if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_CSW, MEM_AP_DEFAULT);
+
+    // 2.       
+    if (status == SOFT_SWD_OK) status = Target_Halt();
+    if (status != SOFT_SWD_OK) return FLASH_ERROR_SWD;
+
+    // 3.    RAM 
+    status = SoftSWD_WriteMemory_RAM(LOADER_CODE_ADDRESS, (uint8_t*)loader_code, sizeof(loader_code));
+
+    // 4.  Flash-     ( PG   )
+    if (status == SOFT_SWD_OK) status = Unlock_Flash();
+    if (status == SOFT_SWD_OK)
+    {
+        status = Write_Target_Word(FLASH_STS, FLASH_STS_PGERR | FLASH_STS_PVERR | FLASH_STS_WRPERR | FLASH_STS_EOP);
+    }
+
+    // 5.      :       ,   .
+    //     SWD  ,  ,    , 
+    uint32_t pages = (program_size + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE;
+    uint32_t first_size = (program_size < FLASH_PAGE_SIZE) ? program_size : FLASH_PAGE_SIZE;
+    if (pages && (status == SOFT_SWD_OK)) status = Loader_Fill_Buffer(buffers[0], program_data, first_size);
+
+    for (uint32_t p = 0; (p < pages) && (status == SOFT_SWD_OK); p++)
+    {
+        uint32_t offset = p * FLASH_PAGE_SIZE;
+        uint32_t size = program_size - offset;
+        if (size > FLASH_PAGE_SIZE) size = FLASH_PAGE_SIZE;
+
+        status = Loader_Start(start_address + offset, buffers[p & 1], size);
+        if (status != SOFT_SWD_OK) break;
+
+        if (p + 1 < pages)
+        {
+            uint32_t next_size = program_size - offset - FLASH_PAGE_SIZE;
+            if (next_size > FLASH_PAGE_SIZE) next_size = FLASH_PAGE_SIZE;
+            status = Loader_Fill_Buffer(buffers[(p + 1) & 1], program_data + offset + FLASH_PAGE_SIZE, next_size);
+        }
+
+        errors |= Loader_Wait();
+        if (errors) break;
+    }
+
+    // 6.  Flash (  ,  - Target_Run  ). ,   
+    //     BKPT     SWD, 
+    if ((errors & (LOADER_ERROR_TIMEOUT | FLASH_ERROR_SWD)) || (status != SOFT_SWD_OK)) Target_Halt();
+    SoftSWD_Status_t lock = Lock_Flash();
+    if (status == SOFT_SWD_OK) status = lock;
+
+    return errors | Swd_Error(status);
+}
+
+/**    flash  */
+uint32_t Program_Flash_Incremental(uint32_t start_address, uint8_t* program_data, uint32_t program_size)
+{
+    static uint32_t image_crc[FLASH_PAGE_COUNT];
+    static uint32_t target_crc[FLASH_PAGE_COUNT];
+    uint32_t errors = 0;
+    uint32_t pages = (program_size + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE;
+    if (pages > FLASH_PAGE_COUNT) pages = FLASH_PAGE_COUNT;
+
+    flash_incremental.pages = pages;
+    flash_incremental.changed = 0;
+    flash_incremental.stub = 0;
+
+    //  :  .  CRC  r2 = 0   -      
+    // ,    RAM 
+    if (pages == 0) return 0;
+
+    // 1. CRC   
+    for (uint32_t p = 0; p < pages; p++)
+    {
+        uint32_t size = program_size - (p * FLASH_PAGE_SIZE);
+        image_crc[p] = Image_Page_CRC(program_data + (p * FLASH_PAGE_SIZE), (size > FLASH_PAGE_SIZE) ? FLASH_PAGE_SIZE : size);
+    }
+
+    // 2.  ,  CRC   CRC  RAM .    - RAM  
+    //     , Flash     
+    SoftSWD_Status_t status = SoftSWD_set_MEM_AP();
+    if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_CSW, MEM_AP_DEFAULT);
+    if (status == SOFT_SWD_OK) status = Target_Halt();
+    if (status == SOFT_SWD_OK)
+    {
+        status = SoftSWD_WriteMemory_RAM(LOADER_CODE_ADDRESS, (uint8_t*)crc_stub_code, sizeof(crc_stub_code));
+    }
+    if (status == SOFT_SWD_OK)
+    {
+        status = SoftSWD_WriteMemory_RAM(CRC_STUB_TABLE_ADDRESS, (uint8_t*)CRC32_Nibble_Table, sizeof(CRC32_Nibble_Table));
+    }
+    if (status != SOFT_SWD_OK) return FLASH_ERROR_SWD;
+
+    // 3. CRC ,     
+    errors |= Target_Page_CRC(start_address, pages, target_crc, &flash_incremental.stub);
+
+    // 4.    : ,  ,  CRC  
+    uint32_t p = 0;
+    while ((p < pages) && !errors)
+    {
+        if (image_crc[p] == target_crc[p])
+        {
+            p++;
+            continue;
+        }
+
+        uint32_t first = p;
+        while ((p < pages) && (image_crc[p] != target_crc[p])) p++;
+
+        uint32_t offset = first * FLASH_PAGE_SIZE;
+        uint32_t end = p * FLASH_PAGE_SIZE;
+        uint32_t size = ((end < program_size) ? end : program_size) - offset;
+
+        errors |= Erase_Flash_size(start_address + offset, size);
+        if (!errors) errors |= Program_Flash_Block(start_address + offset, program_data + offset, size);
+        flash_incremental.changed += p - first;
+        if (errors) break;
+
+        uint32_t stub;
+        errors |= Target_Page_CRC(start_address + offset, p - first, target_crc + first, &stub);
+        if (errors) break;
+        for (uint32_t i = first; i < p; i++)
+        {
+            if (target_crc[i] != image_crc[i]) errors |= FLASH_ERROR_VERIFY;
+        }
+    }
+
+    return errors;
+}
+
 /**    */
 uint32_t Connect_Target_GetIDCODE()
 {
@@ -183,41 +591,37 @@ uint32_t Connect_Target_GetIDCODE()
     return idcode;
 }
 
-/** Halt   */
-void Target_Halt()
+/**   DHCSR   S_HALT == halted:  SWD   ,     */
+static SoftSWD_Status_t Target_Debug_Command(uint32_t command, uint32_t halted)
 {
-    SoftSWD_WriteRegister(AP, AP_TAR, CoreDebug_BASE); //  DHCSR
-    SoftSWD_WriteRegister(AP, AP_DRW, DHCSR_CMD_HALT); //  + Halt
+    SoftSWD_Status_t status = SoftSWD_Write(AP, AP_TAR, CoreDebug_BASE);  //  DHCSR
+    if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_DRW, command);
 
-    /*     ,      CoreDebug_DHCSR_S_HALT_Msk */
+    /*       ,     CoreDebug_DHCSR_S_HALT_Msk */
+    uint32_t timeout = 5000;
+    uint32_t dhcsr = 0;
+    while (status == SOFT_SWD_OK)
+    {
+        status = SoftSWD_Read(AP, AP_DRW, &dhcsr);                          //  
+        if (status == SOFT_SWD_OK) status = SoftSWD_Read(DP, DP_RDBUFF, &dhcsr);
+        if (status != SOFT_SWD_OK) break;
 
-    SoftSWD_WriteRegister(AP, AP_TAR, CoreDebug_BASE);  //        DHCSR
-    uint32_t timeout = 5000;    //  
-    uint32_t dhcsr;             //     
+        if (((dhcsr & CoreDebug_DHCSR_S_HALT_Msk) != 0) == (halted != 0)) break;
+        if (--timeout == 0) status = SOFT_SWD_ERROR_TIMEOUT;
+    }
+    return status;
+}
 
-    do
-    {
-        timeout--;
-        SoftSWD_ReadRegister(AP, AP_DRW);               //  
-        dhcsr = SoftSWD_ReadRegister(DP, DP_RDBUFF);    //   DHCSR
-    }while ((timeout > 0) && ((dhcsr & CoreDebug_DHCSR_S_HALT_Msk) == 0));
+/** Halt   */
+SoftSWD_Status_t Target_Halt()
+{
+    return Target_Debug_Command(DHCSR_CMD_HALT, 1);
 }
 
 /**     */
-void Target_Run()
+SoftSWD_Status_t Target_Run()
 {
-    SoftSWD_WriteRegister(AP, AP_TAR, CoreDebug_BASE);  //  DHCSR
-    SoftSWD_WriteRegister(AP, AP_DRW, DHCSR_CMD_RUN);   // 
-
-    uint32_t timeout = 5000;    //  
-    uint32_t dhcsr;             //     
-
-    do
-    {
-        timeout--;
-        SoftSWD_ReadRegister(AP, AP_DRW);               //  
-        dhcsr = SoftSWD_ReadRegister(DP, DP_RDBUFF);    //   DHCSR
-    }while ((timeout > 0) && (dhcsr & CoreDebug_DHCSR_S_HALT_Msk));
+    return Target_Debug_Command(DHCSR_CMD_RUN, 0);
 }
 
 
@@ -15,26 +15,94 @@
 #define DHCSR_DBGKEY    (0xA05FUL << 16)  //      ,     Cortex (  M,   A  R)
 #define DHCSR_CMD_HALT  (DHCSR_DBGKEY | CoreDebug_DHCSR_C_DEBUGEN_Msk | CoreDebug_DHCSR_C_HALT_Msk)
 #define DHCSR_CMD_RUN   (DHCSR_DBGKEY | CoreDebug_DHCSR_C_DEBUGEN_Msk)
-
-
-
-/**   Flash */
-void Erase_Flash_All();
-
-/**        */
-void Erase_Flash_size(uint32_t start_address, uint32_t size);
+#define DHCSR_CMD_RUN_MASKINTS  (DHCSR_CMD_RUN | CoreDebug_DHCSR_C_MASKINTS_Msk)   //    ()
+
+#define DCRSR_ADDRESS   (CoreDebug_BASE + 0x04UL)   //     /
+#define DCRDR_ADDRESS   (CoreDebug_BASE + 0x08UL)   //   
+
+/**     DCRSR */
+#define CORE_REG_R0     0
+#define CORE_REG_R1     1
+#define CORE_REG_R2     2
+#define CORE_REG_R3     3
+#define CORE_REG_R7     7
+#define CORE_REG_PC     15
+#define CORE_REG_XPSR   16
+#define XPSR_THUMB      (0x1UL << 24)           //  T  xPSR:       HardFault
+
+
+/**  Flash  RAM  (Program_Flash_Loader)
+*              RAM  Flash    BKPT,  
+*       SWD      .  - - 
+*   ( )    (S_HALT  DHCSR). */
+#define LOADER_CODE_ADDRESS     (SRAM_ADDRESS_START)                            //   ( 1 )
+#define LOADER_MAILBOX_ADDRESS  (SRAM_ADDRESS_START + 0x3FCu)                   //   
+#define LOADER_BUFFER0_ADDRESS  (SRAM_ADDRESS_START + 0x400u)                   //     Flash
+#define LOADER_BUFFER1_ADDRESS  (LOADER_BUFFER0_ADDRESS + FLASH_PAGE_SIZE)
+#define LOADER_MAILBOX_BUSY     (0xFFFFFFFFu)   //   ,    FLASH_STS
+#define LOADER_ERROR_TIMEOUT    (0x1u << 31)    //     LOADER_TIMEOUT  DHCSR
+#define LOADER_TIMEOUT          (100000)
+
+/**  CRC  Flash (Program_Flash_Incremental)
+*           CRC-32 (crc32.h) ,        
+*   .  -    ,  CRC   -   . */
+#define CRC_STUB_TABLE_ADDRESS  (LOADER_BUFFER0_ADDRESS)                        // CRC32_Nibble_Table, 64 
+#define CRC_STUB_RESULT_ADDRESS (LOADER_BUFFER0_ADDRESS + 0x40u)                // CRC ,  FLASH_PAGE_COUNT 
+#define FLASH_ERROR_VERIFY      (0x1u << 30)    // CRC      CRC 
+#define FLASH_ERROR_SWD         (0x1u << 29)    //  SWD   (SoftSWD_Status_t)    
+                                                //  Target_Halt,  
+
+typedef struct
+{
+    uint32_t pages;                 //   
+    uint32_t changed;               //    
+    uint32_t stub;                  // 1 - CRC   , 0 -   
+}
+Flash_Incremental_Stats_t;
+
+extern Flash_Incremental_Stats_t flash_incremental;
+
+
+
+/**   Flash,     .  FLASH_ERROR_SWD,   SWD
+*          , 0 -   */
+uint32_t Erase_Flash_All();
+
+/**       .  FLASH_ERROR_SWD,   SWD
+*     (   ), 0 -   */
+uint32_t Erase_Flash_size(uint32_t start_address, uint32_t size);
 
 /**   flash  */
 void Program_Flash(uint32_t start_address, uint8_t* program_data, uint32_t program_size);
 
+/**   flash  :  TAR   , TAR     1 ,
+*   FLASH_STS     1 ,      (    Program_Flash).
+*      FLASH_STS (PGERR, PVERR, WRPERR)  FLASH_ERROR_SWD (    
+*    ,     WAIT   ), 0 -    */
+uint32_t Program_Flash_Block(uint32_t start_address, uint8_t* program_data, uint32_t program_size);
+
+/**   flash    RAM  (   ,   )
+*      FLASH_STS (PGERR, PVERR, WRPERR), LOADER_ERROR_TIMEOUT  FLASH_ERROR_SWD (
+*         SWD  ), 0 -    */
+uint32_t Program_Flash_Loader(uint32_t start_address, uint8_t* program_data, uint32_t program_size);
+
+/**    flash : CRC-32      CRC  ,
+*         (  -  Program_Flash_Block),    CRC
+*    .        0xFF. start_address -  ,
+*     .    , RAM  Flash    (FLASH_ERROR_SWD).
+*    -  flash_incremental.
+*      FLASH_STS (PGERR, PVERR, WRPERR), FLASH_ERROR_VERIFY  FLASH_ERROR_SWD, 0 -  
+*    */
+uint32_t Program_Flash_Incremental(uint32_t start_address, uint8_t* program_data, uint32_t program_size);
+
 /**      IDCODE*/
 uint32_t Connect_Target_GetIDCODE();
 
-/** Halt   */
-void Target_Halt();
+/** Halt  ,  S_HALT. SOFT_SWD_ERROR_TIMEOUT -    */
+SoftSWD_Status_t Target_Halt();
 
-/**     */
-void Target_Run();
+/**    ,   S_HALT */
+SoftSWD_Status_t Target_Run();
 
 
 
@@ -1,12 +1,27 @@
 #include "soft_SWD.h"
 #include "systick.h"
 
+#if SOFT_SWD_TRANSPORT != SOFT_SWD_TRANSPORT_DELAY
+#include "soft_SWD_phy.h"
+#endif
+#if SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_SPI
+#include "soft_SWD_spi.h"
+#endif
+
 /** В дальнейшем если появятся какие-то настройки, то они должны быть оформлены в структуру */
 // Текущее состояние мастера (настроен на вход или выход)
 // Исходно мастер настроен на выход для отправки запроса к таргету
 static SoftSWD_Direction Master_Direction = Master_Output;
 
+/** Статистика последнего потокового чтения (SoftSWD_ReadMemory_Stream) */
+SoftSWD_Stream_Stats_t soft_swd_stream = {0, 0, 0, 0, 0};
+
+/** Политика повторов и счетчики транзакций */
+SoftSWD_Policy_t soft_swd_policy = SOFT_SWD_POLICY_DEFAULT;
+SoftSWD_Stats_t soft_swd_stats = {0, 0, 0, 0, 0, 0, 0, 0};
+
 /***************************************************************************************** Настройка программного SWD */
+#ifndef SOFT_SWD_HOST_SIM
 
 /** Включение тактирования нужного порта GPIO */
 static void SoftSWD_RCC_Enable()
@@ -57,6 +72,7 @@ static void SoftSWD_Pin_Enable()
 
     SOFT_SWD_TARGET_RESET_PORT->BSRR = 0x1 << SOFT_SWD_TARGET_RESET_PIN;    // Пин RESET находится в высоком состоянии для работы таргета
 }
+#endif
 /**********************************************************************************************************************/
 
 
@@ -65,10 +81,14 @@ static void SoftSWD_Pin_Enable()
 /** Пустой такт */
 static void SoftSWD_Clock_Cycle()
 {
+#if SOFT_SWD_TRANSPORT != SOFT_SWD_TRANSPORT_DELAY
+    SoftSWD_Phy_Clock(1);
+#else
     delay_ticks(SOFT_SWD_TICK_DURATION);
     SOFT_SWD_CLK_HIGH();
     delay_ticks(SOFT_SWD_TICK_DURATION);
     SOFT_SWD_CLK_LOW();
+#endif
 }
 
 /** Переключение направления линии данных */
@@ -105,45 +125,83 @@ static void SoftSWD_Line_Reset(void)
 /** Запись бита данных в SWD */
 static void SoftSWD_WriteBit(uint8_t bit)
 {
+#if SOFT_SWD_TRANSPORT != SOFT_SWD_TRANSPORT_DELAY
+    SoftSWD_Phy_Write(bit, 1);
+#else
     if (bit) SOFT_SWD_DATA_HIGH();
     else SOFT_SWD_DATA_LOW();
     delay_ticks(SOFT_SWD_TICK_DURATION);
     SOFT_SWD_CLK_HIGH();
     delay_ticks(SOFT_SWD_TICK_DURATION);
     SOFT_SWD_CLK_LOW();
+#endif
 }
 
 /** Чтение бита данных */
 static uint8_t SoftSWD_ReadBit()
 {
+#if SOFT_SWD_TRANSPORT != SOFT_SWD_TRANSPORT_DELAY
+    return (uint8_t)SoftSWD_Phy_Read(1);
+#else
     uint8_t bit = 0;
     delay_ticks(SOFT_SWD_TICK_DURATION);
-    bit = (SOFT_SWD_DATA_PORT->IDR & (1U << SOFT_SWD_DATA_PIN)) ? 1 : 0;
+    bit = (uint8_t)SOFT_SWD_DATA_READ();
     SOFT_SWD_CLK_HIGH();
     delay_ticks(SOFT_SWD_TICK_DURATION);
     SOFT_SWD_CLK_LOW();
 
     return bit;
+#endif
 }
 
 /** Запись байта данных */
 static void SoftSWD_WriteByte(uint8_t byte)
 {
+#if SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_SPI
+    SoftSWD_SPI_Write(byte, 1);
+#elif SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_PHY
+    SoftSWD_Phy_Write(byte, 8);
+#else
     for (uint8_t i = 0; i < 8; i++)
     {
         SoftSWD_WriteBit(byte & 0x1);
         byte >>= 0x1;
     }
+#endif
 }
 
 void SoftSWD_Idle_Byte()
 {
+    // После чтения данных или ACK не OK мастер еще на приеме: без turnaround таргет принял бы подтяжку SWDIO за запрос
+    if (Master_Direction != Master_Output) SoftSWD_Trn();
     SoftSWD_WriteByte(0x0);
 }
 
+#if SOFT_SWD_TRANSPORT != SOFT_SWD_TRANSPORT_DELAY
+/** Четность 32 бит (свертка XOR) */
+static uint32_t SoftSWD_Parity(uint32_t data)
+{
+    data ^= data >> 16;
+    data ^= data >> 8;
+    data ^= data >> 4;
+    data ^= data >> 2;
+    data ^= data >> 1;
+    return data & 0x1;
+}
+#endif
+
 /** Запись 32 бит данных + 1 бит четности этих данных + 8 бит нулей для стабильности */
 static void SoftSWD_WriteData(uint32_t data)
 {
+#if SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_SPI
+    // 32 бита данных - 4 байта через SPI, бит четности - через GPIO
+    SoftSWD_SPI_Write(data, 4);
+    SoftSWD_Phy_Write(SoftSWD_Parity(data), 1);
+#elif SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_PHY
+    // 32 бита данных одной развернутой посылкой, затем бит четности
+    SoftSWD_Phy_Write(data, 32);
+    SoftSWD_Phy_Write(SoftSWD_Parity(data), 1);
+#else
     uint8_t parity_bit = 0;
     uint32_t temp_data = data;
 
@@ -157,16 +215,27 @@ static void SoftSWD_WriteData(uint32_t data)
 
     // отправка бита четности
     SoftSWD_WriteBit(parity_bit % 2);
+#endif
 
     // отправка 1 байта нулей
     SoftSWD_Idle_Byte();
 }
 
-/** Чтение 32 бит данных + 1 бита четности */
-static uint32_t SoftSWD_ReadData()
+/** Чтение 32 бит данных + 1 бита четности, возвращает 1 при совпадении четности */
+static uint8_t SoftSWD_ReadData_Parity(uint32_t* value)
 {
     uint32_t data = 0x0;
     uint8_t parity_bit = 0;
+
+#if SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_SPI
+    // Чтение 32 бит данных - 4 байта через SPI (бит четности дальше читается через GPIO)
+    data = SoftSWD_SPI_Read32();
+    parity_bit = SoftSWD_Parity(data);
+#elif SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_PHY
+    // Чтение 32 бит данных одной развернутой посылкой
+    data = SoftSWD_Phy_Read(32);
+    parity_bit = SoftSWD_Parity(data);
+#else
     uint8_t bit = 0;
 
     // Чтение 32 бит данных в переменную data + подсчет четности данных
@@ -180,10 +249,11 @@ static uint32_t SoftSWD_ReadData()
         }
     }
     parity_bit %= 2;
+#endif
 
     // Если четность посчитанная совпала с четностью, полученной от таргета, значит данные получены правильно
-    if (parity_bit == SoftSWD_ReadBit()) return data;
-    else return 0xAAAABBBB;
+    *value = data;
+    return (parity_bit == SoftSWD_ReadBit());
 }
 
 /** Переключение линии в режим SWD */
@@ -250,12 +320,16 @@ static SoftSWD_Request SoftSWD_MakeRequest_WithStruct(uint8_t DP_AP, uint8_t RnW
 /** Прием 3 бит подтверждения ACK */
 static uint8_t SoftSWD_ReadACK()
 {
+#if SOFT_SWD_TRANSPORT != SOFT_SWD_TRANSPORT_DELAY
+    return (uint8_t)SoftSWD_Phy_Read(3);
+#else
     uint8_t ack = 0x0;
     for (uint8_t i = 0; i < 3; i++)
     {
         ack |= SoftSWD_ReadBit() << i;
     }
     return ack;
+#endif
 }
 
 /** Отправка запроса от мастера к таргету */
@@ -264,6 +338,17 @@ static void SoftSWD_Send_Request(SoftSWD_Request req)
     // Направление должно быть OUTPUT
     if (Master_Direction != Master_Output) SoftSWD_Trn();
 
+#if SOFT_SWD_TRANSPORT != SOFT_SWD_TRANSPORT_DELAY
+    // Поля запроса в байт в порядке передачи (start - первым) и одна посылка из 8 бит
+    uint32_t request = (uint32_t)req.start         | ((uint32_t)req.DP_AP << 1) | ((uint32_t)req.RnW << 2) |
+                       ((uint32_t)req.Addr_2 << 3) | ((uint32_t)req.Addr_3 << 4) | ((uint32_t)req.parity << 5) |
+                       ((uint32_t)req.stop << 6)   | ((uint32_t)req.park << 7);
+#if SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_SPI
+    SoftSWD_SPI_Write(request, 1);
+#else
+    SoftSWD_Phy_Write(request, 8);
+#endif
+#else
     SoftSWD_WriteBit(req.start);
     SoftSWD_WriteBit(req.DP_AP);
     SoftSWD_WriteBit(req.RnW);
@@ -272,6 +357,7 @@ static void SoftSWD_Send_Request(SoftSWD_Request req)
     SoftSWD_WriteBit(req.parity);
     SoftSWD_WriteBit(req.stop);
     SoftSWD_WriteBit(req.park);
+#endif
 }
 
 /** Отправка запроса и получение подтверждения от таргета */
@@ -296,16 +382,144 @@ static uint8_t SoftSWD_Send_Request_ACK(SoftSWD_Request req)
 
 /****************************************************************************************** Работа с регистрами DP AP */
 
-/** Сброс ошибок (запись в регистр DP_ABORT) */
-void SoftSWD_ClearErrors(void)
+/** Запись DP_ABORT (принимается таргетом и при занятой шине) */
+static void SoftSWD_Write_Abort(uint32_t flags)
 {
     SoftSWD_Request req = SoftSWD_MakeRequest_WithStruct(DP, WRITE, DP_ABORT);
     SoftSWD_Send_Request_ACK(req);
-    SoftSWD_WriteData(DP_ABORT_ORUNERRCLR |
-                      DP_ABORT_WDERRCLR |
-                      DP_ABORT_STKERRCLR |
-                      DP_ABORT_STKCMPCLR
-                          );
+    SoftSWD_WriteData(flags);
+}
+
+/** Сброс ошибок (запись в регистр DP_ABORT) */
+void SoftSWD_ClearErrors(void)
+{
+    SoftSWD_Write_Abort(DP_ABORT_ORUNERRCLR |
+                        DP_ABORT_WDERRCLR |
+                        DP_ABORT_STKERRCLR |
+                        DP_ABORT_STKCMPCLR
+                            );
+}
+
+/** Такты простоя (SWDIO = 0), пауза перед повтором при WAIT */
+static void SoftSWD_Idle_Cycles(uint32_t cycles)
+{
+    if (Master_Direction != Master_Output) SoftSWD_Trn();
+    while (cycles >= 8)
+    {
+        SoftSWD_WriteByte(0x0);
+        cycles -= 8;
+    }
+    while (cycles--) SoftSWD_WriteBit(0);
+}
+
+/** Одна транзакция SWD без байтов простоя до и после (для потоковых обменов)
+*       Возвращает ACK таргета или SWD_ACK_PARITY при ошибке четности принятых данных */
+static uint8_t SoftSWD_Transfer(uint8_t DP_AP, uint8_t RnW, uint8_t Addr, uint32_t* data)
+{
+    SoftSWD_Request req = SoftSWD_MakeRequest_WithStruct(DP_AP, RnW, Addr);
+    uint8_t ack = SoftSWD_Send_Request_ACK(req);
+
+    switch (ack)
+    {
+        case SWD_ACK_OK:    soft_swd_stats.ack_ok++;        break;
+        case SWD_ACK_WAIT:  soft_swd_stats.ack_wait++;      break;
+        case SWD_ACK_FAIL:  soft_swd_stats.ack_fault++;     break;
+        default:            soft_swd_stats.ack_protocol++;  break;
+    }
+    if (ack != SWD_ACK_OK) return ack;      // направление на выход вернет следующий запрос
+
+    if (RnW == READ)
+    {
+        if (!SoftSWD_ReadData_Parity(data))
+        {
+            soft_swd_stats.parity++;
+            return SWD_ACK_PARITY;
+        }
+    }
+    else
+    {
+        SoftSWD_WriteData(*data);
+    }
+    return SWD_ACK_OK;
+}
+
+/** Транзакция с повтором при WAIT (таргет еще выполняет предыдущее обращение к шине): пауза по soft_swd_policy */
+static uint8_t SoftSWD_Transfer_Retry(uint8_t DP_AP, uint8_t RnW, uint8_t Addr, uint32_t* data)
+{
+    uint32_t backoff = soft_swd_policy.backoff_start;
+    uint8_t ack = SoftSWD_Transfer(DP_AP, RnW, Addr, data);
+
+    for (uint32_t attempt = 0; (ack == SWD_ACK_WAIT) && (attempt < soft_swd_policy.wait_retries); attempt++)
+    {
+        soft_swd_stats.retries++;
+        if (backoff)
+        {
+            SoftSWD_Idle_Cycles(backoff);
+            backoff = (backoff * 2 < soft_swd_policy.backoff_max) ? backoff * 2 : soft_swd_policy.backoff_max;
+        }
+        ack = SoftSWD_Transfer(DP_AP, RnW, Addr, data);
+    }
+    return ack;
+}
+
+/** Восстановление по ACK неудачной транзакции:
+*       WAIT после всех повторов - DAPABORT снимает незавершенное обращение AP (иначе таргет так и отвечает WAIT);
+*       неверный ACK - сброс линии и чтение IDCODE (без него DP после сброса линии не принимает другие запросы);
+*       FAULT, ошибка четности и неверный ACK - сброс флагов ошибок */
+static void SoftSWD_Recover(uint8_t ack)
+{
+    soft_swd_stats.recoveries++;
+    SoftSWD_Idle_Byte();
+
+    if (ack == SWD_ACK_WAIT)
+    {
+        SoftSWD_Write_Abort(DP_ABORT_DAPABORT);
+        return;
+    }
+    if ((ack != SWD_ACK_FAIL) && (ack != SWD_ACK_PARITY))
+    {
+        uint32_t idcode;
+        SoftSWD_Line_Reset();
+        SoftSWD_Idle_Byte();
+        SoftSWD_Transfer(DP, READ, DP_IDCODE, &idcode);
+        SoftSWD_Idle_Byte();
+    }
+    SoftSWD_ClearErrors();
+}
+
+/** Результат по ACK последней попытки */
+static SoftSWD_Status_t SoftSWD_Status(uint8_t ack)
+{
+    switch (ack)
+    {
+        case SWD_ACK_OK:        return SOFT_SWD_OK;
+        case SWD_ACK_WAIT:      return SOFT_SWD_ERROR_WAIT;
+        case SWD_ACK_FAIL:      return SOFT_SWD_ERROR_FAULT;
+        case SWD_ACK_PARITY:    return SOFT_SWD_ERROR_PARITY;
+        default:                return SOFT_SWD_ERROR_PROTOCOL;
+    }
+}
+
+/** Транзакция с байтами простоя и повторами по soft_swd_policy */
+static SoftSWD_Status_t SoftSWD_Transaction(uint8_t DP_AP, uint8_t RnW, uint8_t Addr, uint32_t* data)
+{
+    uint8_t ack;
+
+    SoftSWD_Idle_Byte();                                    // Отправка 8 бит нулей перед отправкой запроса
+    for (uint32_t recover = 0; ; recover++)
+    {
+        ack = SoftSWD_Transfer_Retry(DP_AP, RnW, Addr, data);
+        if ((ack == SWD_ACK_OK) || (ack == SWD_ACK_WAIT) || (recover >= soft_swd_policy.recover_retries)) break;
+
+        SoftSWD_Recover(ack);
+        soft_swd_stats.retries++;
+    }
+
+    if (ack == SWD_ACK_WAIT) SoftSWD_Recover(ack);
+
+    if (RnW == READ) SoftSWD_Idle_Byte();                   // После записи байт простоя уже отправил SoftSWD_WriteData
+    if (ack != SWD_ACK_OK) soft_swd_stats.failures++;
+    return SoftSWD_Status(ack);
 }
 
 ///** Запись значения в регистр AP или DP */
@@ -329,68 +543,32 @@ void SoftSWD_ClearErrors(void)
 //}
 
 
-/** Запись значения в регистр AP или DP */
-void SoftSWD_WriteRegister(uint8_t DP_AP, uint8_t Addr, uint32_t register_value)
+/** Чтение регистра AP или DP с результатом */
+SoftSWD_Status_t SoftSWD_Read(uint8_t DP_AP, uint8_t Addr, uint32_t* value)
 {
-    SoftSWD_Request req = SoftSWD_MakeRequest_WithStruct(DP_AP, WRITE, Addr);       // Запрос сформирован
-    SoftSWD_Idle_Byte();                                                            // Отправка 8 бит нулей перед отправкой запроса
+    uint32_t data = 0x0;
+    SoftSWD_Status_t status = SoftSWD_Transaction(DP_AP, READ, Addr, &data);
+    *value = (status == SOFT_SWD_OK) ? data : 0x0;
+    return status;
+}
 
-    switch (SoftSWD_Send_Request_ACK(req))
-    {
-        // В случае получения ACK_OK происходит запись в регистр как и планировалось
-        case SWD_ACK_OK:
-        {
-            SoftSWD_WriteData(register_value);
-            break;
-        }
+/** Запись регистра AP или DP с результатом */
+SoftSWD_Status_t SoftSWD_Write(uint8_t DP_AP, uint8_t Addr, uint32_t value)
+{
+    return SoftSWD_Transaction(DP_AP, WRITE, Addr, &value);
+}
 
-        // В случае получения ACK_WAIT необходимо повторить попытку записи в регистр, т.к. прямо сейчас таргет занят
-        case SWD_ACK_WAIT:
-        {
-            uint32_t attempts = 1000;
-            while (attempts)
-            {
-                attempts--;
-                if (SoftSWD_Send_Request_ACK(req) == SWD_ACK_OK)
-                {
-                    SoftSWD_WriteData(register_value);
-                    break;
-                }
-            }   // end while
-
-            // Если после нескольких попыток запись получилась, нужно выйти из switch, иначе произойдет переход в case SWD_ACK_FAIL
-            if (SoftSWD_Send_Request_ACK(req) == SWD_ACK_OK) SoftSWD_WriteData(register_value); break;
-        }   // end case SWD_ACK_WAIT
-
-        case SWD_ACK_FAIL:
-        {
-            // Сбросить ошибки и попробовать еще 1 раз
-            SoftSWD_ClearErrors();
-            if (SoftSWD_Send_Request_ACK(req) == SWD_ACK_OK)
-            {
-                SoftSWD_WriteData(register_value);
-            }
-            break;
-        }
-    }
+/** Запись значения в регистр AP или DP */
+void SoftSWD_WriteRegister(uint8_t DP_AP, uint8_t Addr, uint32_t register_value)
+{
+    SoftSWD_Write(DP_AP, Addr, register_value);
 }
 
 /** Чтение значения регистра AP или DP */
 uint32_t SoftSWD_ReadRegister(uint8_t DP_AP, uint8_t Addr)
 {
-    uint32_t register_value = 0x0;
-    SoftSWD_Request req = SoftSWD_MakeRequest_WithStruct(DP_AP, READ, Addr);    // запрос создан
-    SoftSWD_Idle_Byte();
-    if (SoftSWD_Send_Request_ACK(req) == 0x1)                       // запрос отправлен, ACK получен
-        register_value = SoftSWD_ReadData();                        // если ACK OK, происходит чтение регистра
-    else
-    {
-        // Сбросить ошибки и попробовать еще 1 раз
-        SoftSWD_ClearErrors();
-        if (SoftSWD_Send_Request_ACK(req) == 0x1)  register_value = SoftSWD_ReadData();
-    }
-    SoftSWD_Trn();
-    SoftSWD_Idle_Byte();
+    uint32_t register_value;
+    SoftSWD_Read(DP_AP, Addr, &register_value);
     return register_value;
 }
 /**********************************************************************************************************************/
@@ -407,16 +585,14 @@ static void parse_words(uint32_t data_word, uint8_t* buffer)
     buffer[3] = data_word >> 24 & 0xFF;
 }
 
-/** Упаковка 4 байт в одно 32-битное слово */
-//static uint32_t pack_words(uint8_t* buffer)
-//{
-//    uint32_t data = 0;
-//    data |= (uint32_t)buffer[0];
-//    data |= (uint32_t)buffer[1] << 8;
-//    data |= (uint32_t)buffer[2] << 16;
-//    data |= (uint32_t)buffer[3] << 24;
-//    return data;
-//}
+/** Упаковка до 4 байт в одно 32-битное слово (недостающие байты хвоста - нули) */
+static uint32_t pack_words(uint8_t* buffer, uint32_t bytes)
+{
+    uint32_t data = 0;
+    if (bytes > 4) bytes = 4;
+    for (uint32_t i = 0; i < bytes; i++) data |= (uint32_t)buffer[i] << (i * 8);
+    return data;
+}
 /**********************************************************************************************************************/
 
 
@@ -426,8 +602,21 @@ static void parse_words(uint32_t data_word, uint8_t* buffer)
 /** Инициализация программного SWD */
 void SoftSWD_Init()
 {
+#ifndef SOFT_SWD_HOST_SIM
     SoftSWD_RCC_Enable();   // Включение тактирования нужного порта GPIO
     SoftSWD_Pin_Enable();   // Настройка пинов программного SWD
+#endif
+
+    soft_swd_stats = (SoftSWD_Stats_t){0, 0, 0, 0, 0, 0, 0, 0};
+
+#if SOFT_SWD_TRANSPORT != SOFT_SWD_TRANSPORT_DELAY
+    SoftSWD_Phy_Init(SOFT_SWD_PHY_CLOCK);   // Подбор полупериода SWCLK по DWT
+#else
+    DWT_Init();                             // Счетчик тактов для замера скорости чтения
+#endif
+#if SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_SPI
+    SoftSWD_SPI_Init();                     // SPI1 в двунаправленном режиме для запроса и данных
+#endif
 }
 
 /** Синхронизация мастера и таргета */
@@ -455,26 +644,26 @@ uint32_t SoftSWD_Get_IDCODE()
 }
 
 /** Настройка DP регистров для работы программного SWD */
-static void SoftSWD_set_DP_registers(uint32_t APsel, uint8_t APbanksel)
+static SoftSWD_Status_t SoftSWD_set_DP_registers(uint32_t APsel, uint8_t APbanksel)
 {
     // Включение питания системы и модуля отладки
-    SoftSWD_WriteRegister(DP, DP_CTRL_STAT, DP_CTRL_STAT_CSYSPWRUPREQ |
-                                            DP_CTRL_STAT_CDBGPWRUPREQ);
+    SoftSWD_Status_t status = SoftSWD_Write(DP, DP_CTRL_STAT, DP_CTRL_STAT_CSYSPWRUPREQ |
+                                                              DP_CTRL_STAT_CDBGPWRUPREQ);
 
     // Выбор текущего AP и активного регистрового блока выбранного AP
-    SoftSWD_WriteRegister(DP, DP_SELECT, DP_SELECT_APSEL(APsel) |
-                                         DP_SELECT_APBANKSEL(APbanksel));
+    if (status == SOFT_SWD_OK) status = SoftSWD_Write(DP, DP_SELECT, DP_SELECT_APSEL(APsel) |
+                                                                     DP_SELECT_APBANKSEL(APbanksel));
+    return status;
 }
 
 /** Функция-обертка статической функции настройки DP регистров для работы с MEM-AP */
-void SoftSWD_set_MEM_AP()
+SoftSWD_Status_t SoftSWD_set_MEM_AP()
 {
-    SoftSWD_set_DP_registers(MEM_AP_APSEL, MEM_AP_APBANKSEL);
+    return SoftSWD_set_DP_registers(MEM_AP_APSEL, MEM_AP_APBANKSEL);
 }
 
 
 
-
 /** Чтение из памяти таргета (по указанному адресу памяти, заданное количество байт) */
 void SoftSWD_ReadMemory(uint32_t address, uint8_t* buffer, uint32_t size)
 {
@@ -512,46 +701,113 @@ void SoftSWD_ReadMemory(uint32_t address, uint8_t* buffer, uint32_t size)
     }
 }
 
-///** Запись в память (RAM) таргета */
-//void SoftSWD_WriteMemory_RAM(uint32_t address, void* buffer, uint32_t size)
-//{
-//    if(size % 4) return 1;
-//
-//    uin8_t res = 0;
-//
-//
-//    // 1. Включение питания и выбор порта MEM-AP (запись в CTRL/STAT и выбор AP 0, Bank 0)
-//    res |= SoftSWD_set_MEM_AP();
-//
-//    // 2. Настройка CSW: 32-bit + Auto-increment (0x23000012)
-//    SoftSWD_WriteRegister(AP, AP_CSW, MEM_AP_DEFAULT | AP_CSW_ADDRINC);
-//
-//    // 3. Установка начального адреса в TAR (AP 0x04)
-//    SoftSWD_WriteRegister(AP, AP_TAR, address);
-//
-////    // 4. Определение количества 32-битных слов
-////    uint32_t operations = size / 4;
-////    if (size % 4) operations++; // Округляем вверх, если байты не кратны 4
-//
-//    // 5. Цикл записи
-//    //for (uint32_t i = 0; i < operations; i++)
-//    uint32_t * ptr = (uin32_t*)buffer;
-//    for (uint32_t i = 0; i < size / 4; i+=4)
-//    {
-//        // Упаковка байт из буфера в 32-битное слово
-//        //uint32_t data_to_write = pack_words(buffer + (i * 4));
-//
-//        // Запись в DRW (AP 0x0C). Автоинкремент TAR происходит сразу после каждой успешной транзакции данных.
-//        //SoftSWD_WriteRegister(AP, AP_DRW, data_to_write);
-//        SoftSWD_WriteRegister(AP, AP_DRW, *ptr++);
-//    }
-//
-//    // прочитать регистр DP_CTRL_STAT
-//    uint32_t ctrl_stat = SoftSWD_ReadRegister(DP, DP_CTRL_STAT);
-//    if ((ctrl_stat >> 5) & 0x1) GPIO_set_HIGH(GPIOD, 14);
-//
-//    return res;
-//}
+/** Потоковое чтение из памяти таргета */
+SoftSWD_Status_t SoftSWD_ReadMemory_Stream(uint32_t address, uint8_t* buffer, uint32_t size)
+{
+    uint32_t start = DWT_Get_Cycles();
+    uint32_t waits = soft_swd_stats.ack_wait;
+    uint32_t words = (size + 3) / 4;
+    uint32_t done = 0;              // слов уже записано в buffer
+    uint32_t restarts = 0;
+    uint8_t ack = SWD_ACK_OK;
+
+    // 1. Включение питания и выбор порта MEM-AP, CSW с автоинкрементом - один раз на весь поток
+    SoftSWD_set_MEM_AP();
+    SoftSWD_WriteRegister(AP, AP_CSW, MEM_AP_DEFAULT | AP_CSW_ADDRINC);
+
+    while (done < words)
+    {
+        // 2. Блок до ближайшей границы 1 КБ: дальше автоинкремент TAR не гарантирован
+        uint32_t block_address = address + (done * 4);
+        uint32_t block = (SOFT_SWD_TAR_WRAP - (block_address & (SOFT_SWD_TAR_WRAP - 1))) / 4;
+        if (block > words - done) block = words - done;
+
+        SoftSWD_WriteRegister(AP, AP_TAR, block_address);
+
+        // 3. Первое чтение DRW только запускает обращение к шине, каждое следующее возвращает предыдущее слово,
+        //    последнее слово блока забирается из RDBUFF (без лишнего обращения по адресу за концом блока)
+        uint32_t value;
+        uint32_t received = 0;
+        ack = SoftSWD_Transfer_Retry(AP, READ, AP_DRW, &value);
+
+        while ((ack == SWD_ACK_OK) && (received < block))
+        {
+            if (received + 1 < block) ack = SoftSWD_Transfer_Retry(AP, READ, AP_DRW, &value);
+            else ack = SoftSWD_Transfer_Retry(DP, READ, DP_RDBUFF, &value);
+            if (ack != SWD_ACK_OK) break;
+
+            // Хвост, не кратный 4 байтам, не выходит за размер буфера
+            uint32_t offset = (done + received) * 4;
+            uint32_t bytes = (size - offset < 4) ? (size - offset) : 4;
+            for (uint32_t b = 0; b < bytes; b++) buffer[offset + b] = (uint8_t)(value >> (b * 8));
+            received++;
+        }
+        done += received;
+
+        // 4. FAULT, ошибка четности или исчерпанный WAIT: восстановление и повтор блока с первого непринятого слова
+        if (ack != SWD_ACK_OK)
+        {
+            soft_swd_stream.faults++;
+            if (received) restarts = 0;     // лимит - на повторы подряд без принятых слов
+            if (++restarts > SOFT_SWD_STREAM_RESTARTS) break;
+            SoftSWD_Recover(ack);
+            ack = SWD_ACK_OK;
+        }
+    }
+
+    // 5. Байт простоя после последней транзакции, CSW без автоинкремента (на него рассчитаны остальные функции)
+    SoftSWD_Idle_Byte();
+    SoftSWD_WriteRegister(AP, AP_CSW, MEM_AP_DEFAULT);
+
+    // 6. Скорость
+    uint32_t cycles = DWT_Get_Cycles() - start;
+    soft_swd_stream.bytes = done * 4;
+    soft_swd_stream.cycles = cycles;
+    soft_swd_stream.kbps = cycles ? (uint32_t)(((uint64_t)soft_swd_stream.bytes * SystemCoreClock) / ((uint64_t)cycles * 1024)) : 0;
+    soft_swd_stream.waits += soft_swd_stats.ack_wait - waits;
+
+    if (ack != SWD_ACK_OK) soft_swd_stats.failures++;
+    return SoftSWD_Status(ack);
+}
+
+/** Сравнение скорости чтения SoftSWD_ReadMemory и SoftSWD_ReadMemory_Stream */
+void SoftSWD_Benchmark_Read(uint32_t address, uint8_t* buffer, uint32_t size, SoftSWD_Read_Benchmark_t* result)
+{
+    uint32_t start = DWT_Get_Cycles();
+    SoftSWD_ReadMemory(address, buffer, size & ~0x3u);
+    uint32_t legacy_cycles = DWT_Get_Cycles() - start;
+
+    SoftSWD_ReadMemory_Stream(address, buffer, size & ~0x3u);
+
+    result->size = size & ~0x3u;
+    result->legacy_kbps = legacy_cycles ? (uint32_t)(((uint64_t)result->size * SystemCoreClock) / ((uint64_t)legacy_cycles * 1024)) : 0;
+    result->stream_kbps = soft_swd_stream.kbps;
+}
+
+/** Запись в память (RAM) таргета блоком */
+SoftSWD_Status_t SoftSWD_WriteMemory_RAM(uint32_t address, uint8_t* buffer, uint32_t size)
+{
+    // 1. Включение питания и выбор порта MEM-AP (запись в CTRL/STAT и выбор AP 0, Bank 0)
+    SoftSWD_Status_t status = SoftSWD_set_MEM_AP();
+
+    // 2. Настройка CSW: 32-bit + автоинкремент (0x23000012) - один раз на весь блок
+    if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_CSW, MEM_AP_DEFAULT | AP_CSW_ADDRINC);
+
+    // 3. Слова DRW подряд, TAR - только в начале и на границах 1 КБ (дальше автоинкремент не гарантирован).
+    //    Первая же ошибка останавливает запись: следующие слова легли бы не по своим адресам
+    uint32_t operations = (size + 3) / 4;
+    for (uint32_t i = 0; (i < operations) && (status == SOFT_SWD_OK); i++)
+    {
+        uint32_t current_addr = address + (i * 4);
+        if (i == 0 || (current_addr & (SOFT_SWD_TAR_WRAP - 1)) == 0) status = SoftSWD_Write(AP, AP_TAR, current_addr);
+
+        if (status == SOFT_SWD_OK) status = SoftSWD_Write(AP, AP_DRW, pack_words(buffer + (i * 4), size - (i * 4)));
+    }
+
+    // 4. Вернуть CSW без автоинкремента (на него рассчитаны остальные функции), в том числе после ошибки
+    SoftSWD_Status_t restore = SoftSWD_Write(AP, AP_CSW, MEM_AP_DEFAULT);
+    return (status == SOFT_SWD_OK) ? restore : status;
+}
 
 
 
@@ -7,13 +7,42 @@
 #ifndef __SOFT_SWD_H__
 #define __SOFT_SWD_H__
 
+#ifdef SOFT_SWD_HOST_SIM
+#include "soft_SWD_sim.h"       // Сборка на ПК: вместо GPIO - модель таргета (см. soft_SWD_sim.h)
+#else
 #include "gpio.h"
+#endif
+
+/********************************************************************************************* Физический уровень SWD */
+
+#define SOFT_SWD_TRANSPORT_DELAY    0       // Биты через delay_ticks (SysTick)
+#define SOFT_SWD_TRANSPORT_PHY      1       // soft_SWD_phy: развернутые записи BSRR, полупериод по DWT
+#define SOFT_SWD_TRANSPORT_SPI      2       // soft_SWD_spi: запрос и данные через SPI1, ACK/четность/turnaround - soft_SWD_phy
+
+#ifndef SOFT_SWD_TRANSPORT
+#define SOFT_SWD_TRANSPORT          SOFT_SWD_TRANSPORT_PHY
+#endif
+
+#if defined(SOFT_SWD_HOST_SIM) && (SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_SPI)
+#error "SOFT_SWD_HOST_SIM: модель таргета подключается только к транспортам DELAY и PHY"
+#endif
+/**********************************************************************************************************************/
+
 
 /********************************************************** Определение пинов GPIO в качестве пинов программного SWD  */
 // PC3 => Target RESET
 #define SOFT_SWD_TARGET_RESET_PORT  GPIOC
 #define SOFT_SWD_TARGET_RESET_PIN   3
 
+#if SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_SPI
+// PA7 => SWDIO (SPI1 MOSI в двунаправленном режиме), оба пина SWD должны быть на одном порту
+#define SOFT_SWD_DATA_PORT          GPIOA
+#define SOFT_SWD_DATA_PIN           7
+
+// PA5 => SWCLK (SPI1 SCK)
+#define SOFT_SWD_CLK_PORT           GPIOA
+#define SOFT_SWD_CLK_PIN            5
+#else
 // PA1 => SWDIO
 #define SOFT_SWD_DATA_PORT          GPIOA
 #define SOFT_SWD_DATA_PIN           1
@@ -21,18 +50,37 @@
 // PA3 => SWCLK
 #define SOFT_SWD_CLK_PORT           GPIOA
 #define SOFT_SWD_CLK_PIN            3
+#endif
 /**********************************************************************************************************************/
 
 
 /********************************************************************** Управление состоянием пинов программного SWD  */
+// Все обращения soft_SWD.c и soft_SWD_phy.c к пинам SWD идут только через эти макросы
+#ifdef SOFT_SWD_HOST_SIM
+#define SOFT_SWD_DATA_HIGH()            SoftSWD_Sim_Data(1)
+#define SOFT_SWD_DATA_LOW()             SoftSWD_Sim_Data(0)
+#define SOFT_SWD_DATA_WRITE(bit)        SoftSWD_Sim_Data((bit) & 0x1U)
+#define SOFT_SWD_DATA_READ()            SoftSWD_Sim_Read()
+
+#define SOFT_SWD_CLK_HIGH()             SoftSWD_Sim_Clock(1)
+#define SOFT_SWD_CLK_LOW()              SoftSWD_Sim_Clock(0)
+
+#define SOFT_SWD_RESET_TARGET_HIGH()    SoftSWD_Sim_Reset(1)
+#define SOFT_SWD_RESET_TARGET_LOW()     SoftSWD_Sim_Reset(0)
+#else
 #define SOFT_SWD_DATA_HIGH()    (SOFT_SWD_DATA_PORT->BSRR = (0x1U << SOFT_SWD_DATA_PIN))
 #define SOFT_SWD_DATA_LOW()     (SOFT_SWD_DATA_PORT->BSRR = (0x1U << (SOFT_SWD_DATA_PIN + 16)))
 
+// Уровень bit & 1 одной записью без ветвлений: маска сброса, сдвинутая на 16 бит вправо, становится установкой
+#define SOFT_SWD_DATA_WRITE(bit)    (SOFT_SWD_DATA_PORT->BSRR = (0x1U << (SOFT_SWD_DATA_PIN + 16)) >> (((bit) & 0x1U) << 4))
+#define SOFT_SWD_DATA_READ()        ((SOFT_SWD_DATA_PORT->IDR >> SOFT_SWD_DATA_PIN) & 0x1U)
+
 #define SOFT_SWD_CLK_HIGH()     (SOFT_SWD_CLK_PORT->BSRR = (0x1U << SOFT_SWD_CLK_PIN))
 #define SOFT_SWD_CLK_LOW()      (SOFT_SWD_CLK_PORT->BSRR = (0x1U << (SOFT_SWD_CLK_PIN + 16)))
 
 #define SOFT_SWD_RESET_TARGET_HIGH()    (SOFT_SWD_TARGET_RESET_PORT->BSRR = (0x1U << SOFT_SWD_TARGET_RESET_PIN))
 #define SOFT_SWD_RESET_TARGET_LOW()     (SOFT_SWD_TARGET_RESET_PORT->BSRR = (0x1U << (SOFT_SWD_TARGET_RESET_PIN + 16)))
+#endif
 /**********************************************************************************************************************/
 
 
@@ -44,6 +92,10 @@ typedef enum
 }
 SoftSWD_Direction;
 
+#ifdef SOFT_SWD_HOST_SIM
+#define SOFT_SWD_DATA_SET_INPUT()       SoftSWD_Sim_Direction(Master_Input)
+#define SOFT_SWD_DATA_SET_OUTPUT()      SoftSWD_Sim_Direction(Master_Output)
+#else
 #define SOFT_SWD_DATA_SET_INPUT()                                               \
 {                                                                               \
     SOFT_SWD_DATA_PORT->MODER &= ~(MODER_ANALOG << (SOFT_SWD_DATA_PIN * 2));    \
@@ -54,6 +106,7 @@ SoftSWD_Direction;
     SOFT_SWD_DATA_PORT->MODER &= ~(MODER_ANALOG << (SOFT_SWD_DATA_PIN * 2));    \
     SOFT_SWD_DATA_PORT->MODER |=  (MODER_OUTPUT << (SOFT_SWD_DATA_PIN * 2));    \
 }
+#endif
 /**********************************************************************************************************************/
 
 
@@ -188,14 +241,89 @@ SoftSWD_Request;
 #define SWD_ACK_OK      (0x1U)
 #define SWD_ACK_WAIT    (0x2U)
 #define SWD_ACK_FAIL    (0x4U)
+#define SWD_ACK_PARITY  (0x8U)      // Не ответ таргета: ошибка четности принятых данных (потоковое чтение)
 
 // Стандартное значение регистра CSW, выбран MEM-AP, настроен доступ к отладке и памяти таргета
 #define MEM_AP_DEFAULT  (0x23000002)
 
-#define SOFT_SWD_TICK_DURATION  (4)         // Продолжительность 1 такта SWD в тактах процессора
+// Автоинкремент AP_TAR гарантирован только внутри блока 1 КБ (ADIv5), на границе блока TAR нужно записать заново
+#define SOFT_SWD_TAR_WRAP       (0x400U)
+
+#define SOFT_SWD_TICK_DURATION  (4)         // Продолжительность 1 такта SWD в тактах процессора (SOFT_SWD_TRANSPORT_DELAY)
 #define SOFT_SWD_JTAG_TO_SWD    (0xE79E)    // Запрос на переключение порта отладки таргета с JTAG на SWD
 
 
+/*************************************************************************************************** Транзакции */
+
+/** Результат транзакции (SoftSWD_Read, SoftSWD_Write и функции поверх них) */
+typedef enum
+{
+    SOFT_SWD_OK = 0,
+    SOFT_SWD_ERROR_WAIT,            // WAIT после всех повторов политики
+    SOFT_SWD_ERROR_FAULT,           // FAULT и после сброса ошибок через DP_ABORT
+    SOFT_SWD_ERROR_PARITY,          // ошибка четности принятых данных и после повторов
+    SOFT_SWD_ERROR_PROTOCOL,        // ACK не OK/WAIT/FAULT: таргета нет на линии или потеря синхронизации
+    SOFT_SWD_ERROR_TIMEOUT          // таргет не пришел в ожидаемое состояние (например, S_HALT в DHCSR)
+}
+SoftSWD_Status_t;
+
+/** Политика повторов: WAIT - повтор той же транзакции с паузой из тактов простоя, пауза удваивается от backoff_start
+*   до backoff_max; FAULT, ошибка четности и неверный ACK - восстановление (сброс линии для неверного ACK,
+*   DP_ABORT со сбросом флагов ошибок) и повтор, не больше recover_retries раз */
+typedef struct
+{
+    uint32_t wait_retries;          // повторов при WAIT
+    uint32_t backoff_start;         // пауза перед первым повтором, тактов SWCLK (0 - повтор сразу)
+    uint32_t backoff_max;           // предел паузы, тактов SWCLK
+    uint32_t recover_retries;       // повторов после восстановления
+}
+SoftSWD_Policy_t;
+
+#define SOFT_SWD_POLICY_DEFAULT     {1000, 0, 64, 1}
+
+/** Счетчики транзакций (накопительно с SoftSWD_Init) */
+typedef struct
+{
+    uint32_t ack_ok;
+    uint32_t ack_wait;
+    uint32_t ack_fault;
+    uint32_t ack_protocol;          // ACK не из допустимых
+    uint32_t parity;                // ошибок четности принятых данных
+    uint32_t retries;               // повторов транзакций (WAIT и после восстановления)
+    uint32_t recoveries;            // сбросов ошибок через DP_ABORT
+    uint32_t failures;              // транзакций, завершившихся ошибкой
+}
+SoftSWD_Stats_t;
+
+extern SoftSWD_Policy_t soft_swd_policy;
+extern SoftSWD_Stats_t soft_swd_stats;
+
+
+/********************************************************************************************** Потоковое чтение */
+
+#define SOFT_SWD_STREAM_RESTARTS    (4)     // Повторов блока подряд без принятых слов после FAULT или ошибки четности
+
+typedef struct
+{
+    uint32_t bytes;                 // прочитано байт (целыми словами)
+    uint32_t cycles;                // время чтения, такты DWT
+    uint32_t kbps;                  // скорость, КБ/с
+    uint32_t waits;                 // ответов WAIT (накопительно)
+    uint32_t faults;                // повторов блока после FAULT/четности (накопительно)
+}
+SoftSWD_Stream_Stats_t;
+
+typedef struct
+{
+    uint32_t size;                  // объем замера, байт
+    uint32_t legacy_kbps;           // SoftSWD_ReadMemory, КБ/с
+    uint32_t stream_kbps;           // SoftSWD_ReadMemory_Stream, КБ/с
+}
+SoftSWD_Read_Benchmark_t;
+
+extern SoftSWD_Stream_Stats_t soft_swd_stream;
+
+
 /************************************************************************************************** Прототипы функций */
 
 /** Инициализация программного SWD, включение тактирования портов GPIO, на которых реализованы SWDIO, SWCLK, SWRST;
@@ -212,23 +340,42 @@ void SoftSWD_Reset_Target();
 uint32_t SoftSWD_Get_IDCODE();
 
 
-/** Чтение значения регистра AP или DP */
+/** Чтение регистра AP или DP с повторами по soft_swd_policy (байты простоя до и после) */
+SoftSWD_Status_t SoftSWD_Read(uint8_t DP_AP, uint8_t Addr, uint32_t* value);
+
+/** Запись регистра AP или DP с повторами по soft_swd_policy: данные уходят только после ACK OK, поэтому при повторах
+*   запись DRW с автоинкрементом TAR не выполняется дважды */
+SoftSWD_Status_t SoftSWD_Write(uint8_t DP_AP, uint8_t Addr, uint32_t value);
+
+/** Чтение значения регистра AP или DP (SoftSWD_Read без результата, при ошибке - 0) */
 uint32_t SoftSWD_ReadRegister(uint8_t DP_AP, uint8_t Addr);
 
-/** Запись значения в регистр AP или DP */
+/** Запись значения в регистр AP или DP (SoftSWD_Write без результата) */
 void SoftSWD_WriteRegister(uint8_t DP_AP, uint8_t Addr, uint32_t register_value);
 
-/** Функция-обертка статической функции настройки DP регистров для работы с MEM-AP */
-void SoftSWD_set_MEM_AP();
+/** Функция-обертка статической функции настройки DP регистров для работы с MEM-AP (SOFT_SWD_OK - обе записи DP
+*   прошли) */
+SoftSWD_Status_t SoftSWD_set_MEM_AP();
 
 
 /** Чтение из памяти таргета */
 void SoftSWD_ReadMemory(uint32_t address, uint8_t* buffer, uint32_t size);
 
-/** Запись в RAM память таргета */
-void SoftSWD_WriteMemory_RAM(uint32_t address, uint8_t* buffer, uint32_t size);
+/** Потоковое чтение из памяти таргета: чтения AP_DRW подряд без байтов простоя, WAIT - повтор транзакции,
+*   FAULT - сброс ошибок и повтор блока, TAR переписывается на границах 1 КБ. Размер может быть не кратен 4.
+*   Возвращает SOFT_SWD_OK или результат последней неудачной транзакции; скорость - в soft_swd_stream */
+SoftSWD_Status_t SoftSWD_ReadMemory_Stream(uint32_t address, uint8_t* buffer, uint32_t size);
+
+/** Замер скорости SoftSWD_ReadMemory и SoftSWD_ReadMemory_Stream на одном участке памяти (size округляется до слов) */
+void SoftSWD_Benchmark_Read(uint32_t address, uint8_t* buffer, uint32_t size, SoftSWD_Read_Benchmark_t* result);
+
+/** Запись в RAM память таргета блоком: автоинкремент TAR, TAR переписывается только на границах 1 КБ,
+*       слова DRW идут подряд без повторной установки адреса (size округляется вверх до целых слов).
+*       Первая ошибочная транзакция прерывает запись, ее результат и возвращается */
+SoftSWD_Status_t SoftSWD_WriteMemory_RAM(uint32_t address, uint8_t* buffer, uint32_t size);
 
 
+/** Сброс флагов ошибок DP (запись DP_ABORT) */
 void SoftSWD_ClearErrors(void);
 void SoftSWD_Idle_Byte();
 
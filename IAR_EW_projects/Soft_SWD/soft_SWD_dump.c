@@ -0,0 +1,103 @@
+/***********************************************************************************************************************
+*   Выгрузка памяти таргета на ПК через USART (см. soft_SWD_dump.h)
+***********************************************************************************************************************/
+
+#include <stddef.h>
+#include "soft_SWD_dump.h"
+#include "systick.h"
+#include "crc32.h"
+
+SoftSWD_Dump_Stats_t soft_swd_dump;
+
+/** Два буфера кадра: один передает DMA, во второй читает SWD (глобальные - в SRAM, DMA не видит CCM RAM) */
+static SoftSWD_Dump_Frame_t dump_frames[2];
+
+/************************************************************************************************ СТАТИЧЕСКИЕ ФУНКЦИИ */
+
+/** Заголовок кадра и CRC заголовка с данными */
+static void Dump_Seal_Frame(SoftSWD_Dump_Frame_t* frame, uint16_t seq, uint16_t flags, uint32_t address, uint32_t length)
+{
+    frame->header.magic = SOFT_SWD_DUMP_MAGIC;
+    frame->header.seq = seq;
+    frame->header.flags = flags;
+    frame->header.address = address;
+    frame->header.length = length;
+
+    uint32_t crc = CRC32_Update(CRC32_INIT, (const uint8_t*)&frame->header, sizeof(SoftSWD_Dump_Header_t) - 4);
+    frame->header.crc = CRC32_Update(crc, frame->data, length) ^ CRC32_INIT;
+}
+/**********************************************************************************************************************/
+
+
+/************************************************************************************************* ГЛОБАЛЬНЫЕ ФУНКЦИИ */
+
+/** Включение передатчика USART выгрузки */
+void SoftSWD_Dump_Init(void)
+{
+#ifndef SOFT_SWD_HOST_SIM
+    USART_Init_Struct init;
+    init.USARTx = SOFT_SWD_DUMP_USART;
+    init.GPIO_port_Tx = SOFT_SWD_DUMP_TX_PORT;
+    init.GPIO_pin_Tx = SOFT_SWD_DUMP_TX_PIN;
+    init.GPIO_port_Rx = NULL;               // только передача
+    init.GPIO_pin_Rx = 0;
+    init.baudrate = SOFT_SWD_DUMP_BAUDRATE;
+    USART_Enable(&init);
+#endif
+}
+
+/** Выгрузка памяти таргета */
+SoftSWD_Status_t SoftSWD_Dump(uint32_t address, uint32_t size)
+{
+    uint32_t start = DWT_Get_Cycles();
+    SoftSWD_Status_t status = SOFT_SWD_OK;
+    uint32_t offset = 0;
+    uint16_t seq = 0;
+
+    soft_swd_dump.frames = 0;
+    soft_swd_dump.bytes = 0;
+    soft_swd_dump.stall_cycles = 0;
+
+    do
+    {
+        // 1. Кусок в свободный буфер: пока SWD читает, DMA передает предыдущий кадр из другого буфера
+        SoftSWD_Dump_Frame_t* frame = &dump_frames[seq & 0x1];
+        uint32_t length = size - offset;
+        if (length > SOFT_SWD_DUMP_CHUNK) length = SOFT_SWD_DUMP_CHUNK;
+
+        if (length) status = SoftSWD_ReadMemory_Stream(address + offset, frame->data, length);
+
+        uint16_t flags = 0;
+        if (status != SOFT_SWD_OK)
+        {
+            flags = SOFT_SWD_DUMP_ERROR | SOFT_SWD_DUMP_LAST | ((uint16_t)status << 8);
+            length = 0;
+        }
+        else if (offset + length == size) flags = SOFT_SWD_DUMP_LAST;
+
+        Dump_Seal_Frame(frame, seq, flags, address + offset, length);
+
+        // 2. Кадр уходит после предыдущего: ожидание здесь - время, на которое USART отстает от SWD
+        uint32_t wait_start = DWT_Get_Cycles();
+        SOFT_SWD_DUMP_WAIT();
+        soft_swd_dump.stall_cycles += DWT_Get_Cycles() - wait_start;
+
+        SOFT_SWD_DUMP_TRANSMIT((uint8_t*)frame, sizeof(SoftSWD_Dump_Header_t) + length);
+
+        soft_swd_dump.frames++;
+        soft_swd_dump.bytes += length;
+        offset += length;
+        seq++;
+    }
+    while ((status == SOFT_SWD_OK) && (offset < size));
+
+    // 3. Последний кадр передан целиком
+    SOFT_SWD_DUMP_WAIT();
+
+    uint32_t cycles = DWT_Get_Cycles() - start;
+    soft_swd_dump.cycles = cycles;
+    soft_swd_dump.kbps = cycles ? (uint32_t)(((uint64_t)soft_swd_dump.bytes * SystemCoreClock) / ((uint64_t)cycles * 1024)) : 0;
+
+    return status;
+}
+/**********************************************************************************************************************/
@@ -0,0 +1,86 @@
+/***********************************************************************************************************************
+*   Выгрузка памяти таргета (Flash, RAM) на ПК через USART
+*       Память читается кусками по SOFT_SWD_DUMP_CHUNK байт через SoftSWD_ReadMemory_Stream, каждый кусок уходит
+*   по USART через DMA отдельным кадром. Буферов кадра два: пока DMA передает один, SWD читает следующий кусок
+*   во второй, так что скорость выгрузки - скорость самого медленного из двух каналов, а не их сумма.
+*
+*       Кадр (little-endian, как память Cortex-M):
+*           magic   uint32  SOFT_SWD_DUMP_MAGIC ("SWDD")
+*           seq     uint16  номер кадра с 0
+*           flags   uint16  SOFT_SWD_DUMP_LAST, SOFT_SWD_DUMP_ERROR; старший байт - SoftSWD_Status_t при ошибке
+*           address uint32  адрес первого байта куска в памяти таргета
+*           length  uint32  байт данных за заголовком
+*           crc     uint32  CRC-32 (crc32.h, как zlib.crc32) 16 байт заголовка до crc и данных
+*           data    length байт
+*   Последний кадр - с флагом SOFT_SWD_DUMP_LAST. При ошибке SWD выгрузка обрывается кадром SOFT_SWD_DUMP_ERROR
+*   без данных (address - начало непрочитанного куска). Прием и сборка образа на ПК - soft_swd_dump.py.
+*   Пример:
+*       SoftSWD_Dump_Init();
+*       SoftSWD_Dump(FLASH_ADDRESS_START, 128 * 1024);
+***********************************************************************************************************************/
+
+#ifndef __SOFT_SWD_DUMP_H__
+#define __SOFT_SWD_DUMP_H__
+
+#include "soft_SWD.h"
+
+#define SOFT_SWD_DUMP_CHUNK         (1024)          // Байт данных в кадре (кратно 4, не больше SOFT_SWD_TAR_WRAP)
+#define SOFT_SWD_DUMP_MAGIC         (0x44445753u)   // "SWDD"
+#define SOFT_SWD_DUMP_LAST          (0x0001u)       // Последний кадр выгрузки
+#define SOFT_SWD_DUMP_ERROR         (0x0002u)       // Ошибка SWD, выгрузка оборвана
+
+// Только передача, USART1 TX - PA9 (AF7). USART2 не подходит: его RX (PA3) - это SWCLK, а PA10 (RX USART1) - DCMI D1
+#define SOFT_SWD_DUMP_USART         USART1
+#define SOFT_SWD_DUMP_TX_PORT       GPIOA
+#define SOFT_SWD_DUMP_TX_PIN        9
+#define SOFT_SWD_DUMP_BAUDRATE      (2250000)       // BRR_2250000: APB2 84 МГц, BRR = 37 (ошибка 0.9%); как в soft_swd_dump.py
+
+/*************************************************************************************************** Передача кадров */
+#ifdef SOFT_SWD_HOST_SIM
+#define SOFT_SWD_DUMP_TRANSMIT(data, size)  SoftSWD_Sim_Uart_Transmit((data), (size))
+#define SOFT_SWD_DUMP_WAIT()                SoftSWD_Sim_Uart_Wait()
+#else
+#include "usart.h"
+#define SOFT_SWD_DUMP_TRANSMIT(data, size)  USART_Transmit_DMA(SOFT_SWD_DUMP_USART, (data), (size))
+#define SOFT_SWD_DUMP_WAIT()                USART_Wait_DMA(SOFT_SWD_DUMP_USART)
+#endif
+/**********************************************************************************************************************/
+
+typedef struct
+{
+    uint32_t magic;
+    uint16_t seq;
+    uint16_t flags;
+    uint32_t address;
+    uint32_t length;
+    uint32_t crc;
+}
+SoftSWD_Dump_Header_t;
+
+typedef struct
+{
+    SoftSWD_Dump_Header_t header;
+    uint8_t data[SOFT_SWD_DUMP_CHUNK];  // сразу за заголовком: кадр уходит одной передачей DMA
+}
+SoftSWD_Dump_Frame_t;
+
+typedef struct
+{
+    uint32_t frames;                // отправлено кадров
+    uint32_t bytes;                 // отправлено байт памяти
+    uint32_t cycles;                // время выгрузки, такты DWT
+    uint32_t stall_cycles;          // ожидание DMA после чтения куска: USART медленнее SWD
+    uint32_t kbps;                  // скорость, КБ/с
+}
+SoftSWD_Dump_Stats_t;
+
+extern SoftSWD_Dump_Stats_t soft_swd_dump;
+
+/** Включение передатчика SOFT_SWD_DUMP_USART (без приемника), один раз до SoftSWD_Dump */
+void SoftSWD_Dump_Init(void);
+
+/** Выгрузка size байт памяти таргета с адреса address (кратен 4). Возвращает SOFT_SWD_OK или ошибку SWD, на которой
+*   выгрузка оборвана; статистика - в soft_swd_dump */
+SoftSWD_Status_t SoftSWD_Dump(uint32_t address, uint32_t size);
+
+#endif /* __SOFT_SWD_DUMP_H__ */
@@ -0,0 +1,351 @@
+/***********************************************************************************************************************
+*   Программный SWD на несколько таргетов сразу (см. soft_SWD_gang.h)
+***********************************************************************************************************************/
+
+#include "soft_SWD_gang.h"
+#include "soft_SWD_phy.h"
+#include "systick.h"
+
+SoftSWD_Gang_t soft_swd_gang;
+
+/***************************************************************************************** Настройка пинов и SWCLK */
+#ifndef SOFT_SWD_HOST_SIM
+
+/** Настройка пина: режим, тип выхода, скорость, подтяжка */
+static void gang_pin(GPIO_TypeDef* port, uint32_t pin, uint32_t otype, uint32_t pupd)
+{
+    port->MODER &= ~(MODER_ANALOG << (pin * 2));
+    port->MODER |= (MODER_OUTPUT << (pin * 2));
+
+    port->OTYPER &= ~(OTYPER_OPEN_DRAIN << pin);
+    port->OTYPER |= (otype << pin);
+
+    port->OSPEEDR &= ~(OSPEEDR_VERY_HIGH << (pin * 2));
+    port->OSPEEDR |= (OSPEEDR_VERY_HIGH << (pin * 2));
+
+    port->PUPDR &= ~(PUPDR_RESERVED << (pin * 2));
+    port->PUPDR |= (pupd << (pin * 2));
+}
+
+/** Включение тактирования порта и настройка пинов */
+static void gang_pins_enable(void)
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIODEN;
+
+    for (uint32_t t = 0; t < SOFT_SWD_GANG_TARGETS; t++)
+    {
+        gang_pin(SOFT_SWD_GANG_DATA_PORT, SOFT_SWD_GANG_DATA_PIN + t, OTYPER_PUSH_PULL, PUPDR_PU);
+    }
+    gang_pin(SOFT_SWD_GANG_CLK_PORT, SOFT_SWD_GANG_CLK_PIN, OTYPER_PUSH_PULL, PUPDR_NO_PUPD);
+    gang_pin(SOFT_SWD_GANG_RESET_PORT, SOFT_SWD_GANG_RESET_PIN, OTYPER_OPEN_DRAIN, PUPDR_PU);
+
+    SOFT_SWD_GANG_CLK_LOW();
+    SOFT_SWD_GANG_RESET_HIGH();     // Таргеты работают
+}
+#endif
+/**********************************************************************************************************************/
+
+
+/******************************************************************************** Биты на всех линиях одновременно */
+
+/** Полупериод SWCLK: цикл NOP без обращений к периферии */
+static inline void gang_delay(uint32_t count)
+{
+    for (uint32_t i = count; i; i--) __NOP();
+}
+
+/** Уровни levels на линиях SWDIO (одна запись BSRR), затем такт SWCLK */
+static inline void gang_write_bit(uint32_t levels, uint32_t half)
+{
+    SOFT_SWD_GANG_DATA_WRITE(levels);
+    gang_delay(half);
+    SOFT_SWD_GANG_CLK_HIGH();
+    gang_delay(half);
+    SOFT_SWD_GANG_CLK_LOW();
+}
+
+/** Чтение всех линий SWDIO (одно чтение IDR) до фронта SWCLK */
+static inline uint32_t gang_read_bit(uint32_t half)
+{
+    gang_delay(half);
+    uint32_t levels = SOFT_SWD_GANG_DATA_READ();
+    SOFT_SWD_GANG_CLK_HIGH();
+    gang_delay(half);
+    SOFT_SWD_GANG_CLK_LOW();
+    return levels;
+}
+
+/** Передача bits младших бит data таргетам targets, остальные линии - 0 (простой) */
+static void gang_write(uint32_t data, uint32_t bits, uint32_t targets)
+{
+    const uint32_t half = soft_swd_gang.half_period;
+    while (bits--)
+    {
+        gang_write_bit(targets & (0U - (data & 0x1U)), half);
+        data >>= 1;
+    }
+}
+
+/** Пустые такты SWCLK */
+static void gang_clock(uint32_t cycles)
+{
+    const uint32_t half = soft_swd_gang.half_period;
+    while (cycles--)
+    {
+        gang_delay(half);
+        SOFT_SWD_GANG_CLK_HIGH();
+        gang_delay(half);
+        SOFT_SWD_GANG_CLK_LOW();
+    }
+}
+
+/** Байт простоя на всех линиях (как SoftSWD_Idle_Byte) */
+static void gang_idle_byte(void)
+{
+    gang_write(0x0, 8, 0x0);
+}
+
+/** Сброс линии всех таргетов */
+static void gang_line_reset(void)
+{
+    gang_write(0xFFFFFFFF, 32, SOFT_SWD_GANG_ALL);
+    gang_write(0xFFFFFFFF, 18, SOFT_SWD_GANG_ALL);
+}
+
+static uint32_t gang_parity(uint32_t data)
+{
+    data ^= data >> 16;
+    data ^= data >> 8;
+    data ^= data >> 4;
+    data ^= data >> 2;
+    data ^= data >> 1;
+    return data & 0x1;
+}
+
+/** Запрос в порядке передачи (start - первым) */
+static uint32_t gang_request(uint8_t DP_AP, uint8_t RnW, uint8_t Addr)
+{
+    uint32_t A2 = (Addr >> 2) & 0x1;
+    uint32_t A3 = (Addr >> 3) & 0x1;
+    uint32_t parity = (DP_AP ^ RnW ^ A2 ^ A3) & 0x1;
+    return 0x1 | ((uint32_t)DP_AP << 1) | ((uint32_t)RnW << 2) | (A2 << 3) | (A3 << 4) | (parity << 5) | (0x1 << 7);
+}
+/**********************************************************************************************************************/
+
+
+/******************************************************************************** Транзакция на нескольких таргетах */
+
+/** Одна транзакция таргетов targets без байтов простоя: запрос всем, ACK каждого, данные - только ответившим OK.
+*   Таргеты с WAIT/FAULT в фазе данных получают нули. Возвращает маску OK, *wait - маску WAIT */
+static uint32_t gang_transfer(uint32_t targets, uint32_t request, uint8_t RnW, uint32_t wdata, uint32_t* values,
+                              uint32_t* wait)
+{
+    const uint32_t half = soft_swd_gang.half_period;
+
+    // 1. Запрос, turnaround: линии таргетов - на вход
+    gang_write(request, 8, targets);
+    SOFT_SWD_GANG_SET_OUTPUTS(~targets & SOFT_SWD_GANG_ALL);
+    gang_clock(1);
+
+    // 2. ACK: три чтения IDR, бит i ответа таргета t - бит t i-го чтения
+    uint32_t a0 = gang_read_bit(half);
+    uint32_t a1 = gang_read_bit(half);
+    uint32_t a2 = gang_read_bit(half);
+    uint32_t ok = targets & a0 & ~a1 & ~a2;
+    *wait = targets & ~a0 & a1 & ~a2;
+
+    for (uint32_t t = 0; t < SOFT_SWD_GANG_TARGETS; t++)
+    {
+        if (targets & (0x1U << t))
+        {
+            soft_swd_gang.ack[t] = (uint8_t)(((a0 >> t) & 0x1) | (((a1 >> t) & 0x1) << 1) | (((a2 >> t) & 0x1) << 2));
+        }
+    }
+
+    if (RnW == WRITE)
+    {
+        // 3. Turnaround, данные и четность ответившим OK
+        gang_clock(1);
+        SOFT_SWD_GANG_SET_OUTPUTS(SOFT_SWD_GANG_ALL);
+        gang_write(wdata, 32, ok);
+        gang_write(gang_parity(wdata), 1, ok);
+        return ok;
+    }
+
+    // 3. Чтение: первый такт данных - turnaround для таргетов без OK, дальше на их линиях мастер держит 0
+    uint32_t raw[33];
+    raw[0] = gang_read_bit(half);
+    SOFT_SWD_GANG_DATA_WRITE(0x0);
+    SOFT_SWD_GANG_SET_OUTPUTS(~ok & SOFT_SWD_GANG_ALL);
+    for (uint32_t i = 1; i < 33; i++) raw[i] = gang_read_bit(half);
+
+    // 4. Turnaround, все линии - на выход
+    gang_clock(1);
+    SOFT_SWD_GANG_SET_OUTPUTS(SOFT_SWD_GANG_ALL);
+
+    // 5. Разбор: бит i слова таргета t - бит t i-го чтения, четность - у каждого своя
+    for (uint32_t t = 0; t < SOFT_SWD_GANG_TARGETS; t++)
+    {
+        if (!(ok & (0x1U << t))) continue;
+
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < 32; i++) value |= ((raw[i] >> t) & 0x1) << i;
+
+        if (gang_parity(value) != ((raw[32] >> t) & 0x1))
+        {
+            ok &= ~(0x1U << t);
+            soft_swd_gang.ack[t] = SWD_ACK_PARITY;
+        }
+        else values[t] = value;
+    }
+    return ok;
+}
+
+/** Сброс ошибок таргетов (запись DP_ABORT), DP_ABORT принимается и при занятой шине */
+static void gang_clear_errors(uint32_t targets)
+{
+    uint32_t wait;
+    gang_idle_byte();
+    gang_transfer(targets, gang_request(DP, WRITE, DP_ABORT), WRITE,
+                  DP_ABORT_ORUNERRCLR | DP_ABORT_WDERRCLR | DP_ABORT_STKERRCLR | DP_ABORT_STKCMPCLR, 0, &wait);
+    soft_swd_gang.faults++;
+}
+
+/** Транзакция всех таргетов в работе с повторами: WAIT - повтор только для ответивших WAIT, FAULT или ошибка
+*   четности - сброс ошибок и один повтор, дальше таргет исключается */
+static uint32_t gang_register(uint8_t DP_AP, uint8_t RnW, uint8_t Addr, uint32_t wdata, uint32_t* values)
+{
+    uint32_t request = gang_request(DP_AP, RnW, Addr);
+    uint32_t pending = soft_swd_gang.active;
+    uint32_t cleared = 0;
+
+    gang_idle_byte();
+    for (uint32_t attempt = 0; pending && (attempt < SOFT_SWD_GANG_RETRIES); attempt++)
+    {
+        uint32_t wait;
+        pending &= ~gang_transfer(pending, request, RnW, wdata, values, &wait);
+        if (wait) soft_swd_gang.waits++;
+
+        uint32_t fault = pending & ~wait;
+        if (fault)
+        {
+            SoftSWD_Gang_Fail(fault & cleared, SOFT_SWD_GANG_ERROR_ACK);
+            pending &= ~(fault & cleared);
+            if (fault & ~cleared) gang_clear_errors(fault & ~cleared);
+            cleared |= fault;
+        }
+    }
+
+    SoftSWD_Gang_Fail(pending, SOFT_SWD_GANG_ERROR_ACK);
+    return soft_swd_gang.active;
+}
+/**********************************************************************************************************************/
+
+
+/************************************************************************************************* ГЛОБАЛЬНЫЕ ФУНКЦИИ */
+
+/** Длительность пробной посылки с заданным полупериодом (минимум из нескольких замеров) */
+static uint32_t gang_measure(uint32_t half_period)
+{
+    uint32_t best = 0xFFFFFFFF;
+    soft_swd_gang.half_period = half_period;
+
+    for (uint8_t attempt = 0; attempt < 4; attempt++)
+    {
+        uint32_t start = DWT_Get_Cycles();
+        gang_write(0x0, SOFT_SWD_PHY_CALIBRATION_BITS, 0x0);    // нули - простой линии
+        uint32_t cycles = DWT_Get_Cycles() - start;
+        if (cycles < best) best = cycles;
+    }
+    return best;
+}
+
+/** Инициализация */
+void SoftSWD_Gang_Init(uint32_t targets)
+{
+#ifndef SOFT_SWD_HOST_SIM
+    gang_pins_enable();
+#endif
+    SOFT_SWD_GANG_SET_OUTPUTS(SOFT_SWD_GANG_ALL);
+
+    soft_swd_gang.targets = targets & SOFT_SWD_GANG_ALL;
+    soft_swd_gang.active = 0;
+    soft_swd_gang.waits = 0;
+    soft_swd_gang.faults = 0;
+
+    // Калибровка полупериода по DWT, как в SoftSWD_Phy_Init: длительность посылки линейна по полупериоду
+    DWT_Init();
+    uint32_t c0 = gang_measure(0);
+    uint32_t c1 = gang_measure(SOFT_SWD_PHY_CALIBRATION_PROBE);
+    uint32_t target = (SystemCoreClock / (uint32_t)SOFT_SWD_PHY_CLOCK) * SOFT_SWD_PHY_CALIBRATION_BITS;
+
+    soft_swd_gang.half_period = 0;
+    if (target > c0 && c1 > c0)
+    {
+        soft_swd_gang.half_period = ((target - c0) * SOFT_SWD_PHY_CALIBRATION_PROBE + (c1 - c0) / 2) / (c1 - c0);
+    }
+}
+
+/** Подключение */
+uint32_t SoftSWD_Gang_Connect(void)
+{
+    soft_swd_gang.active = soft_swd_gang.targets;
+    for (uint32_t t = 0; t < SOFT_SWD_GANG_TARGETS; t++)
+    {
+        soft_swd_gang.errors[t] = 0;
+        soft_swd_gang.idcode[t] = 0;
+        soft_swd_gang.ack[t] = 0;
+    }
+
+    // 1. Сброс линии, JTAG -> SWD, сброс линии (как SoftSWD_Sync_Target)
+    SOFT_SWD_GANG_SET_OUTPUTS(SOFT_SWD_GANG_ALL);
+    gang_line_reset();
+    gang_write(SOFT_SWD_JTAG_TO_SWD, 16, SOFT_SWD_GANG_ALL);
+    gang_line_reset();
+
+    // 2. IDCODE: кто не ответил - исключается
+    SoftSWD_Gang_ReadRegister(DP, DP_IDCODE, soft_swd_gang.idcode);
+
+    // 3. Питание отладки и MEM-AP
+    SoftSWD_Gang_set_MEM_AP();
+    return soft_swd_gang.active;
+}
+
+/** Аппаратный сброс всех таргетов */
+void SoftSWD_Gang_Reset_Targets(void)
+{
+    SOFT_SWD_GANG_RESET_LOW();
+    delay_ms(10);
+    SOFT_SWD_GANG_RESET_HIGH();
+    delay_ms(10);
+}
+
+/** Запись регистра */
+uint32_t SoftSWD_Gang_WriteRegister(uint8_t DP_AP, uint8_t Addr, uint32_t register_value)
+{
+    return gang_register(DP_AP, WRITE, Addr, register_value, 0);
+}
+
+/** Чтение регистра */
+uint32_t SoftSWD_Gang_ReadRegister(uint8_t DP_AP, uint8_t Addr, uint32_t* values)
+{
+    return gang_register(DP_AP, READ, Addr, 0, values);
+}
+
+/** Настройка DP для MEM-AP */
+void SoftSWD_Gang_set_MEM_AP(void)
+{
+    SoftSWD_Gang_WriteRegister(DP, DP_CTRL_STAT, DP_CTRL_STAT_CSYSPWRUPREQ | DP_CTRL_STAT_CDBGPWRUPREQ);
+    SoftSWD_Gang_WriteRegister(DP, DP_SELECT, DP_SELECT_APSEL(MEM_AP_APSEL) | DP_SELECT_APBANKSEL(MEM_AP_APBANKSEL));
+}
+
+/** Исключение таргетов */
+void SoftSWD_Gang_Fail(uint32_t targets, uint32_t error)
+{
+    targets &= soft_swd_gang.active;
+    for (uint32_t t = 0; t < SOFT_SWD_GANG_TARGETS; t++)
+    {
+        if (targets & (0x1U << t)) soft_swd_gang.errors[t] |= error;
+    }
+    soft_swd_gang.active &= ~targets;
+}
@@ -0,0 +1,138 @@
+/***********************************************************************************************************************
+*   Программный SWD на несколько таргетов сразу (gang)
+*       SWCLK у всех таргетов общий, у каждого своя линия SWDIO, линии идут подряд на одном порту. Бит всем таргетам
+*   выставляется одной записью BSRR (единицы - в младшей половине, нули - в старшей), ACK и данные чтения всех
+*   таргетов принимаются одним чтением IDR. Бит t всех масок модуля - таргет t (пин SOFT_SWD_GANG_DATA_PIN + t).
+*
+*       Запрос и данные записи у всех таргетов одинаковые, ACK и прочитанные данные - у каждого свои. Таргет, который
+*   ответил не OK, в фазе данных получает нули (для него это простой линии) и повторяет транзакцию отдельно от
+*   остальных: WAIT - повтор, FAULT или ошибка четности - сброс ошибок через DP_ABORT и еще один повтор. Если и после
+*   этого ACK не OK, таргет исключается из soft_swd_gang.active с причиной в errors[t], остальные продолжают работу.
+*   Длительность транзакции от числа таргетов почти не зависит, поэтому скорость прошивки растет с числом таргетов
+*   почти линейно. Запись Flash - programmer_gang_Flash.h.
+*   Пример:
+*       SoftSWD_Gang_Init(0x0F);                    // таргеты на PD0...PD3
+*       uint32_t ok = SoftSWD_Gang_Connect();       // маска таргетов, ответивших IDCODE
+***********************************************************************************************************************/
+
+#ifndef __SOFT_SWD_GANG_H__
+#define __SOFT_SWD_GANG_H__
+
+#include "soft_SWD.h"
+
+/********************************************************************************************* Пины SWD всех таргетов */
+// PD0 ... PD7 => SWDIO таргетов 0 ... 7
+#define SOFT_SWD_GANG_DATA_PORT     GPIOD
+#define SOFT_SWD_GANG_DATA_PIN      0
+#define SOFT_SWD_GANG_TARGETS       8
+
+// PD8 => SWCLK всех таргетов
+#define SOFT_SWD_GANG_CLK_PORT      GPIOD
+#define SOFT_SWD_GANG_CLK_PIN       8
+
+// PD9 => RESET всех таргетов (открытый сток)
+#define SOFT_SWD_GANG_RESET_PORT    GPIOD
+#define SOFT_SWD_GANG_RESET_PIN     9
+
+#if (SOFT_SWD_GANG_TARGETS > 8) || (SOFT_SWD_GANG_DATA_PIN + SOFT_SWD_GANG_TARGETS > 16)
+#error "SOFT_SWD_GANG: до 8 линий SWDIO на одном порту"
+#endif
+
+#define SOFT_SWD_GANG_ALL           ((0x1U << SOFT_SWD_GANG_TARGETS) - 1)
+#define SOFT_SWD_GANG_MODER_MASK    (((0x1U << (SOFT_SWD_GANG_TARGETS * 2)) - 1) << (SOFT_SWD_GANG_DATA_PIN * 2))
+/**********************************************************************************************************************/
+
+
+/************************************************************************************** Управление пинами всех таргетов */
+// levels и outputs - маски таргетов
+#ifdef SOFT_SWD_HOST_SIM
+#define SOFT_SWD_GANG_DATA_WRITE(levels)    SoftSWD_Sim_Gang_Data(levels)
+#define SOFT_SWD_GANG_DATA_READ()           (SoftSWD_Sim_Gang_Read() & SOFT_SWD_GANG_ALL)
+#define SOFT_SWD_GANG_SET_OUTPUTS(outputs)  SoftSWD_Sim_Gang_Direction(outputs)
+
+#define SOFT_SWD_GANG_CLK_HIGH()            SoftSWD_Sim_Gang_Clock(1)
+#define SOFT_SWD_GANG_CLK_LOW()             SoftSWD_Sim_Gang_Clock(0)
+
+#define SOFT_SWD_GANG_RESET_HIGH()          SoftSWD_Sim_Gang_Reset(1)
+#define SOFT_SWD_GANG_RESET_LOW()           SoftSWD_Sim_Gang_Reset(0)
+#else
+#define SOFT_SWD_GANG_DATA_WRITE(levels)    (SOFT_SWD_GANG_DATA_PORT->BSRR =                                        \
+                                                (((levels) & SOFT_SWD_GANG_ALL) << SOFT_SWD_GANG_DATA_PIN) |        \
+                                                ((~(levels) & SOFT_SWD_GANG_ALL) << (SOFT_SWD_GANG_DATA_PIN + 16)))
+#define SOFT_SWD_GANG_DATA_READ()           ((SOFT_SWD_GANG_DATA_PORT->IDR >> SOFT_SWD_GANG_DATA_PIN) & SOFT_SWD_GANG_ALL)
+
+// Таргеты из outputs - выход, остальные - вход (MODER_OUTPUT = 01 в каждом поле пина)
+#define SOFT_SWD_GANG_SET_OUTPUTS(outputs)  (SOFT_SWD_GANG_DATA_PORT->MODER =                                       \
+                                                (SOFT_SWD_GANG_DATA_PORT->MODER & ~SOFT_SWD_GANG_MODER_MASK) |      \
+                                                (SoftSWD_Gang_Spread(outputs) << (SOFT_SWD_GANG_DATA_PIN * 2)))
+
+#define SOFT_SWD_GANG_CLK_HIGH()            (SOFT_SWD_GANG_CLK_PORT->BSRR = (0x1U << SOFT_SWD_GANG_CLK_PIN))
+#define SOFT_SWD_GANG_CLK_LOW()             (SOFT_SWD_GANG_CLK_PORT->BSRR = (0x1U << (SOFT_SWD_GANG_CLK_PIN + 16)))
+
+#define SOFT_SWD_GANG_RESET_HIGH()          (SOFT_SWD_GANG_RESET_PORT->BSRR = (0x1U << SOFT_SWD_GANG_RESET_PIN))
+#define SOFT_SWD_GANG_RESET_LOW()           (SOFT_SWD_GANG_RESET_PORT->BSRR = (0x1U << (SOFT_SWD_GANG_RESET_PIN + 16)))
+#endif
+
+/** Биты маски раздвигаются через один: бит t -> бит 2t (поле MODER пина t) */
+static inline uint32_t SoftSWD_Gang_Spread(uint32_t mask)
+{
+    mask &= 0xFFU;
+    mask = (mask | (mask << 4)) & 0x0F0FU;
+    mask = (mask | (mask << 2)) & 0x3333U;
+    mask = (mask | (mask << 1)) & 0x5555U;
+    return mask;
+}
+/**********************************************************************************************************************/
+
+
+/************************************************************************************************ Состояние таргетов */
+
+#define SOFT_SWD_GANG_RETRIES       (1000)  // Повторов транзакции при ACK WAIT (как в SoftSWD_WriteRegister)
+
+/** Причины исключения таргета (errors[t]), флаги FLASH_STS добавляет programmer_gang_Flash */
+#define SOFT_SWD_GANG_ERROR_ACK     (0x1U << 16)    // Нет ACK OK после повторов и сброса ошибок (ack[t] - последний ответ)
+#define SOFT_SWD_GANG_ERROR_TIMEOUT (0x1U << 17)    // Регистр таргета не пришел в ожидаемое состояние (BUSY Flash)
+
+typedef struct
+{
+    uint32_t targets;                           // подключенные к программатору (SoftSWD_Gang_Init)
+    uint32_t active;                            // в работе: ошибка исключает таргет до SoftSWD_Gang_Connect
+    uint32_t idcode[SOFT_SWD_GANG_TARGETS];
+    uint32_t errors[SOFT_SWD_GANG_TARGETS];     // причина исключения, 0 - таргет в работе
+    uint8_t ack[SOFT_SWD_GANG_TARGETS];         // последний ACK, SWD_ACK_PARITY - ошибка четности чтения
+    uint32_t waits;                             // повторов транзакций из-за WAIT (накопительно)
+    uint32_t faults;                            // сбросов ошибок через DP_ABORT (накопительно)
+    uint32_t half_period;                       // итераций цикла NOP на полупериод SWCLK
+}
+SoftSWD_Gang_t;
+
+extern SoftSWD_Gang_t soft_swd_gang;
+
+
+/************************************************************************************************** Прототипы функций */
+
+/** Включение тактирования порта, настройка пинов и калибровка SWCLK на SOFT_SWD_PHY_CLOCK; targets - маска таргетов,
+*   подключенных к программатору */
+void SoftSWD_Gang_Init(uint32_t targets);
+
+/** Сброс линии, переключение JTAG -> SWD и чтение IDCODE всеми таргетами, затем включение питания отладки
+*   и выбор MEM-AP. Возвращает маску таргетов в работе (ответивших IDCODE) */
+uint32_t SoftSWD_Gang_Connect(void);
+
+/** Аппаратный сброс всех таргетов */
+void SoftSWD_Gang_Reset_Targets(void);
+
+/** Запись одного значения в регистр AP или DP всех таргетов в работе, возвращает маску таргетов в работе */
+uint32_t SoftSWD_Gang_WriteRegister(uint8_t DP_AP, uint8_t Addr, uint32_t register_value);
+
+/** Чтение регистра AP или DP всех таргетов в работе в values[SOFT_SWD_GANG_TARGETS] (значения исключенных таргетов
+*   не меняются), возвращает маску таргетов в работе */
+uint32_t SoftSWD_Gang_ReadRegister(uint8_t DP_AP, uint8_t Addr, uint32_t* values);
+
+/** Настройка DP всех таргетов в работе для работы с MEM-AP */
+void SoftSWD_Gang_set_MEM_AP(void);
+
+/** Исключение таргетов из работы с причиной error (добавляется к errors[t]) */
+void SoftSWD_Gang_Fail(uint32_t targets, uint32_t error);
+
+#endif /* __SOFT_SWD_GANG_H__ */
@@ -0,0 +1,146 @@
+/***********************************************************************************************************************
+*   Быстрый физический уровень программного SWD (см. soft_SWD_phy.h)
+***********************************************************************************************************************/
+
+#include "soft_SWD_phy.h"
+#include "systick.h"
+
+SoftSWD_Phy_t soft_swd_phy = {SOFT_SWD_PHY_CLOCK, 0, 0, 0};
+SoftSWD_Phy_t soft_swd_phy_clocks[SOFT_SWD_PHY_CLOCKS] =
+{
+    {SOFT_SWD_CLOCK_1MHZ, 0, 0, 0},
+    {SOFT_SWD_CLOCK_2MHZ, 0, 0, 0},
+    {SOFT_SWD_CLOCK_4MHZ, 0, 0, 0}
+};
+
+/** Полупериод SWCLK: цикл NOP без обращений к периферии */
+static inline void phy_delay(uint32_t count)
+{
+    for (uint32_t i = count; i; i--) __NOP();
+}
+
+/** Бит data & 1 на SWDIO, затем такт SWCLK */
+#define PHY_WRITE_BIT(data, half)                                                   \
+{                                                                                   \
+    SOFT_SWD_DATA_WRITE(data);                                                      \
+    phy_delay(half);                                                                \
+    SOFT_SWD_CLK_HIGH();                                                            \
+    phy_delay(half);                                                                \
+    SOFT_SWD_CLK_LOW();                                                             \
+    (data) >>= 1;                                                                   \
+}
+
+/** Чтение SWDIO до фронта SWCLK, принятый бит вдвигается в старший разряд value */
+#define PHY_READ_BIT(value, half)                                                   \
+{                                                                                   \
+    phy_delay(half);                                                                \
+    (value) = ((value) >> 1) | (SOFT_SWD_DATA_READ() << 31);                        \
+    SOFT_SWD_CLK_HIGH();                                                            \
+    phy_delay(half);                                                                \
+    SOFT_SWD_CLK_LOW();                                                             \
+}
+
+/** Передача bits младших бит data */
+void SoftSWD_Phy_Write(uint32_t data, uint32_t bits)
+{
+    const uint32_t half = soft_swd_phy.half_period;
+
+    // По 8 бит без проверки счетчика цикла после каждого бита
+    while (bits >= 8)
+    {
+        PHY_WRITE_BIT(data, half); PHY_WRITE_BIT(data, half); PHY_WRITE_BIT(data, half); PHY_WRITE_BIT(data, half);
+        PHY_WRITE_BIT(data, half); PHY_WRITE_BIT(data, half); PHY_WRITE_BIT(data, half); PHY_WRITE_BIT(data, half);
+        bits -= 8;
+    }
+    while (bits--) PHY_WRITE_BIT(data, half);
+}
+
+/** Прием bits бит */
+uint32_t SoftSWD_Phy_Read(uint32_t bits)
+{
+    const uint32_t half = soft_swd_phy.half_period;
+    uint32_t value = 0;
+    uint32_t count = bits;
+
+    while (count >= 8)
+    {
+        PHY_READ_BIT(value, half); PHY_READ_BIT(value, half); PHY_READ_BIT(value, half); PHY_READ_BIT(value, half);
+        PHY_READ_BIT(value, half); PHY_READ_BIT(value, half); PHY_READ_BIT(value, half); PHY_READ_BIT(value, half);
+        count -= 8;
+    }
+    while (count--) PHY_READ_BIT(value, half);
+
+    // Принятые биты лежат в старших разрядах
+    return (bits < 32) ? (value >> (32 - bits)) : value;
+}
+
+/** Пустые такты */
+void SoftSWD_Phy_Clock(uint32_t cycles)
+{
+    const uint32_t half = soft_swd_phy.half_period;
+
+    while (cycles--)
+    {
+        phy_delay(half);
+        SOFT_SWD_CLK_HIGH();
+        phy_delay(half);
+        SOFT_SWD_CLK_LOW();
+    }
+}
+
+/** Длительность пробной посылки с заданным полупериодом (минимум из нескольких замеров - без прерываний SysTick) */
+static uint32_t phy_measure(uint32_t half_period)
+{
+    uint32_t best = 0xFFFFFFFF;
+    soft_swd_phy.half_period = half_period;
+
+    for (uint8_t attempt = 0; attempt < 4; attempt++)
+    {
+        uint32_t start = DWT_Get_Cycles();
+        SoftSWD_Phy_Write(0xFFFFFFFF, SOFT_SWD_PHY_CALIBRATION_BITS);
+        uint32_t cycles = DWT_Get_Cycles() - start;
+        if (cycles < best) best = cycles;
+    }
+    return best;
+}
+
+/** Калибровка всех частот */
+void SoftSWD_Phy_Init(SoftSWD_Clock_t clock)
+{
+    DWT_Init();
+
+    // Длительность посылки линейна по полупериоду: cycles(h) = c0 + h * (c1 - c0) / PROBE, одна пара замеров на все
+    // частоты
+    uint32_t c0 = phy_measure(0);
+    uint32_t c1 = phy_measure(SOFT_SWD_PHY_CALIBRATION_PROBE);
+
+    for (uint32_t i = 0; i < SOFT_SWD_PHY_CLOCKS; i++)
+    {
+        SoftSWD_Phy_t* entry = &soft_swd_phy_clocks[i];
+        uint32_t target = (SystemCoreClock / entry->clock) * SOFT_SWD_PHY_CALIBRATION_BITS;
+
+        entry->half_period = 0;
+        if (target > c0 && c1 > c0)
+        {
+            entry->half_period = ((target - c0) * SOFT_SWD_PHY_CALIBRATION_PROBE + (c1 - c0) / 2) / (c1 - c0);
+        }
+
+        uint32_t cycles = phy_measure(entry->half_period);
+        entry->bit_cycles = cycles / SOFT_SWD_PHY_CALIBRATION_BITS;
+        entry->actual_clock = (uint32_t)(((uint64_t)SystemCoreClock * SOFT_SWD_PHY_CALIBRATION_BITS) / cycles);
+    }
+
+    SoftSWD_Phy_Set_Clock(clock);
+}
+
+/** Смена частоты */
+uint8_t SoftSWD_Phy_Set_Clock(SoftSWD_Clock_t clock)
+{
+    for (uint32_t i = 0; i < SOFT_SWD_PHY_CLOCKS; i++)
+    {
+        if (soft_swd_phy_clocks[i].clock != (uint32_t)clock) continue;
+        soft_swd_phy = soft_swd_phy_clocks[i];
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+/***********************************************************************************************************************
+*   Быстрый физический уровень программного SWD
+*       В soft_SWD.c каждый бит - два вызова delay_ticks, которая опрашивает SysTick->VAL с ветвлениями: такт SWCLK
+*   медленный и неровный. Здесь уровень SWDIO выставляется одной записью в BSRR без ветвлений (сдвиг маски сброса
+*   на 16 бит для единицы), биты развернуты по 8 без проверок цикла, а полупериод SWCLK - цикл NOP с постоянным
+*   числом итераций. Число итераций подбирается по счетчику тактов DWT (SoftSWD_Phy_Init) сразу для всех частот
+*   SoftSWD_Clock_t: пробные посылки - это единицы на SWDIO, то есть сброс линии для таргета, поэтому калибровка
+*   идет один раз в SoftSWD_Init до синхронизации, а смена частоты потом - только выбор из таблицы.
+*
+*       Подключается в soft_SWD.c при SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_PHY, поэтому SoftSWD_WriteRegister,
+*   SoftSWD_ReadRegister и все функции выше (чтение памяти, прошивка Flash) ускоряются без изменений.
+*   При SOFT_SWD_TRANSPORT_SPI через него идут отдельные биты (ACK, четность, turnaround).
+*   Пример:
+*       SoftSWD_Init();                             // внутри SoftSWD_Phy_Init(SOFT_SWD_PHY_CLOCK)
+*       Connect_Target_GetIDCODE();
+*       SoftSWD_Phy_Set_Clock(SOFT_SWD_CLOCK_4MHZ); // смена частоты между транзакциями, сессия DP сохраняется
+***********************************************************************************************************************/
+
+#ifndef __SOFT_SWD_PHY_H__
+#define __SOFT_SWD_PHY_H__
+
+#include "soft_SWD.h"
+
+typedef enum
+{
+    SOFT_SWD_CLOCK_1MHZ = 1000000,
+    SOFT_SWD_CLOCK_2MHZ = 2000000,
+    SOFT_SWD_CLOCK_4MHZ = 4000000
+}
+SoftSWD_Clock_t;
+
+#ifndef SOFT_SWD_PHY_CLOCK
+#define SOFT_SWD_PHY_CLOCK      SOFT_SWD_CLOCK_2MHZ     // Частота SWCLK после SoftSWD_Init (одна из SoftSWD_Clock_t)
+#endif
+
+#define SOFT_SWD_PHY_CLOCKS             3       // Частот в SoftSWD_Clock_t
+
+#define SOFT_SWD_PHY_CALIBRATION_BITS   32      // Длина пробной посылки для замера по DWT
+#define SOFT_SWD_PHY_CALIBRATION_PROBE  16      // Второе пробное значение полупериода (первое - 0)
+
+typedef struct
+{
+    uint32_t clock;                 // заданная частота SWCLK, Гц
+    uint32_t half_period;           // итераций цикла NOP на полупериод SWCLK
+    uint32_t bit_cycles;            // измеренная длительность бита с этим полупериодом, такты процессора
+    uint32_t actual_clock;          // фактическая частота SWCLK по замеру, Гц (меньше заданной, если не хватает скорости)
+}
+SoftSWD_Phy_t;
+
+extern SoftSWD_Phy_t soft_swd_phy;                                  // текущая частота
+extern SoftSWD_Phy_t soft_swd_phy_clocks[SOFT_SWD_PHY_CLOCKS];      // калибровка всех частот SoftSWD_Clock_t
+
+/** Калибровка полупериода по DWT для всех частот SoftSWD_Clock_t и выбор clock. SWDIO в это время держится в 1 -
+*   для таргета это сброс линии, поэтому только до SoftSWD_Sync_Target (вызывается из SoftSWD_Init) */
+void SoftSWD_Phy_Init(SoftSWD_Clock_t clock);
+
+/** Смена частоты SWCLK по таблице калибровки, на линию ничего не передается. 0 - частота не из SoftSWD_Clock_t */
+uint8_t SoftSWD_Phy_Set_Clock(SoftSWD_Clock_t clock);
+
+/** Передача bits (1 ... 32) младших бит data, младший бит первым */
+void SoftSWD_Phy_Write(uint32_t data, uint32_t bits);
+
+/** Прием bits (1 ... 32) бит, первый принятый бит - младший */
+uint32_t SoftSWD_Phy_Read(uint32_t bits);
+
+/** Пустые такты SWCLK без изменения SWDIO (turnaround) */
+void SoftSWD_Phy_Clock(uint32_t cycles);
+
+#endif /* __SOFT_SWD_PHY_H__ */
@@ -0,0 +1,1116 @@
+/***********************************************************************************************************************
+*   Модель таргета SWD для сборки на ПК (см. soft_SWD_sim.h)
+***********************************************************************************************************************/
+
+#ifndef SOFT_SWD_HOST_SIM
+#error "soft_SWD_sim.c собирается только на ПК с -DSOFT_SWD_HOST_SIM"
+#endif
+
+#include "programmer_target_Flash.h"
+#include "programmer_gang_Flash.h"
+#include "soft_SWD_dump.h"
+#include "soft_SWD_phy.h"
+#include "systick.h"
+#include "crc32.h"
+
+#include <stdio.h>
+#include <string.h>
+
+SoftSWD_Sim_t soft_swd_sim;
+uint32_t SystemCoreClock = 168000000;
+
+#define SIM_FLASH_SIZE          (FLASH_ADDRESS_END - FLASH_ADDRESS_START + 1)
+#define SIM_LINE_RESET_BITS     (50)            // Единиц подряд для сброса линии
+#define SIM_STICKY              (DP_CTRL_STAT_STICKYERR | DP_CTRL_STAT_WDATAERR | DP_CTRL_STAT_STICKYORUN)
+#define SIM_FOREVER             (~(uint64_t)0)
+#define SIM_LOADER_LOOP_CYCLES  (20)            // Цикл загрузчика между словами (ldr/str/опрос BUSY)
+#define SIM_CRC_WORD_CYCLES     (72 * 21)       // Слово загрузчика CRC: ~72 такта ядра на 8 МГц (HSI) = 168 / 8
+
+/** Состояния SW-DP по фронтам SWCLK */
+typedef enum
+{
+    SIM_JTAG = 0,           // после включения: ждет сброс линии и последовательность JTAG -> SWD
+    SIM_RESET,              // сброс линии, ждет бит простоя
+    SIM_IDLE,
+    SIM_REQUEST,            // прием 8 бит запроса
+    SIM_TURN,               // turnaround после запроса
+    SIM_DRIVE,              // таргет выдает ACK и данные чтения
+    SIM_TURN_BACK,          // turnaround после ответа таргета
+    SIM_WRITE,              // прием данных записи и четности
+    SIM_LOCKOUT             // запрос с ошибкой формата: таргет молчит до сброса линии
+}
+SimState_t;
+
+typedef struct
+{
+    // Линия
+    SimState_t state;
+    uint32_t host_level;            // ODR мастера
+    uint32_t host_output;           // SWDIO мастера - выход
+    uint32_t clk;
+    uint32_t target_drive;          // SWDIO ведет таргет
+    uint32_t target_level;
+    uint32_t ones;                  // единиц подряд от мастера
+    uint32_t shift;                 // 16 бит после сброса линии (JTAG -> SWD)
+    uint32_t collect;
+    uint32_t bits;
+    uint32_t request;
+    uint64_t out;                   // ACK, данные, четность - младший бит первым
+    uint32_t out_bits;
+    uint32_t write_pending;         // ACK OK на запись: после turnaround - данные
+    uint32_t write_AP;
+    uint32_t write_addr;
+    uint32_t wdata;
+    uint32_t wparity;
+
+    // DP и MEM-AP
+    uint32_t ctrl_stat;
+    uint32_t select;
+    uint32_t rdbuff;
+    uint32_t csw;
+    uint32_t tar;
+    uint64_t ap_busy_until;         // до этого момента шина занята обращением AP (ответ WAIT)
+    uint32_t ap_count;
+    uint32_t read_count;
+
+    // Flash
+    uint8_t flash[SIM_FLASH_SIZE];
+    uint8_t sram[SOFT_SWD_SIM_SRAM_SIZE];
+    uint32_t flash_ac;
+    uint32_t flash_ctrl;
+    uint32_t flash_sts;
+    uint32_t flash_add;
+    uint32_t key_step;              // 0 - ждет KEY1, 1 - ждет KEY2, 2 - неверный ключ, заблокирована до сброса
+    uint64_t flash_busy_until;
+
+    // Ядро
+    uint32_t dhcsr;                 // биты C_* DHCSR
+    uint32_t dcrdr;
+    uint32_t demcr;
+    uint32_t regs[17];
+    uint64_t halt_at;               // ядро остановлено, если time >= halt_at
+    uint32_t busy_buffer;           // буфер RAM, который загрузчик переписывает во Flash до halt_at
+    uint32_t busy_size;
+}
+SimTarget_t;
+
+static SimTarget_t sim_targets[SOFT_SWD_SIM_TARGETS];
+static SimTarget_t* sim = &sim_targets[0];     // таргет, с которым сейчас работает модель
+static uint32_t sim_gang_clk;
+
+
+/*********************************************************************************************** Память и шина AHB */
+
+static uint32_t sim_parity(uint32_t data)
+{
+    data ^= data >> 16;
+    data ^= data >> 8;
+    data ^= data >> 4;
+    data ^= data >> 2;
+    data ^= data >> 1;
+    return data & 0x1;
+}
+
+uint8_t* SoftSWD_Sim_Memory(uint32_t address)
+{
+    if (address >= FLASH_ADDRESS_START && address <= FLASH_ADDRESS_END) return &sim->flash[address - FLASH_ADDRESS_START];
+    if (address >= SRAM_ADDRESS_START && address - SRAM_ADDRESS_START < SOFT_SWD_SIM_SRAM_SIZE) return &sim->sram[address - SRAM_ADDRESS_START];
+    return NULL;
+}
+
+/** Запись слова Flash в момент start (PG, стертое слово), контроллер занят word_cycles */
+static void sim_flash_program(uint32_t address, uint32_t value, uint64_t start)
+{
+    uint32_t word;
+    uint8_t* memory = SoftSWD_Sim_Memory(address);
+    memcpy(&word, memory, 4);
+
+    if (!(sim->flash_ctrl & FLASH_CTRL_PG) || (sim->flash_ctrl & FLASH_CTRL_LOCK) ||
+        (word != 0xFFFFFFFF && !(sim->flash_ctrl & FLASH_CTRL_SMPSEL)))
+    {
+        sim->flash_sts |= FLASH_STS_PGERR;
+        soft_swd_sim.stats.flash_errors++;
+        return;
+    }
+
+    word &= value;
+    memcpy(memory, &word, 4);
+    sim->flash_busy_until = start + soft_swd_sim.word_cycles;
+    sim->flash_sts |= FLASH_STS_EOP;
+    soft_swd_sim.stats.flash_words++;
+}
+
+static uint32_t sim_flash_reg_read(uint32_t address)
+{
+    switch (address)
+    {
+        case FLASH_AC:      return sim->flash_ac;
+        case FLASH_STS:     return sim->flash_sts | ((soft_swd_sim.time < sim->flash_busy_until) ? FLASH_STS_BUSY : 0);
+        case FLASH_CTRL:    return sim->flash_ctrl;
+        case FLASH_ADD:     return sim->flash_add;
+        default:            return 0;
+    }
+}
+
+static void sim_flash_reg_write(uint32_t address, uint32_t value)
+{
+    uint64_t start = (soft_swd_sim.time > sim->flash_busy_until) ? soft_swd_sim.time : sim->flash_busy_until;
+
+    switch (address)
+    {
+        case FLASH_AC:
+            sim->flash_ac = value;
+            break;
+
+        case FLASH_KEY:
+            if (!(sim->flash_ctrl & FLASH_CTRL_LOCK)) break;
+            if (sim->key_step == 0 && value == KEY1) sim->key_step = 1;
+            else if (sim->key_step == 1 && value == KEY2) { sim->key_step = 0; sim->flash_ctrl &= ~FLASH_CTRL_LOCK; }
+            else sim->key_step = 2;
+            break;
+
+        case FLASH_STS:
+            sim->flash_sts &= ~(value & (FLASH_STS_EOP | FLASH_STS_WRPERR | FLASH_STS_PVERR | FLASH_STS_PGERR));
+            break;
+
+        case FLASH_ADD:
+            sim->flash_add = value;
+            break;
+
+        case FLASH_CTRL:
+            if (sim->flash_ctrl & FLASH_CTRL_LOCK) break;
+            sim->flash_ctrl = value & ~FLASH_CTRL_START;
+            if (!(value & FLASH_CTRL_START)) break;
+
+            if (value & FLASH_CTRL_MER)
+            {
+                memset(sim->flash, 0xFF, sizeof(sim->flash));
+                sim->flash_busy_until = start + soft_swd_sim.mass_cycles;
+                soft_swd_sim.stats.flash_pages += FLASH_PAGE_COUNT;
+            }
+            else if ((value & FLASH_CTRL_PER) && SoftSWD_Sim_Memory(sim->flash_add) && sim->flash_add < SRAM_ADDRESS_START)
+            {
+                uint32_t page = (sim->flash_add - FLASH_ADDRESS_START) & ~(FLASH_PAGE_SIZE - 1);
+                memset(&sim->flash[page], 0xFF, FLASH_PAGE_SIZE);
+                sim->flash_busy_until = start + soft_swd_sim.page_cycles;
+                soft_swd_sim.stats.flash_pages++;
+            }
+            sim->flash_sts |= FLASH_STS_EOP;
+            break;
+    }
+}
+
+static uint32_t sim_debug_read(uint32_t address)
+{
+    switch (address - CoreDebug_BASE)
+    {
+        case 0x0:   return sim->dhcsr | CoreDebug_DHCSR_S_REGRDY_Msk |
+                           ((soft_swd_sim.time >= sim->halt_at) ? CoreDebug_DHCSR_S_HALT_Msk : 0);
+        case 0x8:   return sim->dcrdr;
+        case 0xC:   return sim->demcr;
+        default:    return 0;
+    }
+}
+
+static void sim_debug_write(uint32_t address, uint32_t value)
+{
+    switch (address - CoreDebug_BASE)
+    {
+        case 0x0:
+        {
+            if ((value & 0xFFFF0000) != DHCSR_DBGKEY) break;
+            sim->dhcsr = value & 0xF;
+            if (!(value & CoreDebug_DHCSR_C_DEBUGEN_Msk)) break;
+
+            if (value & CoreDebug_DHCSR_C_HALT_Msk)
+            {
+                if (sim->halt_at > soft_swd_sim.time && !soft_swd_sim.errors.no_halt) sim->halt_at = soft_swd_sim.time;
+            }
+            else if (soft_swd_sim.time >= sim->halt_at)
+            {
+                // Запуск: код таргета исполняется сразу, остановка видна мастеру через заданное время
+                soft_swd_sim.stats.loader_runs++;
+                sim->busy_size = 0;
+                uint32_t cycles = soft_swd_sim.run ? soft_swd_sim.run(sim->regs) : SOFT_SWD_SIM_RUN_FOREVER;
+                sim->halt_at = (cycles == SOFT_SWD_SIM_RUN_FOREVER) ? SIM_FOREVER : soft_swd_sim.time + cycles;
+            }
+            break;
+        }
+
+        case 0x4:
+        {
+            uint32_t reg = value & 0x1F;
+            if (soft_swd_sim.time < sim->halt_at || reg > CORE_REG_XPSR) break;
+            if (value & CoreDebug_DCRSR_REGWnR_Msk) sim->regs[reg] = sim->dcrdr;
+            else sim->dcrdr = sim->regs[reg];
+            break;
+        }
+
+        case 0x8:   sim->dcrdr = value;  break;
+        case 0xC:   sim->demcr = value;  break;
+    }
+}
+
+/** Чтение слова по шине: пока Flash занята, обращение к ней задерживает шину (следующая транзакция AP - WAIT) */
+static uint32_t sim_bus_read(uint32_t address)
+{
+    uint32_t value = 0;
+    uint8_t* memory;
+
+    address &= ~0x3u;
+    sim->ap_busy_until = soft_swd_sim.time;
+
+    if ((memory = SoftSWD_Sim_Memory(address)) != NULL)
+    {
+        if (address < SRAM_ADDRESS_START && soft_swd_sim.time < sim->flash_busy_until) sim->ap_busy_until = sim->flash_busy_until;
+        memcpy(&value, memory, 4);
+    }
+    else if (address >= FLASH_AC && address <= FLASH_CAHR) value = sim_flash_reg_read(address);
+    else if (address >= CoreDebug_BASE && address < CoreDebug_BASE + 0x10) value = sim_debug_read(address);
+    else sim->ctrl_stat |= DP_CTRL_STAT_STICKYERR;       // ошибка шины
+
+    return value;
+}
+
+static void sim_bus_write(uint32_t address, uint32_t value)
+{
+    uint8_t* memory;
+
+    address &= ~0x3u;
+    sim->ap_busy_until = soft_swd_sim.time;
+
+    if (address >= FLASH_ADDRESS_START && address <= FLASH_ADDRESS_END)
+    {
+        uint64_t start = (soft_swd_sim.time > sim->flash_busy_until) ? soft_swd_sim.time : sim->flash_busy_until;
+        sim->ap_busy_until = start;
+        sim_flash_program(address, value, start);
+    }
+    else if ((memory = SoftSWD_Sim_Memory(address)) != NULL)
+    {
+        if (soft_swd_sim.time < sim->halt_at && address - sim->busy_buffer < sim->busy_size) soft_swd_sim.stats.loader_conflicts++;
+        memcpy(memory, &value, 4);
+    }
+    else if (address >= FLASH_AC && address <= FLASH_CAHR) sim_flash_reg_write(address, value);
+    else if (address >= CoreDebug_BASE && address < CoreDebug_BASE + 0x10) sim_debug_write(address, value);
+    else sim->ctrl_stat |= DP_CTRL_STAT_STICKYERR;
+}
+/**********************************************************************************************************************/
+
+
+/*************************************************************************************************** Регистры DP и AP */
+
+/** Автоинкремент TAR внутри блока 1 КБ */
+static void sim_tar_increment(void)
+{
+    if ((sim->csw & (0x3U << 4)) == AP_CSW_ADDRINC)
+    {
+        sim->tar = (sim->tar & ~(SOFT_SWD_TAR_WRAP - 1)) | ((sim->tar + 4) & (SOFT_SWD_TAR_WRAP - 1));
+    }
+}
+
+static uint32_t sim_ap_read(uint32_t addr)
+{
+    uint32_t value;
+    if ((sim->select >> 24) != MEM_AP_APSEL) return 0;
+
+    switch (((sim->select & 0xF0) | addr) & 0xFF)
+    {
+        case AP_CSW:    return sim->csw | AP_CSW_DEVICEEN;
+        case AP_TAR:    return sim->tar;
+        case AP_DRW:    value = sim_bus_read(sim->tar); sim_tar_increment(); return value;
+        case AP_IDR:    return SOFT_SWD_SIM_AP_IDR;
+        default:        return 0;
+    }
+}
+
+static void sim_ap_write(uint32_t addr, uint32_t value)
+{
+    if ((sim->select >> 24) != MEM_AP_APSEL) return;
+
+    switch (((sim->select & 0xF0) | addr) & 0xFF)
+    {
+        case AP_CSW:    sim->csw = value;  break;
+        case AP_TAR:    sim->tar = value;  break;
+        case AP_DRW:    sim_bus_write(sim->tar, value); sim_tar_increment(); break;
+    }
+}
+
+/** Запрос к AP: WAIT, пока шина занята прошлым обращением; FAULT при sticky-ошибках; чтение - отложенное */
+static uint8_t sim_ap_request(uint32_t RnW, uint32_t addr, uint32_t* data)
+{
+    sim->ap_count++;
+
+    if (soft_swd_sim.errors.wait_every && (sim->ap_count % soft_swd_sim.errors.wait_every) == 0) return SWD_ACK_WAIT;
+    if (sim->ctrl_stat & SIM_STICKY) return SWD_ACK_FAIL;
+    if (soft_swd_sim.errors.fault_every && (sim->ap_count % soft_swd_sim.errors.fault_every) == 0)
+    {
+        sim->ctrl_stat |= DP_CTRL_STAT_STICKYERR;
+        return SWD_ACK_FAIL;
+    }
+    if (soft_swd_sim.time < sim->ap_busy_until) return SWD_ACK_WAIT;
+
+    if (RnW)
+    {
+        *data = sim->rdbuff;
+        sim->rdbuff = sim_ap_read(addr);
+    }
+    return SWD_ACK_OK;
+}
+
+static uint8_t sim_dp_request(uint32_t RnW, uint32_t addr, uint32_t* data)
+{
+    if (!RnW) return SWD_ACK_OK;
+
+    switch (addr)
+    {
+        case DP_IDCODE:
+            *data = SOFT_SWD_SIM_IDCODE;
+            break;
+        case DP_CTRL_STAT:
+            *data = sim->ctrl_stat | ((sim->ctrl_stat & (DP_CTRL_STAT_CSYSPWRUPREQ | DP_CTRL_STAT_CDBGPWRUPREQ)) << 1);
+            break;
+        case DP_RESEND:
+            *data = sim->rdbuff;
+            break;
+        case DP_RDBUFF:
+            if (soft_swd_sim.time < sim->ap_busy_until) return SWD_ACK_WAIT;
+            *data = sim->rdbuff;
+            break;
+    }
+    return SWD_ACK_OK;
+}
+
+static void sim_dp_write(uint32_t addr, uint32_t value)
+{
+    switch (addr)
+    {
+        case DP_ABORT:
+            if (value & DP_ABORT_STKERRCLR)  sim->ctrl_stat &= ~DP_CTRL_STAT_STICKYERR;
+            if (value & DP_ABORT_WDERRCLR)   sim->ctrl_stat &= ~DP_CTRL_STAT_WDATAERR;
+            if (value & DP_ABORT_ORUNERRCLR) sim->ctrl_stat &= ~DP_CTRL_STAT_STICKYORUN;
+            if (value & DP_ABORT_STKCMPCLR)  sim->ctrl_stat &= ~DP_CTRL_STAT_STICKYCMP;
+            if (value & DP_ABORT_DAPABORT)   sim->ap_busy_until = soft_swd_sim.time;
+            break;
+        case DP_CTRL_STAT:
+            sim->ctrl_stat = (sim->ctrl_stat & (SIM_STICKY | DP_CTRL_STAT_STICKYCMP)) |
+                            (value & (DP_CTRL_STAT_CSYSPWRUPREQ | DP_CTRL_STAT_CDBGPWRUPREQ | DP_CTRL_STAT_ORUNDETECT));
+            break;
+        case DP_SELECT:
+            sim->select = value;
+            break;
+    }
+}
+/**********************************************************************************************************************/
+
+
+/************************************************************************************************** Протокол по битам */
+
+/** Разбор 8 бит запроса: ответ (ACK и данные чтения) выдается после turnaround */
+static void sim_request(void)
+{
+    uint32_t r = sim->request;
+    uint32_t APnDP = (r >> 1) & 0x1;
+    uint32_t RnW = (r >> 2) & 0x1;
+    uint32_t addr = ((r >> 3) & 0x3) << 2;
+
+    if (((r >> 6) & 0x1) || !((r >> 7) & 0x1) || (sim_parity(r & 0x1E) != ((r >> 5) & 0x1)))
+    {
+        soft_swd_sim.stats.protocol++;
+        sim->state = SIM_LOCKOUT;
+        return;
+    }
+
+    soft_swd_sim.stats.transactions++;
+    uint32_t data = 0;
+    uint8_t ack = APnDP ? sim_ap_request(RnW, addr, &data) : sim_dp_request(RnW, addr, &data);
+
+    sim->state = SIM_TURN;
+    sim->out = ack;
+    sim->out_bits = 3;
+    sim->write_pending = 0;
+
+    if (ack == SWD_ACK_WAIT) soft_swd_sim.stats.waits++;
+    if (ack == SWD_ACK_FAIL) soft_swd_sim.stats.faults++;
+    if (ack != SWD_ACK_OK) return;
+
+    if (RnW)
+    {
+        uint32_t parity = sim_parity(data);
+        sim->read_count++;
+        if (soft_swd_sim.errors.parity_every && (sim->read_count % soft_swd_sim.errors.parity_every) == 0)
+        {
+            parity ^= 0x1;
+            soft_swd_sim.stats.parity++;
+        }
+        sim->out |= ((uint64_t)data << 3) | ((uint64_t)parity << 35);
+        sim->out_bits = 36;
+    }
+    else
+    {
+        sim->write_pending = 1;
+        sim->write_AP = APnDP;
+        sim->write_addr = addr;
+    }
+}
+
+/** Следующий бит ответа таргета на SWDIO (после последнего - линия отпускается) */
+static void sim_present(void)
+{
+    if (sim->out_bits)
+    {
+        sim->target_drive = 1;
+        sim->target_level = (uint32_t)(sim->out & 0x1);
+        sim->out >>= 1;
+        sim->out_bits--;
+    }
+    else
+    {
+        sim->target_drive = 0;
+        sim->state = SIM_TURN_BACK;
+    }
+}
+
+/** Фронт SWCLK: таргет принимает бит линии и выдает следующий бит ответа */
+static void sim_rising_edge(void)
+{
+    uint32_t bit = SoftSWD_Sim_Read();
+    uint32_t after_reset = (sim->ones >= SIM_LINE_RESET_BITS);
+
+    if (sim->host_output && sim->target_drive) soft_swd_sim.stats.contention++;
+    sim->ones = (bit && sim->host_output) ? sim->ones + 1 : 0;
+
+    // До переключения JTAG -> SWD таргет ждет 16 бит SOFT_SWD_JTAG_TO_SWD сразу после сброса линии
+    if (sim->state == SIM_JTAG)
+    {
+        if (after_reset && !bit)
+        {
+            sim->shift = 0;
+            sim->collect = 0;
+        }
+        if (sim->collect < 16)
+        {
+            sim->shift |= bit << sim->collect;
+            if (++sim->collect == 16 && sim->shift == SOFT_SWD_JTAG_TO_SWD) sim->state = SIM_LOCKOUT;
+        }
+        return;
+    }
+
+    if (sim->ones >= SIM_LINE_RESET_BITS)
+    {
+        sim->state = SIM_RESET;
+        sim->target_drive = 0;
+        return;
+    }
+
+    switch (sim->state)
+    {
+        case SIM_RESET:
+            if (!bit) sim->state = SIM_IDLE;
+            break;
+
+        case SIM_IDLE:
+            if (bit)
+            {
+                sim->state = SIM_REQUEST;
+                sim->request = 0x1;
+                sim->bits = 1;
+            }
+            break;
+
+        case SIM_REQUEST:
+            sim->request |= bit << sim->bits;
+            if (++sim->bits == 8) sim_request();
+            break;
+
+        case SIM_TURN:
+            sim->state = SIM_DRIVE;
+            sim_present();
+            break;
+
+        case SIM_DRIVE:
+            sim_present();
+            break;
+
+        case SIM_TURN_BACK:
+            sim->state = sim->write_pending ? SIM_WRITE : SIM_IDLE;
+            sim->bits = 0;
+            sim->wdata = 0;
+            break;
+
+        case SIM_WRITE:
+            if (sim->bits < 32)
+            {
+                sim->wdata |= bit << sim->bits;
+                sim->bits++;
+                break;
+            }
+            // Бит четности: при ошибке запись отбрасывается, WDATAERR - FAULT до DP_ABORT
+            sim->state = SIM_IDLE;
+            if (sim_parity(sim->wdata) != bit)
+            {
+                soft_swd_sim.stats.wdata++;
+                sim->ctrl_stat |= DP_CTRL_STAT_WDATAERR;
+            }
+            else if (sim->write_AP) sim_ap_write(sim->write_addr, sim->wdata);
+            else sim_dp_write(sim->write_addr, sim->wdata);
+            break;
+
+        default:
+            break;
+    }
+}
+/**********************************************************************************************************************/
+
+
+/************************************************************************************************** Пины и время */
+
+void SoftSWD_Sim_Data(uint32_t level)
+{
+    sim->host_level = level;
+}
+
+uint32_t SoftSWD_Sim_Read(void)
+{
+    if (sim->host_output) return sim->host_level;
+    return sim->target_drive ? sim->target_level : 1;     // подтяжка SWDIO к питанию
+}
+
+/** Уровень SWCLK текущего таргета (время ведет вызывающий) */
+static void sim_clock_edge(uint32_t level)
+{
+    if (level == sim->clk) return;
+    sim->clk = level;
+    if (level) sim_rising_edge();
+}
+
+void SoftSWD_Sim_Clock(uint32_t level)
+{
+    if (level == sim->clk) return;
+
+    if (level) soft_swd_sim.time += soft_swd_sim.bit_cycles / 2;
+    else soft_swd_sim.time += soft_swd_sim.bit_cycles - soft_swd_sim.bit_cycles / 2;
+    sim_clock_edge(level);
+}
+
+void SoftSWD_Sim_Direction(uint32_t output)
+{
+    sim->host_output = output;
+}
+
+/** Сброс по nRST: ядро запускает свою прошивку, контроллер Flash заблокирован (SW-DP не сбрасывается) */
+void SoftSWD_Sim_Reset(uint32_t level)
+{
+    if (level) return;
+
+    sim->halt_at = SIM_FOREVER;
+    sim->dhcsr &= ~CoreDebug_DHCSR_C_HALT_Msk;
+    sim->busy_size = 0;
+    sim->flash_ctrl = FLASH_CTRL_LOCK;
+    sim->flash_sts = 0;
+    sim->key_step = 0;
+    sim->flash_busy_until = soft_swd_sim.time;
+    sim->ap_busy_until = soft_swd_sim.time;
+}
+
+void SoftSWD_Sim_Select(uint32_t target)
+{
+    if (target < SOFT_SWD_SIM_TARGETS) sim = &sim_targets[target];
+}
+
+/** Пины SWDIO gang: бит t маски - линия таргета t, таргеты из soft_swd_sim.absent не подключены */
+void SoftSWD_Sim_Gang_Data(uint32_t levels)
+{
+    for (uint32_t t = 0; t < SOFT_SWD_SIM_TARGETS; t++) sim_targets[t].host_level = (levels >> t) & 0x1;
+}
+
+uint32_t SoftSWD_Sim_Gang_Read(void)
+{
+    SimTarget_t* current = sim;
+    uint32_t levels = 0;
+
+    for (uint32_t t = 0; t < SOFT_SWD_SIM_TARGETS; t++)
+    {
+        sim = &sim_targets[t];
+        uint32_t level = (soft_swd_sim.absent & (0x1u << t)) ? (sim->host_output ? sim->host_level : 1) : SoftSWD_Sim_Read();
+        levels |= level << t;
+    }
+    sim = current;
+    return levels;
+}
+
+/** Общий SWCLK: время идет один раз, фронт получают все подключенные таргеты */
+void SoftSWD_Sim_Gang_Clock(uint32_t level)
+{
+    SimTarget_t* current = sim;
+    if (level == sim_gang_clk) return;
+    sim_gang_clk = level;
+
+    if (level) soft_swd_sim.time += soft_swd_sim.bit_cycles / 2;
+    else soft_swd_sim.time += soft_swd_sim.bit_cycles - soft_swd_sim.bit_cycles / 2;
+
+    for (uint32_t t = 0; t < SOFT_SWD_SIM_TARGETS; t++)
+    {
+        if (soft_swd_sim.absent & (0x1u << t)) continue;
+        sim = &sim_targets[t];
+        sim_clock_edge(level);
+    }
+    sim = current;
+}
+
+void SoftSWD_Sim_Gang_Direction(uint32_t outputs)
+{
+    for (uint32_t t = 0; t < SOFT_SWD_SIM_TARGETS; t++) sim_targets[t].host_output = (outputs >> t) & 0x1;
+}
+
+void SoftSWD_Sim_Gang_Reset(uint32_t level)
+{
+    SimTarget_t* current = sim;
+    for (uint32_t t = 0; t < SOFT_SWD_SIM_TARGETS; t++)
+    {
+        sim = &sim_targets[t];
+        SoftSWD_Sim_Reset(level);
+    }
+    sim = current;
+}
+
+/** USART выгрузки: DMA начинает передачу после предыдущей, байты сразу попадают в uart_capture */
+void SoftSWD_Sim_Uart_Transmit(uint8_t* data, uint32_t size)
+{
+    uint64_t start = (soft_swd_sim.time > soft_swd_sim.uart_busy_until) ? soft_swd_sim.time : soft_swd_sim.uart_busy_until;
+    soft_swd_sim.uart_busy_until = start + (uint64_t)size * soft_swd_sim.uart_byte_cycles;
+
+    uint32_t room = soft_swd_sim.uart_capture_size - soft_swd_sim.uart_captured;
+    if (soft_swd_sim.uart_capture == NULL) return;
+    memcpy(soft_swd_sim.uart_capture + soft_swd_sim.uart_captured, data, (size < room) ? size : room);
+    soft_swd_sim.uart_captured += (size < room) ? size : room;
+}
+
+void SoftSWD_Sim_Uart_Wait(void)
+{
+    if (soft_swd_sim.time < soft_swd_sim.uart_busy_until) soft_swd_sim.time = soft_swd_sim.uart_busy_until;
+}
+
+void SoftSWD_Sim_Init(void)
+{
+    for (uint32_t t = 0; t < SOFT_SWD_SIM_TARGETS; t++)
+    {
+        sim = &sim_targets[t];
+        memset(sim, 0, sizeof(*sim));
+        memset(sim->flash, 0xFF, sizeof(sim->flash));
+        sim->host_output = 1;
+        sim->collect = 16;
+        sim->csw = MEM_AP_DEFAULT;
+        sim->halt_at = SIM_FOREVER;
+        sim->flash_ctrl = FLASH_CTRL_LOCK;
+
+        // Сдвиг счетчиков внесения ошибок: в режиме gang таргеты отвечают WAIT/FAULT в разных транзакциях
+        sim->ap_count = t;
+        sim->read_count = t;
+    }
+    sim = &sim_targets[0];
+    sim_gang_clk = 0;
+
+    memset(&soft_swd_sim, 0, sizeof(soft_swd_sim));
+    soft_swd_sim.bit_cycles = SOFT_SWD_SIM_BIT_CYCLES;
+    soft_swd_sim.word_cycles = SOFT_SWD_SIM_WORD_US * (SystemCoreClock / 1000000);
+    soft_swd_sim.page_cycles = SOFT_SWD_SIM_PAGE_US * (SystemCoreClock / 1000000);
+    soft_swd_sim.mass_cycles = SOFT_SWD_SIM_MASS_US * (SystemCoreClock / 1000000);
+    soft_swd_sim.run = SoftSWD_Sim_Run_Loader;
+    soft_swd_sim.uart_byte_cycles = (uint32_t)(((uint64_t)SystemCoreClock * 10) / SOFT_SWD_DUMP_BAUDRATE);   // 10 бит на байт
+}
+
+/** Заглушки systick.c: время - модельное */
+void delay_ms(uint32_t ms)          { soft_swd_sim.time += (uint64_t)ms * (SystemCoreClock / 1000); }
+void delay_ticks(uint32_t ticks)    { soft_swd_sim.time += ticks; }
+void DWT_Init(void)                 { }
+uint32_t DWT_Get_Cycles(void)       { return (uint32_t)soft_swd_sim.time; }
+/**********************************************************************************************************************/
+
+
+/********************************************************************************************* Исполнение загрузчика */
+
+/** Загрузчик CRC (mov.w r4, #0xFFFFFFFF; ...): r0 - Flash, r1 - слов в странице, r2 - страниц, r3 - результаты.
+*   Таблица по r7 не читается - CRC считается crc32.c */
+static uint32_t sim_run_crc(uint32_t* regs)
+{
+    uint32_t page_size = regs[CORE_REG_R1] * 4;
+    uint32_t pages = regs[CORE_REG_R2];
+
+    for (uint32_t p = 0; p < pages; p++)
+    {
+        uint8_t* page = SoftSWD_Sim_Memory(regs[CORE_REG_R0] + p * page_size);
+        uint8_t* page_end = SoftSWD_Sim_Memory(regs[CORE_REG_R0] + (p + 1) * page_size - 1);
+        uint8_t* result = SoftSWD_Sim_Memory(regs[CORE_REG_R3] + p * 4);
+        if (!page || !page_end || !result) return SOFT_SWD_SIM_RUN_FOREVER;     // HardFault
+
+        uint32_t crc = CRC32(page, page_size);
+        memcpy(result, &crc, 4);
+    }
+
+    sim->busy_size = 0;
+    return pages * regs[CORE_REG_R1] * SIM_CRC_WORD_CYCLES + SIM_LOADER_LOOP_CYCLES;
+}
+
+/** Загрузчик узнается по первым командам (movs r4, #1; str r4, [r3, #0x10]) и исполняется по своему описанию
+*   в programmer_target_Flash.c: r0 - Flash, r1 - буфер, r2 - слов, r3 - FLASH_AC, r7 - почтовый ящик */
+uint32_t SoftSWD_Sim_Run_Loader(uint32_t* regs)
+{
+    static const uint8_t signature[4] = {0x01, 0x24, 0x1C, 0x61};
+    static const uint8_t signature_crc[4] = {0x4F, 0xF0, 0xFF, 0x34};
+    uint8_t* code = SoftSWD_Sim_Memory(regs[CORE_REG_PC] & ~0x1u);
+    uint8_t* mailbox = SoftSWD_Sim_Memory(regs[CORE_REG_R7]);
+    if (code && memcmp(code, signature_crc, sizeof(signature_crc)) == 0) return sim_run_crc(regs);
+    if (!code || !mailbox || memcmp(code, signature, sizeof(signature)) != 0) return SOFT_SWD_SIM_RUN_FOREVER;
+
+    uint64_t t = soft_swd_sim.time;
+    uint32_t flash = regs[CORE_REG_R0];
+    uint32_t buffer = regs[CORE_REG_R1];
+    uint32_t status;
+
+    sim_flash_reg_write(regs[CORE_REG_R3] + 0x10, FLASH_CTRL_PG);
+    for (uint32_t i = 0; i < regs[CORE_REG_R2]; i++)
+    {
+        uint32_t value;
+        uint8_t* source = SoftSWD_Sim_Memory(buffer + i * 4);
+        if (!source || !SoftSWD_Sim_Memory(flash + i * 4)) break;
+        memcpy(&value, source, 4);
+
+        t = ((t > sim->flash_busy_until) ? t : sim->flash_busy_until) + SIM_LOADER_LOOP_CYCLES;
+        sim_flash_program(flash + i * 4, value, t);
+        if (sim->flash_sts & (FLASH_STS_PGERR | FLASH_STS_PVERR | FLASH_STS_WRPERR)) break;
+    }
+    if (t < sim->flash_busy_until) t = sim->flash_busy_until;
+    sim_flash_reg_write(regs[CORE_REG_R3] + 0x10, 0);
+
+    status = sim->flash_sts & (FLASH_STS_PGERR | FLASH_STS_PVERR | FLASH_STS_WRPERR);
+    memcpy(mailbox, &status, 4);
+
+    sim->busy_buffer = buffer;
+    sim->busy_size = regs[CORE_REG_R2] * 4;
+    return (uint32_t)(t - soft_swd_sim.time) + SIM_LOADER_LOOP_CYCLES;
+}
+/**********************************************************************************************************************/
+
+
+/******************************************************************************************************** Замеры */
+
+#define SIM_BENCH_ADDRESS       (FLASH_ADDRESS_START)
+#define SIM_BENCH_SIZE          (16 * 1024 + 3)     // Не кратен странице и слову
+
+static uint32_t sim_failures;
+
+static void sim_check(int ok, const char* what)
+{
+    if (ok) return;
+    sim_failures++;
+    printf("FAIL: %s\n", what);
+}
+
+static void sim_report(const char* name, uint32_t bytes, uint64_t cycles)
+{
+    double ms = (double)cycles * 1000.0 / SystemCoreClock;
+    printf("  %-26s %6u B %9.1f ms %8.1f KB/s\n", name, (unsigned)bytes, ms, ms > 0 ? bytes / 1.024 / ms : 0.0);
+}
+
+/** Стирание, запись одним из способов, сверка с памятью модели */
+static void sim_bench_flash(const char* name, uint32_t method, uint8_t* image, uint32_t size)
+{
+    uint32_t errors = 0;
+    Erase_Flash_size(SIM_BENCH_ADDRESS, size);
+
+    uint64_t start = soft_swd_sim.time;
+    if (method == 0) Program_Flash(SIM_BENCH_ADDRESS, image, size);
+    if (method == 1) errors = Program_Flash_Block(SIM_BENCH_ADDRESS, image, size);
+    if (method == 2) errors = Program_Flash_Loader(SIM_BENCH_ADDRESS, image, size);
+    sim_report(name, size, soft_swd_sim.time - start);
+
+    sim_check(errors == 0, name);
+    sim_check(memcmp(SoftSWD_Sim_Memory(SIM_BENCH_ADDRESS), image, size) == 0, name);
+}
+
+/** Разбор кадров выгрузки, как soft_swd_dump.py: проверка magic, CRC и порядка кадров, данные - в image с адреса
+*   SIM_BENCH_ADDRESS. Возвращает байт данных в целых кадрах, flags последнего кадра - в last */
+static uint32_t sim_parse_dump(uint8_t* stream, uint32_t size, uint8_t* image, uint32_t image_size, uint32_t* last)
+{
+    uint32_t received = 0;
+    uint32_t offset = 0;
+    uint16_t seq = 0;
+    SoftSWD_Dump_Header_t header;
+
+    while (offset + sizeof(header) <= size)
+    {
+        memcpy(&header, stream + offset, sizeof(header));
+        if (header.magic != SOFT_SWD_DUMP_MAGIC || offset + sizeof(header) + header.length > size) break;
+
+        uint32_t crc = CRC32_Update(CRC32_INIT, stream + offset, sizeof(header) - 4);
+        crc = CRC32_Update(crc, stream + offset + sizeof(header), header.length) ^ CRC32_INIT;
+        sim_check(crc == header.crc && header.seq == seq, "dump frame");
+
+        uint32_t position = header.address - SIM_BENCH_ADDRESS;
+        if (image != NULL && position + header.length <= image_size)
+        {
+            memcpy(image + position, stream + offset + sizeof(header), header.length);
+        }
+        received += header.length;
+        *last = header.flags;
+        offset += sizeof(header) + header.length;
+        seq++;
+    }
+    sim_check(offset == size, "dump stream");
+    return received;
+}
+
+uint32_t SoftSWD_Sim_Benchmark(const char* dump_file)
+{
+    static uint8_t image[SIM_BENCH_SIZE];
+    static uint8_t buffer[SIM_BENCH_SIZE];
+    SoftSWD_Read_Benchmark_t read;
+    uint32_t seed = 0x12345678;
+
+    sim_failures = 0;
+    for (uint32_t i = 0; i < SIM_BENCH_SIZE; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        image[i] = (uint8_t)(seed >> 16);
+    }
+
+    // 1. Подключение
+    SoftSWD_Sim_Init();
+    SoftSWD_Init();
+    sim_check(Connect_Target_GetIDCODE() == SOFT_SWD_SIM_IDCODE, "IDCODE");
+
+#if SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_PHY
+    // Смена частоты после подключения - выбор из таблицы калибровки, без сброса линии: DP отвечает без IDCODE
+    uint32_t ctrl_stat = 0;
+    uint32_t line_transactions = soft_swd_sim.stats.transactions;
+    sim_check(SoftSWD_Phy_Set_Clock(SOFT_SWD_CLOCK_4MHZ) && soft_swd_phy.clock == SOFT_SWD_CLOCK_4MHZ &&
+              soft_swd_phy.half_period == soft_swd_phy_clocks[2].half_period, "PHY clock switch");
+    sim_check(soft_swd_sim.stats.transactions == line_transactions && SoftSWD_Read(DP, DP_CTRL_STAT, &ctrl_stat) == SOFT_SWD_OK,
+              "PHY clock switch keeps DP session");
+    sim_check(!SoftSWD_Phy_Set_Clock((SoftSWD_Clock_t)3000000), "PHY clock not in table");
+    SoftSWD_Phy_Set_Clock(SOFT_SWD_PHY_CLOCK);
+#endif
+
+    // 2. Запись Flash тремя способами (SWCLK - bit_cycles, время стирания не входит)
+    printf("Flash, SWCLK %u kHz:\n", (unsigned)(SystemCoreClock / soft_swd_sim.bit_cycles / 1000));
+    sim_bench_flash("Program_Flash", 0, image, SIM_BENCH_SIZE);
+    sim_bench_flash("Program_Flash_Block", 1, image, SIM_BENCH_SIZE);
+    sim_bench_flash("Program_Flash_Loader", 2, image, SIM_BENCH_SIZE);
+    sim_check(soft_swd_sim.stats.loader_conflicts == 0, "loader buffer conflicts");
+
+    // 3. Запись поверх записанного - PGERR
+    image[0] ^= 0xFF;
+    sim_check(Program_Flash_Block(SIM_BENCH_ADDRESS, image, 4) & FLASH_STS_PGERR, "PGERR on programmed flash");
+    image[0] ^= 0xFF;
+
+    // 4. Чтение
+    memset(buffer, 0, sizeof(buffer));
+    SoftSWD_Benchmark_Read(SIM_BENCH_ADDRESS, buffer, SIM_BENCH_SIZE, &read);
+    printf("Read %u B: SoftSWD_ReadMemory %u KB/s, SoftSWD_ReadMemory_Stream %u KB/s\n",
+           (unsigned)read.size, (unsigned)read.legacy_kbps, (unsigned)read.stream_kbps);
+    sim_check(memcmp(buffer, image, read.size) == 0, "stream read data");
+
+    // 5. Потоковое чтение с ошибками: WAIT, FAULT, четность
+    soft_swd_sim.errors.wait_every = 7;
+    soft_swd_sim.errors.fault_every = 101;
+    soft_swd_sim.errors.parity_every = 53;
+    soft_swd_stream.waits = 0;
+    soft_swd_stream.faults = 0;
+    memset(buffer, 0, sizeof(buffer));
+    SoftSWD_Status_t status = SoftSWD_ReadMemory_Stream(SIM_BENCH_ADDRESS, buffer, SIM_BENCH_SIZE);
+    printf("Stream read with errors: %u KB/s, WAIT %u, restarts %u\n",
+           (unsigned)soft_swd_stream.kbps, (unsigned)soft_swd_stream.waits, (unsigned)soft_swd_stream.faults);
+    sim_check(status == SOFT_SWD_OK && memcmp(buffer, image, SIM_BENCH_SIZE) == 0, "stream read with errors");
+
+    // 6. Запись с WAIT от таргета
+    soft_swd_sim.errors.fault_every = 0;
+    soft_swd_sim.errors.parity_every = 0;
+    printf("Flash with WAIT every %u AP transactions:\n", (unsigned)soft_swd_sim.errors.wait_every);
+    sim_bench_flash("Program_Flash_Block", 1, image, SIM_BENCH_SIZE);
+    sim_bench_flash("Program_Flash_Loader", 2, image, SIM_BENCH_SIZE);
+
+    // Повторы WAIT исчерпаны (DAPABORT, слово не записано): запись и стирание прерываются с FLASH_ERROR_SWD
+    SoftSWD_Policy_t policy = soft_swd_policy;
+    Erase_Flash_size(SIM_BENCH_ADDRESS, SIM_BENCH_SIZE);
+    soft_swd_policy.wait_retries = 0;
+    sim_check(Program_Flash_Block(SIM_BENCH_ADDRESS, image, SIM_BENCH_SIZE) == FLASH_ERROR_SWD, "block WAIT exhausted");
+    sim_check(Program_Flash_Loader(SIM_BENCH_ADDRESS, image, SIM_BENCH_SIZE) & FLASH_ERROR_SWD, "loader WAIT exhausted");
+    sim_check(Erase_Flash_size(SIM_BENCH_ADDRESS, SIM_BENCH_SIZE) == FLASH_ERROR_SWD, "erase WAIT exhausted");
+    soft_swd_policy = policy;
+    soft_swd_sim.errors.wait_every = 0;
+
+    // Прерванный ключ разблокировки блокирует контроллер Flash до сброса: переподключение со сбросом таргета
+    sim_check(Connect_Target_GetIDCODE() == SOFT_SWD_SIM_IDCODE, "IDCODE after WAIT exhausted");
+    sim_check(Erase_Flash_size(SIM_BENCH_ADDRESS, SIM_BENCH_SIZE) == 0 &&
+              SoftSWD_Sim_Memory(SIM_BENCH_ADDRESS)[0] == 0xFF, "erase after WAIT exhausted");
+
+    // 7. Ядро не остановилось - таймаут загрузчика
+    soft_swd_sim.run = NULL;
+    Erase_Flash_size(SIM_BENCH_ADDRESS, FLASH_PAGE_SIZE);
+    sim_check(Program_Flash_Loader(SIM_BENCH_ADDRESS, image, FLASH_PAGE_SIZE) == LOADER_ERROR_TIMEOUT, "loader timeout");
+    soft_swd_sim.run = SoftSWD_Sim_Run_Loader;
+
+    // 8. Инкрементальная запись: изменен один байт в одной странице
+    uint64_t start = soft_swd_sim.time;
+    Erase_Flash_size(SIM_BENCH_ADDRESS, SIM_BENCH_SIZE);
+    Program_Flash_Block(SIM_BENCH_ADDRESS, image, SIM_BENCH_SIZE);
+    uint64_t full = soft_swd_sim.time - start;
+
+    image[3 * FLASH_PAGE_SIZE + 100] ^= 0x5A;
+    start = soft_swd_sim.time;
+    uint32_t errors = Program_Flash_Incremental(SIM_BENCH_ADDRESS, image, SIM_BENCH_SIZE);
+    printf("Incremental, %u of %u pages changed:\n", (unsigned)flash_incremental.changed, (unsigned)flash_incremental.pages);
+    sim_report("Erase + Flash_Block", SIM_BENCH_SIZE, full);
+    sim_report("Program_Flash_Incremental", SIM_BENCH_SIZE, soft_swd_sim.time - start);
+    sim_check(errors == 0 && flash_incremental.changed == 1 && flash_incremental.stub == 1, "incremental");
+    sim_check(memcmp(SoftSWD_Sim_Memory(SIM_BENCH_ADDRESS), image, SIM_BENCH_SIZE) == 0, "incremental data");
+
+    // Без загрузчика CRC - потоковое чтение страниц, изменений нет
+    soft_swd_sim.run = NULL;
+    errors = Program_Flash_Incremental(SIM_BENCH_ADDRESS, image, SIM_BENCH_SIZE);
+    sim_check(errors == 0 && flash_incremental.changed == 0 && flash_incremental.stub == 0, "incremental without stub");
+    soft_swd_sim.run = SoftSWD_Sim_Run_Loader;
+
+    // Пустой образ: ни загрузчика, ни записи, RAM таргета не тронута
+    uint8_t* sram = SoftSWD_Sim_Memory(LOADER_CODE_ADDRESS);
+    memset(sram, 0xA5, 4 * FLASH_PAGE_SIZE);
+    errors = Program_Flash_Incremental(SIM_BENCH_ADDRESS, image, 0);
+    uint32_t sram_intact = 1;
+    for (uint32_t i = 0; i < 4 * FLASH_PAGE_SIZE; i++) sram_intact &= (sram[i] == 0xA5);
+    sim_check(errors == 0 && flash_incremental.pages == 0 && flash_incremental.changed == 0 && sram_intact,
+              "incremental empty image");
+    sim_check(memcmp(SoftSWD_Sim_Memory(SIM_BENCH_ADDRESS), image, SIM_BENCH_SIZE) == 0, "incremental empty image data");
+
+    // Ядро работает и не останавливается: загрузчик CRC не пишется в RAM, Flash не стирается, FLASH_ERROR_SWD
+    soft_swd_sim.run = NULL;
+    Target_Run();
+    soft_swd_sim.errors.no_halt = 1;
+    errors = Program_Flash_Incremental(SIM_BENCH_ADDRESS, image, SIM_BENCH_SIZE);
+    sram_intact = 1;
+    for (uint32_t i = 0; i < 4 * FLASH_PAGE_SIZE; i++) sram_intact &= (sram[i] == 0xA5);
+    sim_check(errors == FLASH_ERROR_SWD && sram_intact, "incremental without halt");
+    sim_check(Erase_Flash_All() == FLASH_ERROR_SWD, "mass erase without halt");
+    soft_swd_sim.errors.no_halt = 0;
+    sim_check(Erase_Flash_All() == 0 && SoftSWD_Sim_Memory(SIM_BENCH_ADDRESS)[0] == 0xFF, "mass erase");
+    soft_swd_sim.run = SoftSWD_Sim_Run_Loader;
+
+    // 9. Протокол без нарушений
+    printf("Transactions %u, WAIT %u, FAULT %u, protocol %u, wdata %u, contention %u\n",
+           (unsigned)soft_swd_sim.stats.transactions, (unsigned)soft_swd_sim.stats.waits,
+           (unsigned)soft_swd_sim.stats.faults, (unsigned)soft_swd_sim.stats.protocol,
+           (unsigned)soft_swd_sim.stats.wdata, (unsigned)soft_swd_sim.stats.contention);
+    sim_check(soft_swd_sim.stats.contention == 0, "SWDIO contention");
+    sim_check(soft_swd_sim.stats.wdata == 0, "write data parity");
+
+    // Счетчики транзакционного слоя совпадают с ответами, которые выдал таргет
+    printf("Host stats: OK %u, WAIT %u, FAULT %u, parity %u, retries %u, recoveries %u, failures %u\n",
+           (unsigned)soft_swd_stats.ack_ok, (unsigned)soft_swd_stats.ack_wait, (unsigned)soft_swd_stats.ack_fault,
+           (unsigned)soft_swd_stats.parity, (unsigned)soft_swd_stats.retries, (unsigned)soft_swd_stats.recoveries,
+           (unsigned)soft_swd_stats.failures);
+    sim_check(soft_swd_stats.ack_wait == soft_swd_sim.stats.waits, "host WAIT count");
+    sim_check(soft_swd_stats.ack_fault == soft_swd_sim.stats.faults, "host FAULT count");
+    sim_check(soft_swd_stats.parity == soft_swd_sim.stats.parity, "host parity count");
+
+    // 10. Gang: 8 таргетов. Таргет 5 без платы, у таргета 2 после стирания не стерлось слово (PGERR), у таргета 7
+    //     после записи испорчен байт; сверка - с WAIT и ошибками четности в разных транзакциях у разных таргетов
+    SoftSWD_Sim_Init();
+    soft_swd_sim.absent = 0x1u << 5;
+    SoftSWD_Init();
+    Connect_Target_GetIDCODE();
+    start = soft_swd_sim.time;
+    Erase_Flash_size(SIM_BENCH_ADDRESS, SIM_BENCH_SIZE);
+    Program_Flash_Block(SIM_BENCH_ADDRESS, image, SIM_BENCH_SIZE);
+    uint64_t single = soft_swd_sim.time - start;
+
+    SoftSWD_Gang_Init(SOFT_SWD_GANG_ALL);
+    uint32_t connected = SoftSWD_Gang_Connect();
+    sim_check(connected == (SOFT_SWD_GANG_ALL & ~(0x1u << 5)), "gang connect");
+
+    start = soft_swd_sim.time;
+    Erase_Flash_Gang(SIM_BENCH_ADDRESS, SIM_BENCH_SIZE);
+    SoftSWD_Sim_Select(2);
+    SoftSWD_Sim_Memory(SIM_BENCH_ADDRESS + 0x1000)[0] = 0x00;
+    uint32_t programmed = Program_Flash_Gang(SIM_BENCH_ADDRESS, image, SIM_BENCH_SIZE);
+    uint64_t gang = soft_swd_sim.time - start;
+
+    SoftSWD_Sim_Select(7);
+    SoftSWD_Sim_Memory(SIM_BENCH_ADDRESS + 0x2345)[0] ^= 0x01;
+    soft_swd_sim.errors.wait_every = 7;
+    soft_swd_sim.errors.parity_every = 53;
+    uint32_t verified = Verify_Flash_Gang(SIM_BENCH_ADDRESS, image, SIM_BENCH_SIZE);
+    soft_swd_sim.errors.parity_every = 0;
+    soft_swd_sim.errors.wait_every = 0;
+
+    uint32_t boards = 0;
+    for (uint32_t t = 0; t < SOFT_SWD_GANG_TARGETS; t++) boards += (programmed >> t) & 0x1;
+    printf("Gang, %u of %u targets programmed, WAIT %u, DP_ABORT %u:\n", (unsigned)boards, (unsigned)SOFT_SWD_GANG_TARGETS,
+           (unsigned)soft_swd_gang.waits, (unsigned)soft_swd_gang.faults);
+    sim_report("Erase + Flash_Block x1", SIM_BENCH_SIZE, single);
+    sim_report("Erase + Program_Flash_Gang", SIM_BENCH_SIZE * boards, gang);
+
+    sim_check(programmed == (connected & ~(0x1u << 2)), "gang program");
+    sim_check(soft_swd_gang.errors[2] == FLASH_STS_PGERR, "gang PGERR target");
+    sim_check(soft_swd_gang.errors[5] == SOFT_SWD_GANG_ERROR_ACK, "gang absent target");
+    sim_check(verified == (programmed & ~(0x1u << 7)), "gang verify");
+    sim_check(soft_swd_gang.errors[7] == FLASH_ERROR_VERIFY, "gang verify target");
+    for (uint32_t t = 0; t < SOFT_SWD_GANG_TARGETS; t++)
+    {
+        if (!(verified & (0x1u << t))) continue;
+        SoftSWD_Sim_Select(t);
+        sim_check(memcmp(SoftSWD_Sim_Memory(SIM_BENCH_ADDRESS), image, SIM_BENCH_SIZE) == 0, "gang data");
+    }
+    SoftSWD_Sim_Select(0);
+    sim_check(soft_swd_sim.stats.contention == 0, "gang SWDIO contention");
+    sim_check(soft_swd_sim.stats.wdata == 0, "gang write data parity");
+
+    // 11. Выгрузка Flash по USART: чтение SWD и передача DMA идут параллельно; затем выгрузка за конец SRAM
+    static uint8_t capture[SIM_BENCH_SIZE + 64 * sizeof(SoftSWD_Dump_Header_t)];
+    soft_swd_sim.uart_capture = capture;
+    soft_swd_sim.uart_capture_size = sizeof(capture);
+    soft_swd_sim.uart_captured = 0;
+    soft_swd_sim.errors.wait_every = 7;
+    soft_swd_sim.errors.parity_every = 53;
+
+    SoftSWD_Status_t dumped = SoftSWD_Dump(SIM_BENCH_ADDRESS, SIM_BENCH_SIZE);
+    uint32_t uart_kbps = SystemCoreClock / soft_swd_sim.uart_byte_cycles / 1024;
+    printf("Dump %u B over USART %u baud (%u KB/s): %u frames, %u KB/s, waiting for DMA %.1f ms\n",
+           (unsigned)soft_swd_dump.bytes, (unsigned)SOFT_SWD_DUMP_BAUDRATE, (unsigned)uart_kbps,
+           (unsigned)soft_swd_dump.frames, (unsigned)soft_swd_dump.kbps,
+           (double)soft_swd_dump.stall_cycles * 1000.0 / SystemCoreClock);
+
+    uint32_t last = 0;
+    uint32_t received = sim_parse_dump(capture, soft_swd_sim.uart_captured, buffer, SIM_BENCH_SIZE, &last);
+    sim_check(dumped == SOFT_SWD_OK && received == SIM_BENCH_SIZE && memcmp(buffer, image, SIM_BENCH_SIZE) == 0, "dump");
+    sim_check(last == SOFT_SWD_DUMP_LAST, "dump last frame");
+    sim_check(soft_swd_dump.kbps > soft_swd_stream.kbps * uart_kbps / (soft_swd_stream.kbps + uart_kbps), "dump overlap");
+
+    if (dump_file != NULL)
+    {
+        FILE* file = fopen(dump_file, "wb");
+        if (file != NULL) fwrite(capture, 1, soft_swd_sim.uart_captured, file);
+        if (file != NULL) fclose(file);
+        sim_check(file != NULL, "dump file");
+    }
+
+    soft_swd_sim.errors.wait_every = 0;
+    soft_swd_sim.errors.parity_every = 0;
+    soft_swd_sim.uart_captured = 0;
+    uint32_t sram_end = SRAM_ADDRESS_START + SOFT_SWD_SIM_SRAM_SIZE;
+    dumped = SoftSWD_Dump(sram_end - 2 * SOFT_SWD_DUMP_CHUNK, 4 * SOFT_SWD_DUMP_CHUNK);
+    received = sim_parse_dump(capture, soft_swd_sim.uart_captured, NULL, 0, &last);
+    sim_check(dumped == SOFT_SWD_ERROR_FAULT && received == 2 * SOFT_SWD_DUMP_CHUNK, "dump bus error");
+    sim_check((last & 0xFF) == (SOFT_SWD_DUMP_ERROR | SOFT_SWD_DUMP_LAST) && (last >> 8) == SOFT_SWD_ERROR_FAULT,
+              "dump error frame");
+    soft_swd_sim.uart_capture = NULL;
+
+    printf("%s: %u failures\n", sim_failures ? "FAILED" : "OK", (unsigned)sim_failures);
+    return sim_failures;
+}
+
+#ifdef SOFT_SWD_SIM_MAIN
+int main(int argc, char** argv)
+{
+    return (int)SoftSWD_Sim_Benchmark((argc > 1) ? argv[1] : NULL);
+}
+#endif
+/**********************************************************************************************************************/
@@ -0,0 +1,146 @@
+/***********************************************************************************************************************
+*   Модель таргета SWD для сборки на ПК (SOFT_SWD_HOST_SIM)
+*       При SOFT_SWD_HOST_SIM макросы пинов из soft_SWD.h (SOFT_SWD_DATA_*, SOFT_SWD_CLK_*, SOFT_SWD_RESET_TARGET_*)
+*   вызывают функции этого модуля вместо записи в GPIO. По фронтам SWCLK модель побитно разбирает протокол, как
+*   настоящий SW-DP: сброс линии и переключение JTAG -> SWD, запрос с проверкой четности, turnaround, ACK, данные.
+*   За DP - MEM-AP с автоинкрементом TAR внутри блока 1 КБ и отложенным чтением (RDBUFF), за ним - память N32G45x:
+*   Flash с контроллером (ключи, PG/PER/MER, BUSY на время записи слова и стирания), SRAM, регистры отладки ядра.
+*   Пока контроллер Flash занят, обращение MEM-AP к Flash задерживает шину и следующая транзакция AP получает WAIT.
+*
+*       Время модельное: каждый такт SWCLK - bit_cycles тактов процессора программатора (частота SWCLK на
+*   железе), DWT_Get_Cycles и delay_ms работают от этого же счетчика. Поэтому скорости, которые считают
+*   SoftSWD_ReadMemory_Stream и SoftSWD_Benchmark_Read, на ПК показывают выигрыш от протокола, а не от скорости ПК.
+*
+*       Ошибки вносятся по счетчикам (воспроизводимо): каждая N-я транзакция AP получает WAIT или FAULT (ошибка шины,
+*   FAULT до сброса через DP_ABORT), каждое N-е чтение - неверный бит четности. Запуск ядра (DHCSR без C_HALT)
+*   исполняет функцию run: по умолчанию она узнает загрузчик Program_Flash_Loader и повторяет его действия
+*   с временем записи Flash, а загрузчик CRC страниц Program_Flash_Incremental - считает CRC-32 страниц.
+*
+*       Таргетов SOFT_SWD_SIM_TARGETS, у каждого своя память и свой SW-DP. Одиночный SWD (soft_SWD.h) подключен
+*   к таргету, выбранному SoftSWD_Sim_Select (после SoftSWD_Sim_Init - таргет 0), режим gang (soft_SWD_gang.h) -
+*   ко всем сразу: бит t масок SoftSWD_Sim_Gang_* - SWDIO таргета t, SWCLK общий.
+*
+*       Сборка на ПК (GPIO, SPI и CMSIS не нужны, транспорт DELAY или PHY):
+*   gcc -std=gnu99 -DSOFT_SWD_HOST_SIM -DSOFT_SWD_SIM_MAIN -I. -ISoft_SWD -Iperiphery crc32.c \
+*       Soft_SWD/soft_SWD_sim.c Soft_SWD/soft_SWD.c Soft_SWD/soft_SWD_phy.c Soft_SWD/programmer_target_Flash.c \
+*       Soft_SWD/soft_SWD_gang.c Soft_SWD/programmer_gang_Flash.c Soft_SWD/soft_SWD_dump.c
+*   С SOFT_SWD_SIM_MAIN добавляется main, который вызывает SoftSWD_Sim_Benchmark (код возврата - число ошибок);
+*   если задан аргумент - имя файла, туда пишутся кадры выгрузки памяти для проверки soft_swd_dump.py --file.
+*   Сборка и запуск для транспортов DELAY и PHY - make -C tests check (цели swd_sim_delay, swd_sim_phy).
+***********************************************************************************************************************/
+
+#ifndef __SOFT_SWD_SIM_H__
+#define __SOFT_SWD_SIM_H__
+
+#include <stdint.h>
+
+/** То, что на железе приходит из CMSIS (stm32f4xx.h, core_cm4.h) */
+#define __NOP()                         ((void)0)
+#define CoreDebug_BASE                  (0xE000EDF0UL)
+#define CoreDebug_DHCSR_S_HALT_Msk      (1UL << 17)
+#define CoreDebug_DHCSR_S_REGRDY_Msk    (1UL << 16)
+#define CoreDebug_DHCSR_C_MASKINTS_Msk  (1UL << 3)
+#define CoreDebug_DHCSR_C_HALT_Msk      (1UL << 1)
+#define CoreDebug_DHCSR_C_DEBUGEN_Msk   (1UL << 0)
+#define CoreDebug_DCRSR_REGWnR_Msk      (1UL << 16)
+
+extern uint32_t SystemCoreClock;
+
+/** Параметры модели по умолчанию */
+#define SOFT_SWD_SIM_IDCODE         (0x2BA01477u)   // SW-DP Cortex-M4
+#define SOFT_SWD_SIM_AP_IDR         (0x24770011u)   // AHB-AP
+#define SOFT_SWD_SIM_SRAM_SIZE      (0x24000u)      // 144 КБ
+#define SOFT_SWD_SIM_BIT_CYCLES     (84)            // 168 МГц / 2 МГц SWCLK
+#define SOFT_SWD_SIM_WORD_US        (20)            // Запись слова Flash
+#define SOFT_SWD_SIM_PAGE_US        (2500)          // Стирание страницы
+#define SOFT_SWD_SIM_MASS_US        (30000)         // Полное стирание
+#define SOFT_SWD_SIM_RUN_FOREVER    (0xFFFFFFFFu)   // Ответ run: ядро не остановится само
+#define SOFT_SWD_SIM_TARGETS        (8)             // Таргетов для режима gang
+
+/** Исполнение кода таргета после запуска ядра: regs - R0...R15, xPSR; возвращает время до остановки (такты
+*   процессора программатора) или SOFT_SWD_SIM_RUN_FOREVER. Память - через SoftSWD_Sim_Memory */
+typedef uint32_t (*SoftSWD_Sim_Run_t)(uint32_t* regs);
+
+typedef struct
+{
+    uint32_t wait_every;            // каждая N-я транзакция AP отвечает WAIT (0 - выкл.)
+    uint32_t fault_every;           // каждая N-я транзакция AP - ошибка шины, дальше FAULT до DP_ABORT (0 - выкл.)
+    uint32_t parity_every;          // каждое N-е чтение данных - с неверным битом четности (0 - выкл.)
+    uint32_t no_halt;               // 1 - работающее ядро не останавливается по C_HALT (Target_Halt - таймаут)
+}
+SoftSWD_Sim_Errors_t;
+
+typedef struct
+{
+    uint32_t transactions;          // принятых запросов
+    uint32_t waits;                 // ответов WAIT (занятая шина и внесенные)
+    uint32_t faults;                // ответов FAULT
+    uint32_t parity;                // внесенных ошибок четности чтения
+    uint32_t protocol;              // запросов с нарушенным форматом (таргет молчит до сброса линии)
+    uint32_t wdata;                 // принятых данных записи с неверной четностью
+    uint32_t contention;            // тактов, когда SWDIO одновременно вели мастер и таргет
+    uint32_t flash_words;           // записанных слов Flash
+    uint32_t flash_pages;           // стертых страниц
+    uint32_t flash_errors;          // ошибок записи Flash (PGERR)
+    uint32_t loader_runs;           // запусков ядра
+    uint32_t loader_conflicts;      // записей мастера в буфер, который ядро еще переписывает во Flash
+}
+SoftSWD_Sim_Stats_t;
+
+typedef struct
+{
+    uint64_t time;                  // модельное время, такты процессора программатора
+    uint32_t bit_cycles;            // длительность такта SWCLK
+    uint32_t word_cycles;           // запись слова Flash
+    uint32_t page_cycles;           // стирание страницы
+    uint32_t mass_cycles;           // полное стирание
+    SoftSWD_Sim_Errors_t errors;
+    SoftSWD_Sim_Stats_t stats;
+    SoftSWD_Sim_Run_t run;
+    uint32_t absent;                // маска таргетов gang без платы: SWDIO на подтяжке, SWCLK не доходит
+    uint32_t uart_byte_cycles;      // передача байта USART
+    uint64_t uart_busy_until;       // конец передачи DMA, запущенной SoftSWD_Sim_Uart_Transmit
+    uint8_t* uart_capture;          // байты, принятые ПК (NULL - не сохраняются)
+    uint32_t uart_capture_size;
+    uint32_t uart_captured;
+}
+SoftSWD_Sim_t;
+
+extern SoftSWD_Sim_t soft_swd_sim;
+
+/** Сброс модели: Flash стерта, SRAM обнулена, SW-DP в режиме JTAG, параметры и счетчики по умолчанию */
+void SoftSWD_Sim_Init(void);
+
+/** Пины SWD (вызываются макросами soft_SWD.h) */
+void SoftSWD_Sim_Data(uint32_t level);
+uint32_t SoftSWD_Sim_Read(void);
+void SoftSWD_Sim_Clock(uint32_t level);
+void SoftSWD_Sim_Direction(uint32_t output);
+void SoftSWD_Sim_Reset(uint32_t level);
+
+/** Выбор таргета для одиночного SWD и SoftSWD_Sim_Memory */
+void SoftSWD_Sim_Select(uint32_t target);
+
+/** Пины gang (вызываются макросами soft_SWD_gang.h): бит t - линия SWDIO таргета t */
+void SoftSWD_Sim_Gang_Data(uint32_t levels);
+uint32_t SoftSWD_Sim_Gang_Read(void);
+void SoftSWD_Sim_Gang_Clock(uint32_t level);
+void SoftSWD_Sim_Gang_Direction(uint32_t outputs);
+void SoftSWD_Sim_Gang_Reset(uint32_t level);
+
+/** USART с DMA для soft_SWD_dump.h: передача занимает uart_byte_cycles на байт модельного времени и идет
+*   параллельно с SWD, ожидание продвигает время до ее конца */
+void SoftSWD_Sim_Uart_Transmit(uint8_t* data, uint32_t size);
+void SoftSWD_Sim_Uart_Wait(void);
+
+/** Указатель на байт памяти выбранного таргета (Flash или SRAM), NULL вне памяти */
+uint8_t* SoftSWD_Sim_Memory(uint32_t address);
+
+/** Исполнение загрузчиков Program_Flash_Loader и CRC страниц Program_Flash_Incremental (run по умолчанию) */
+uint32_t SoftSWD_Sim_Run_Loader(uint32_t* regs);
+
+/** Чтение/запись Flash всеми способами и внесение ошибок: печатает скорости, возвращает число ошибок.
+*   dump_file - файл для кадров выгрузки памяти (NULL - не записывать) */
+uint32_t SoftSWD_Sim_Benchmark(const char* dump_file);
+
+#endif /* __SOFT_SWD_SIM_H__ */
@@ -0,0 +1,78 @@
+/***********************************************************************************************************************
+*   Транспорт программного SWD через SPI1 (см. soft_SWD_spi.h)
+***********************************************************************************************************************/
+
+#include "soft_SWD_spi.h"
+#include "spi.h"
+
+/** Режимы пинов SWCLK и SWDIO в MODER (оба пина на SOFT_SWD_DATA_PORT) */
+#define SPI_PINS_MASK       ((MODER_ANALOG << (SOFT_SWD_CLK_PIN * 2)) | (MODER_ANALOG << (SOFT_SWD_DATA_PIN * 2)))
+#define SPI_PINS_AF         ((MODER_AF << (SOFT_SWD_CLK_PIN * 2)) | (MODER_AF << (SOFT_SWD_DATA_PIN * 2)))
+#define SPI_PINS_OUTPUT     ((MODER_OUTPUT << (SOFT_SWD_CLK_PIN * 2)) | (MODER_OUTPUT << (SOFT_SWD_DATA_PIN * 2)))
+#define SPI_PINS_INPUT      (MODER_OUTPUT << (SOFT_SWD_CLK_PIN * 2))    // SWCLK - выход, SWDIO - вход
+
+static inline void spi_pins(uint32_t mode)
+{
+    SOFT_SWD_DATA_PORT->MODER = (SOFT_SWD_DATA_PORT->MODER & ~SPI_PINS_MASK) | mode;
+}
+
+/** Настройка */
+void SoftSWD_SPI_Init(void)
+{
+    // AF5 для SPI1 (режим пинов при этом сразу возвращается в GPIO, SWCLK в покое низкий - как CPOL = 0)
+    GPIO_Enable_SPI(SOFT_SWD_SPI, SOFT_SWD_CLK_PORT, SOFT_SWD_CLK_PIN);
+    GPIO_Enable_SPI(SOFT_SWD_SPI, SOFT_SWD_DATA_PORT, SOFT_SWD_DATA_PIN);
+    SOFT_SWD_CLK_LOW();
+    spi_pins(SPI_PINS_OUTPUT);
+
+    SPI_Init_Bidirectional(SOFT_SWD_SPI, SOFT_SWD_SPI_BAUD);
+}
+
+/** Передача байт */
+void SoftSWD_SPI_Write(uint32_t data, uint32_t bytes)
+{
+    SOFT_SWD_SPI->CR1 |= SPI_CR1_BIDIOE | SPI_CR1_SPE;     // в режиме передачи такты идут только при записи DR
+    spi_pins(SPI_PINS_AF);
+
+    while (bytes--)
+    {
+        while (!(SOFT_SWD_SPI->SR & SPI_SR_TXE));
+        SOFT_SWD_SPI->DR = data & 0xFF;
+        data >>= 8;
+    }
+    while (!(SOFT_SWD_SPI->SR & SPI_SR_TXE));
+    while (SOFT_SWD_SPI->SR & SPI_SR_BSY);
+
+    SOFT_SWD_SPI->CR1 &= ~SPI_CR1_SPE;
+    spi_pins(SPI_PINS_OUTPUT);
+}
+
+/** Прием 32 бит */
+uint32_t SoftSWD_SPI_Read32(void)
+{
+    uint32_t data = 0;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    (void)SOFT_SWD_SPI->DR;                                 // сброс RXNE от прошлого обмена
+    SOFT_SWD_SPI->CR1 &= ~SPI_CR1_BIDIOE;
+    spi_pins(SPI_PINS_AF);
+    SOFT_SWD_SPI->CR1 |= SPI_CR1_SPE;                       // такты пошли
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        while (!(SOFT_SWD_SPI->SR & SPI_SR_RXNE));
+        data |= (SOFT_SWD_SPI->DR & 0xFF) << (i * 8);
+    }
+
+    // Предпоследний байт принят: через такт SPI выключить модуль, он дотактирует последний байт и остановится
+    for (uint32_t i = SOFT_SWD_SPI_CLOCK_TICKS / 4; i; i--) __NOP();     // ~4 такта на итерацию
+    SOFT_SWD_SPI->CR1 &= ~SPI_CR1_SPE;
+
+    while (!(SOFT_SWD_SPI->SR & SPI_SR_RXNE));
+    data |= (SOFT_SWD_SPI->DR & 0xFF) << 24;
+
+    spi_pins(SPI_PINS_INPUT);
+    __set_PRIMASK(primask);
+    return data;
+}
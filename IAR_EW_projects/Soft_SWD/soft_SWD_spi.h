@@ -0,0 +1,31 @@
+/***********************************************************************************************************************
+*   Транспорт программного SWD через SPI1 (SOFT_SWD_TRANSPORT == SOFT_SWD_TRANSPORT_SPI)
+*       Запрос (8 бит) и данные (32 бита) SWD кратны байту, поэтому их сдвигает SPI1 в двунаправленном режиме:
+*   SCK (PA5) - SWCLK, MOSI (PA7) - SWDIO, Mode 0 (данные меняются по спаду, таргет читает по фронту), LSB first.
+*   ACK (3 бита), бит четности и turnaround не кратны байту - на время этих бит пины переключаются из режима
+*   альтернативной функции в GPIO и биты выдает soft_SWD_phy. Переключение - одна запись MODER.
+*
+*       Прием в двунаправленном режиме: мастер тактирует непрерывно, пока SPE = 1. Чтобы выдать ровно 32 такта,
+*   SPE сбрасывается через такт SPI после приема предпоследнего байта (порядок из Reference Manual, раздел SPI
+*   "Disabling the SPI"), на это время прерывания запрещены.
+***********************************************************************************************************************/
+
+#ifndef __SOFT_SWD_SPI_H__
+#define __SOFT_SWD_SPI_H__
+
+#include "soft_SWD.h"
+
+#define SOFT_SWD_SPI                SPI1
+#define SOFT_SWD_SPI_BAUD           (SPI_CR1_BR_1 | SPI_CR1_BR_0)   // APB2 84 МГц / 16 = 5,25 МГц
+#define SOFT_SWD_SPI_CLOCK_TICKS    (32)        // Такт SPI в тактах процессора (168 МГц / 5,25 МГц)
+
+/** Настройка SPI1 и пинов SWCLK/SWDIO (альтернативная функция AF5 назначается один раз, пины остаются в GPIO) */
+void SoftSWD_SPI_Init(void);
+
+/** Передача bytes (1 ... 4) младших байт data, младший бит первым; после передачи SWDIO - выход GPIO */
+void SoftSWD_SPI_Write(uint32_t data, uint32_t bytes);
+
+/** Прием 32 бит данных; после приема SWDIO - вход GPIO */
+uint32_t SoftSWD_SPI_Read32(void);
+
+#endif /* __SOFT_SWD_SPI_H__ */
@@ -0,0 +1,27 @@
+/***********************************************************************************************************************
+*   CRC-32 по таблице полубайт (см. crc32.h)
+***********************************************************************************************************************/
+
+#include "crc32.h"
+
+const uint32_t CRC32_Nibble_Table[16] =
+{
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+uint32_t CRC32_Update(uint32_t crc, const uint8_t* data, uint32_t size)
+{
+    while (size--)
+    {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ CRC32_Nibble_Table[crc & 0xF];
+        crc = (crc >> 4) ^ CRC32_Nibble_Table[crc & 0xF];
+    }
+    return crc;
+}
+
+uint32_t CRC32(const uint8_t* data, uint32_t size)
+{
+    return CRC32_Update(CRC32_INIT, data, size) ^ CRC32_INIT;
+}
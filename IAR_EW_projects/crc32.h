@@ -0,0 +1,31 @@
+/***********************************************************************************************************************
+*   CRC-32 (IEEE 802.3, как zlib.crc32 в Python): отраженный полином 0xEDB88320, начальное значение и финальный XOR
+*   0xFFFFFFFF. Таблица на 16 полубайт (64 байта) вместо 256 байт: два обращения к таблице на байт.
+*       Аппаратный блок CRC STM32F4 считает неотраженный CRC по словам и с zlib не совпадает, поэтому программно.
+*   Та же таблица загружается в RAM таргета для загрузчика, считающего CRC страниц Flash (programmer_target_Flash.c),
+*   так что CRC программатора и таргета совпадают.
+*
+*   Пример:
+*       uint32_t crc = CRC32(data, size);
+*       // по частям:
+*       uint32_t crc = CRC32_Update(CRC32_INIT, part1, size1);
+*       crc = CRC32_Update(crc, part2, size2) ^ CRC32_INIT;
+***********************************************************************************************************************/
+
+#ifndef __CRC32_H__
+#define __CRC32_H__
+
+#include <stdint.h>
+
+#define CRC32_INIT      (0xFFFFFFFFu)   // Начальное значение и финальный XOR
+
+/** Таблица CRC для 16 значений полубайта */
+extern const uint32_t CRC32_Nibble_Table[16];
+
+/** Продолжение расчета: без начального значения и финального XOR */
+uint32_t CRC32_Update(uint32_t crc, const uint8_t* data, uint32_t size);
+
+/** CRC-32 буфера целиком */
+uint32_t CRC32(const uint8_t* data, uint32_t size);
+
+#endif /* __CRC32_H__ */
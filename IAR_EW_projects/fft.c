@@ -0,0 +1,841 @@
+/***********************************************************************************************************************
+*   Быстрое преобразование Фурье (см. fft.h)
+***********************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "fft.h"
+#include "fft_tables.h"
+#include "systick.h"
+
+#define FFT_QUARTER         (FFT_MAX_SIZE / 4)
+#define FFT_BENCHMARK_REPEATS   4   // прогонов каждого БПФ при замере (время усредняется)
+
+#if FFT_TABLES_MAX_SIZE != FFT_MAX_SIZE
+#error "fft_tables.h не для FFT_MAX_SIZE: перегенерировать fft_tables_gen.py"
+#endif
+
+/************************************************************************************* Поворотные коэффициенты */
+
+/** Таблицы cos и инверсии бит - константы во Flash (fft_tables.h), расчет при старте не нужен */
+void FFT_Init(void)
+{
+}
+
+/** W = exp(-2*pi*i*a / FFT_MAX_SIZE) для a = 0 ... FFT_MAX_SIZE/2 - 1 (нижняя половина окружности)
+*   table - таблица четверти периода косинуса нужного формата */
+#define FFT_TWIDDLE(table, a, w_re, w_im)               \
+{                                                       \
+    if ((a) <= FFT_QUARTER)                             \
+    {                                                   \
+        w_re = table[(a)];                              \
+        w_im = -table[FFT_QUARTER - (a)];               \
+    }                                                   \
+    else                                                \
+    {                                                   \
+        w_re = -table[FFT_MAX_SIZE / 2 - (a)];          \
+        w_im = -table[(a) - FFT_QUARTER];               \
+    }                                                   \
+}
+/**********************************************************************************************************************/
+
+
+/** log2(n), если n - допустимый размер БПФ, иначе 0 */
+uint32_t FFT_Log2(uint32_t n)
+{
+    if (n < FFT_MIN_SIZE || n > FFT_MAX_SIZE || (n & (n - 1)) != 0) return 0;
+
+    uint32_t log2n = 0;
+    while ((1U << log2n) < n) log2n++;
+    return log2n;
+}
+
+/** Перестановка отсчетов в порядке инверсии бит индекса по таблице (на месте, каждая пара меняется один раз)
+*   channels > 1 - чередующиеся каналы пакетного БПФ: отсчет i - блок data[i * channels] ... из channels элементов.
+*   Функция на каждый тип отсчета: обмен через сам тип, без доступа к отсчетам через указатели на другие типы */
+#define FFT_BIT_REVERSE(name, type_t)                                       \
+static void name(type_t *data, uint32_t n, uint32_t channels)               \
+{                                                                           \
+    const uint32_t shift = FFT_MAX_LOG2 - FFT_Log2(n); /* log2(n) бит */    \
+                                                                            \
+    for (uint32_t i = 1; i < n - 1; i++)                                    \
+    {                                                                       \
+        uint32_t j = fft_bit_reverse_table[i] >> shift;                     \
+        if (i >= j) continue;                                               \
+                                                                            \
+        type_t *a = &data[i * channels];                                    \
+        type_t *b = &data[j * channels];                                    \
+        for (uint32_t c = 0; c < channels; c++)                             \
+        {                                                                   \
+            type_t temp = a[c]; a[c] = b[c]; b[c] = temp;                   \
+        }                                                                   \
+    }                                                                       \
+}
+
+FFT_BIT_REVERSE(fft_bit_reverse_f64, double complex)
+FFT_BIT_REVERSE(fft_bit_reverse_f32, float complex)
+FFT_BIT_REVERSE(fft_bit_reverse_q15, FFT_Q15_t)
+FFT_BIT_REVERSE(fft_bit_reverse_q31, FFT_Q31_t)
+
+/** Прямое БПФ на месте */
+FFT_Status_t FFT_Forward_F64(double complex *data, uint32_t n)
+{
+    if (FFT_Log2(n) == 0) return FFT_ERROR_SIZE;
+
+    fft_bit_reverse_f64(data, n, 1);
+
+    for (uint32_t len = 2; len <= n; len <<= 1)
+    {
+        uint32_t half = len >> 1;
+        uint32_t twiddle_step = FFT_MAX_SIZE / len;    // шаг по таблице для W_len^j
+
+        for (uint32_t j = 0; j < half; j++)
+        {
+            double w_re, w_im;
+            FFT_TWIDDLE(fft_cos_table, j * twiddle_step, w_re, w_im)
+
+            // Все бабочки этапа с одним и тем же коэффициентом
+            for (uint32_t i = j; i < n; i += len)
+            {
+                double complex *top = &data[i];
+                double complex *bottom = &data[i + half];
+
+                double b_re = creal(*bottom);
+                double b_im = cimag(*bottom);
+                double t_re = b_re * w_re - b_im * w_im;
+                double t_im = b_re * w_im + b_im * w_re;
+                double a_re = creal(*top);
+                double a_im = cimag(*top);
+
+                *top = (a_re + t_re) + (a_im + t_im) * I;
+                *bottom = (a_re - t_re) + (a_im - t_im) * I;
+            }
+        }
+    }
+    return FFT_OK;
+}
+
+/** Обратное БПФ на месте: conj(FFT(conj(X))) / n */
+FFT_Status_t FFT_Inverse_F64(double complex *data, uint32_t n)
+{
+    if (FFT_Log2(n) == 0) return FFT_ERROR_SIZE;
+
+    for (uint32_t i = 0; i < n; i++) data[i] = conj(data[i]);
+    FFT_Forward_F64(data, n);
+
+    double scale = 1.0 / (double)n;
+    for (uint32_t i = 0; i < n; i++) data[i] = conj(data[i]) * scale;
+
+    return FFT_OK;
+}
+
+
+/******************************************************************************************* Одинарная точность */
+
+/** Прямое БПФ на месте, одинарная точность */
+FFT_Status_t FFT_Forward_F32(float complex *data, uint32_t n)
+{
+    if (FFT_Log2(n) == 0) return FFT_ERROR_SIZE;
+
+    fft_bit_reverse_f32(data, n, 1);
+
+    for (uint32_t len = 2; len <= n; len <<= 1)
+    {
+        uint32_t half = len >> 1;
+        uint32_t twiddle_step = FFT_MAX_SIZE / len;
+
+        for (uint32_t j = 0; j < half; j++)
+        {
+            float w_re, w_im;
+            FFT_TWIDDLE(fft_cos_table_f32, j * twiddle_step, w_re, w_im)
+
+            for (uint32_t i = j; i < n; i += len)
+            {
+                float complex *top = &data[i];
+                float complex *bottom = &data[i + half];
+
+                float b_re = crealf(*bottom);
+                float b_im = cimagf(*bottom);
+                float t_re = b_re * w_re - b_im * w_im;
+                float t_im = b_re * w_im + b_im * w_re;
+                float a_re = crealf(*top);
+                float a_im = cimagf(*top);
+
+                *top = (a_re + t_re) + (a_im + t_im) * I;
+                *bottom = (a_re - t_re) + (a_im - t_im) * I;
+            }
+        }
+    }
+    return FFT_OK;
+}
+
+/** Обратное БПФ на месте, одинарная точность */
+FFT_Status_t FFT_Inverse_F32(float complex *data, uint32_t n)
+{
+    if (FFT_Log2(n) == 0) return FFT_ERROR_SIZE;
+
+    for (uint32_t i = 0; i < n; i++) data[i] = conjf(data[i]);
+    FFT_Forward_F32(data, n);
+
+    float scale = 1.0f / (float)n;
+    for (uint32_t i = 0; i < n; i++) data[i] = conjf(data[i]) * scale;
+
+    return FFT_OK;
+}
+/**********************************************************************************************************************/
+
+
+/**************************************************************************************** Вещественный сигнал */
+
+/** БПФ вещественного сигнала */
+FFT_Status_t FFT_Forward_Real_F32(const float *input, float complex *spectrum, uint32_t n)
+{
+    uint32_t half = n / 2;
+    if (n > FFT_MAX_SIZE || FFT_Log2(half) == 0) return FFT_ERROR_SIZE;
+
+    // z[m] = x[2m] + i*x[2m+1], Z = FFT(z) - смесь спектров четных (E) и нечетных (O) отсчетов
+    for (uint32_t m = 0; m < half; m++) spectrum[m] = input[2 * m] + input[2 * m + 1] * I;
+    FFT_Forward_F32(spectrum, half);
+
+    // X[0] и X[n/2] вещественные
+    float z0_re = crealf(spectrum[0]);
+    float z0_im = cimagf(spectrum[0]);
+    spectrum[0] = z0_re + z0_im;
+    spectrum[half] = z0_re - z0_im;
+
+    // E[k] = (Z[k] + conj(Z[n/2-k])) / 2,  O[k] = (Z[k] - conj(Z[n/2-k])) / 2i
+    // X[k] = E[k] + W^k * O[k],  X[n/2-k] = conj(E[k] - W^k * O[k]),  W = exp(-2*pi*i/n)
+    uint32_t twiddle_step = FFT_MAX_SIZE / n;
+    for (uint32_t k = 1; k <= half / 2; k++)
+    {
+        float complex a = spectrum[k];
+        float complex b = conjf(spectrum[half - k]);
+
+        float e_re = 0.5f * (crealf(a) + crealf(b));
+        float e_im = 0.5f * (cimagf(a) + cimagf(b));
+        float o_re = 0.5f * (cimagf(a) - cimagf(b));     // (a - b) / 2i
+        float o_im = -0.5f * (crealf(a) - crealf(b));
+
+        float w_re, w_im;
+        FFT_TWIDDLE(fft_cos_table_f32, k * twiddle_step, w_re, w_im)
+        float t_re = o_re * w_re - o_im * w_im;
+        float t_im = o_re * w_im + o_im * w_re;
+
+        spectrum[k] = (e_re + t_re) + (e_im + t_im) * I;
+        if (k != half - k) spectrum[half - k] = (e_re - t_re) - (e_im - t_im) * I;
+    }
+    return FFT_OK;
+}
+
+/** Обратное БПФ вещественного сигнала */
+FFT_Status_t FFT_Inverse_Real_F32(float complex *spectrum, float *output, uint32_t n)
+{
+    uint32_t half = n / 2;
+    if (n > FFT_MAX_SIZE || FFT_Log2(half) == 0) return FFT_ERROR_SIZE;
+
+    // Обратно к Z[k] = E[k] + i*O[k]:  E[k] = (X[k] + conj(X[n/2-k])) / 2,  O[k] = conj(W^k) * (X[k] - conj(X[n/2-k])) / 2
+    float x0 = crealf(spectrum[0]);
+    float xh = crealf(spectrum[half]);
+    spectrum[0] = 0.5f * (x0 + xh) + 0.5f * (x0 - xh) * I;
+
+    uint32_t twiddle_step = FFT_MAX_SIZE / n;
+    for (uint32_t k = 1; k <= half / 2; k++)
+    {
+        float complex a = spectrum[k];
+        float complex b = conjf(spectrum[half - k]);
+
+        float e_re = 0.5f * (crealf(a) + crealf(b));
+        float e_im = 0.5f * (cimagf(a) + cimagf(b));
+        float d_re = 0.5f * (crealf(a) - crealf(b));
+        float d_im = 0.5f * (cimagf(a) - cimagf(b));
+
+        float w_re, w_im;
+        FFT_TWIDDLE(fft_cos_table_f32, k * twiddle_step, w_re, w_im)
+        float o_re = d_re * w_re + d_im * w_im;         // d * conj(W)
+        float o_im = d_im * w_re - d_re * w_im;
+
+        // Z[k] = E + i*O,  Z[n/2-k] = conj(E) + i*conj(O)
+        spectrum[k] = (e_re - o_im) + (e_im + o_re) * I;
+        if (k != half - k) spectrum[half - k] = (e_re + o_im) + (o_re - e_im) * I;
+    }
+
+    FFT_Inverse_F32(spectrum, half);
+
+    for (uint32_t m = 0; m < half; m++)
+    {
+        output[2 * m] = crealf(spectrum[m]);
+        output[2 * m + 1] = cimagf(spectrum[m]);
+    }
+    return FFT_OK;
+}
+/**********************************************************************************************************************/
+
+
+/************************************************************************************************ Двумерное БПФ */
+
+/** Двумерное БПФ: сначала все строки, затем все столбцы (столбец копируется в column) */
+FFT_Status_t FFT_Forward_2D_F32(float complex *data, uint32_t width, uint32_t height, float complex *column)
+{
+    if (FFT_Log2(width) == 0 || FFT_Log2(height) == 0) return FFT_ERROR_SIZE;
+
+    for (uint32_t y = 0; y < height; y++) FFT_Forward_F32(&data[y * width], width);
+
+    for (uint32_t x = 0; x < width; x++)
+    {
+        for (uint32_t y = 0; y < height; y++) column[y] = data[y * width + x];
+        FFT_Forward_F32(column, height);
+        for (uint32_t y = 0; y < height; y++) data[y * width + x] = column[y];
+    }
+    return FFT_OK;
+}
+
+/** Обратное двумерное БПФ (с делением на width*height) */
+FFT_Status_t FFT_Inverse_2D_F32(float complex *data, uint32_t width, uint32_t height, float complex *column)
+{
+    if (FFT_Log2(width) == 0 || FFT_Log2(height) == 0) return FFT_ERROR_SIZE;
+
+    uint32_t n = width * height;
+    for (uint32_t i = 0; i < n; i++) data[i] = conjf(data[i]);
+    FFT_Forward_2D_F32(data, width, height, column);
+
+    float scale = 1.0f / (float)n;
+    for (uint32_t i = 0; i < n; i++) data[i] = conjf(data[i]) * scale;
+
+    return FFT_OK;
+}
+/**********************************************************************************************************************/
+
+
+/************************************************************************************ Фиксированная точка Q15/Q31 */
+
+/** Сдвиг перед этапом по оценке максимума модуля (OR модулей всех компонент, не меньше максимума)
+*   Бабочка увеличивает компоненту не более чем в 1 + sqrt(2) < 4 раза, поэтому после сдвига компоненты должны быть
+*   меньше 1/4 полной шкалы 2^(bits-1): peak < 2^(bits-3) - без сдвига, < 2^(bits-2) - сдвиг 1, иначе сдвиг 2 */
+static inline uint32_t fft_stage_shift(uint32_t peak, uint32_t bits)
+{
+    if (peak < (1U << (bits - 3))) return 0;
+    if (peak < (1U << (bits - 2))) return 1;
+    return 2;
+}
+
+/** Прямое БПФ на месте, Q15 */
+FFT_Status_t FFT_Forward_Q15(FFT_Q15_t *data, uint32_t n, int32_t *exponent)
+{
+    if (FFT_Log2(n) == 0) return FFT_ERROR_SIZE;
+
+    fft_bit_reverse_q15(data, n, 1);
+
+    uint32_t peak = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        peak |= (uint32_t)abs(data[i].re) | (uint32_t)abs(data[i].im);
+    }
+
+    int32_t total_shift = 0;
+
+    for (uint32_t len = 2; len <= n; len <<= 1)
+    {
+        uint32_t half = len >> 1;
+        uint32_t twiddle_step = FFT_MAX_SIZE / len;
+        uint32_t shift = fft_stage_shift(peak, 16);
+        int32_t round = shift ? (1 << (shift - 1)) : 0;
+
+        total_shift += shift;
+        peak = 0;
+
+        for (uint32_t j = 0; j < half; j++)
+        {
+            int32_t w_re, w_im;
+            FFT_TWIDDLE(fft_cos_table_q15, j * twiddle_step, w_re, w_im)
+
+            for (uint32_t i = j; i < n; i += len)
+            {
+                FFT_Q15_t *top = &data[i];
+                FFT_Q15_t *bottom = &data[i + half];
+
+                // |b * w| <= |b| * |w|, сумма произведений Q30 помещается в int32
+                int32_t t_re = ((int32_t)bottom->re * w_re - (int32_t)bottom->im * w_im + 0x4000) >> 15;
+                int32_t t_im = ((int32_t)bottom->re * w_im + (int32_t)bottom->im * w_re + 0x4000) >> 15;
+
+                int32_t top_re = (top->re + t_re + round) >> shift;
+                int32_t top_im = (top->im + t_im + round) >> shift;
+                int32_t bottom_re = (top->re - t_re + round) >> shift;
+                int32_t bottom_im = (top->im - t_im + round) >> shift;
+
+                top->re = (int16_t)top_re;
+                top->im = (int16_t)top_im;
+                bottom->re = (int16_t)bottom_re;
+                bottom->im = (int16_t)bottom_im;
+
+                peak |= (uint32_t)abs(top_re) | (uint32_t)abs(top_im) | (uint32_t)abs(bottom_re) | (uint32_t)abs(bottom_im);
+            }
+        }
+    }
+
+    *exponent = total_shift;
+    return FFT_OK;
+}
+
+/** Модуль Q31 без переполнения на -2^31 */
+static inline uint32_t fft_abs_q31(int32_t value)
+{
+    return (value < 0) ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+}
+
+/** Прямое БПФ на месте, Q31 */
+FFT_Status_t FFT_Forward_Q31(FFT_Q31_t *data, uint32_t n, int32_t *exponent)
+{
+    if (FFT_Log2(n) == 0) return FFT_ERROR_SIZE;
+
+    fft_bit_reverse_q31(data, n, 1);
+
+    uint32_t peak = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        peak |= fft_abs_q31(data[i].re) | fft_abs_q31(data[i].im);
+    }
+
+    int32_t total_shift = 0;
+
+    for (uint32_t len = 2; len <= n; len <<= 1)
+    {
+        uint32_t half = len >> 1;
+        uint32_t twiddle_step = FFT_MAX_SIZE / len;
+        uint32_t shift = fft_stage_shift(peak, 32);
+        int64_t round = shift ? (1 << (shift - 1)) : 0;
+
+        total_shift += shift;
+        peak = 0;
+
+        for (uint32_t j = 0; j < half; j++)
+        {
+            int64_t w_re, w_im;
+            FFT_TWIDDLE(fft_cos_table_q31, j * twiddle_step, w_re, w_im)
+
+            for (uint32_t i = j; i < n; i += len)
+            {
+                FFT_Q31_t *top = &data[i];
+                FFT_Q31_t *bottom = &data[i + half];
+
+                int64_t t_re = (bottom->re * w_re - bottom->im * w_im + (1LL << 30)) >> 31;
+                int64_t t_im = (bottom->re * w_im + bottom->im * w_re + (1LL << 30)) >> 31;
+
+                int32_t top_re = (int32_t)((top->re + t_re + round) >> shift);
+                int32_t top_im = (int32_t)((top->im + t_im + round) >> shift);
+                int32_t bottom_re = (int32_t)((top->re - t_re + round) >> shift);
+                int32_t bottom_im = (int32_t)((top->im - t_im + round) >> shift);
+
+                top->re = top_re;
+                top->im = top_im;
+                bottom->re = bottom_re;
+                bottom->im = bottom_im;
+
+                peak |= fft_abs_q31(top_re) | fft_abs_q31(top_im) | fft_abs_q31(bottom_re) | fft_abs_q31(bottom_im);
+            }
+        }
+    }
+
+    *exponent = total_shift;
+    return FFT_OK;
+}
+/**********************************************************************************************************************/
+
+
+/********************************************************************************************** Пакетное БПФ */
+
+#ifdef __ICCARM__
+#include <intrinsics.h>
+#define FFT_SMUSD(a, b)     ((int32_t)__SMUSD((a), (b)))        // a.lo*b.lo - a.hi*b.hi за 1 такт
+#define FFT_SMUADX(a, b)    ((int32_t)__SMUADX((a), (b)))       // a.lo*b.hi + a.hi*b.lo за 1 такт
+#else
+static inline int32_t FFT_SMUSD(uint32_t a, uint32_t b)
+{
+    return (int32_t)(int16_t)a * (int16_t)b - (int32_t)(int16_t)(a >> 16) * (int16_t)(b >> 16);
+}
+static inline int32_t FFT_SMUADX(uint32_t a, uint32_t b)
+{
+    return (int32_t)(int16_t)a * (int16_t)(b >> 16) + (int32_t)(int16_t)(a >> 16) * (int16_t)b;
+}
+#endif
+
+/** Пакетное прямое БПФ, одинарная точность */
+FFT_Status_t FFT_Forward_Batch_F32(float complex *data, uint32_t n, uint32_t channels, FFT_Layout_t layout)
+{
+    if (FFT_Log2(n) == 0 || channels == 0) return FFT_ERROR_SIZE;
+
+    // Шаг между отсчетами одного канала и между каналами одного отсчета
+    const uint32_t sample_stride = (layout == FFT_LAYOUT_INTERLEAVED) ? channels : 1;
+    const uint32_t channel_stride = (layout == FFT_LAYOUT_INTERLEAVED) ? 1 : n;
+
+    // Раздельные каналы - по каналу, чередующиеся - блоками по channels отсчетов
+    if (layout == FFT_LAYOUT_INTERLEAVED) fft_bit_reverse_f32(data, n, channels);
+    else for (uint32_t c = 0; c < channels; c++) fft_bit_reverse_f32(data + c * n, n, 1);
+
+    for (uint32_t len = 2; len <= n; len <<= 1)
+    {
+        uint32_t half = len >> 1;
+        uint32_t twiddle_step = FFT_MAX_SIZE / len;
+
+        for (uint32_t j = 0; j < half; j++)
+        {
+            // Коэффициент загружается один раз на все бабочки этого j во всех каналах
+            float w_re, w_im;
+            FFT_TWIDDLE(fft_cos_table_f32, j * twiddle_step, w_re, w_im)
+
+            for (uint32_t i = j; i < n; i += len)
+            {
+                float complex *top = &data[i * sample_stride];
+                float complex *bottom = &data[(i + half) * sample_stride];
+
+                for (uint32_t c = 0; c < channels; c++, top += channel_stride, bottom += channel_stride)
+                {
+                    float b_re = crealf(*bottom);
+                    float b_im = cimagf(*bottom);
+                    float t_re = b_re * w_re - b_im * w_im;
+                    float t_im = b_re * w_im + b_im * w_re;
+                    float a_re = crealf(*top);
+                    float a_im = cimagf(*top);
+
+                    *top = (a_re + t_re) + (a_im + t_im) * I;
+                    *bottom = (a_re - t_re) + (a_im - t_im) * I;
+                }
+            }
+        }
+    }
+    return FFT_OK;
+}
+
+/** Пакетное прямое БПФ, Q15 (общий сдвиг на все каналы) */
+FFT_Status_t FFT_Forward_Batch_Q15(FFT_Q15_t *data, uint32_t n, uint32_t channels, FFT_Layout_t layout,
+                                   int32_t *exponent)
+{
+    if (FFT_Log2(n) == 0 || channels == 0) return FFT_ERROR_SIZE;
+
+    const uint32_t sample_stride = (layout == FFT_LAYOUT_INTERLEAVED) ? channels : 1;
+    const uint32_t channel_stride = (layout == FFT_LAYOUT_INTERLEAVED) ? 1 : n;
+    const uint32_t total = n * channels;
+
+    // Раздельные каналы - по каналу, чередующиеся - блоками по channels отсчетов
+    if (layout == FFT_LAYOUT_INTERLEAVED) fft_bit_reverse_q15(data, n, channels);
+    else for (uint32_t c = 0; c < channels; c++) fft_bit_reverse_q15(data + c * n, n, 1);
+
+    uint32_t peak = 0;
+    for (uint32_t i = 0; i < total; i++)
+    {
+        peak |= (uint32_t)abs(data[i].re) | (uint32_t)abs(data[i].im);
+    }
+
+    int32_t total_shift = 0;
+
+    for (uint32_t len = 2; len <= n; len <<= 1)
+    {
+        uint32_t half = len >> 1;
+        uint32_t twiddle_step = FFT_MAX_SIZE / len;
+        uint32_t shift = fft_stage_shift(peak, 16);
+        int32_t round = shift ? (1 << (shift - 1)) : 0;
+
+        total_shift += shift;
+        peak = 0;
+
+        for (uint32_t j = 0; j < half; j++)
+        {
+            int32_t w_re, w_im;
+            FFT_TWIDDLE(fft_cos_table_q15, j * twiddle_step, w_re, w_im)
+
+            // re в младшем полуслове, im в старшем - как FFT_Q15_t в памяти: комплексное умножение за 2 инструкции
+            const uint32_t w = (uint16_t)w_re | ((uint32_t)(uint16_t)w_im << 16);
+
+            for (uint32_t i = j; i < n; i += len)
+            {
+                FFT_Q15_t *top = &data[i * sample_stride];
+                FFT_Q15_t *bottom = &data[(i + half) * sample_stride];
+
+                for (uint32_t c = 0; c < channels; c++, top += channel_stride, bottom += channel_stride)
+                {
+                    uint32_t b;
+                    memcpy(&b, bottom, sizeof(b));      // re и im одним словом (компилятор делает одно LDR)
+                    int32_t t_re = (FFT_SMUSD(b, w) + 0x4000) >> 15;
+                    int32_t t_im = (FFT_SMUADX(b, w) + 0x4000) >> 15;
+
+                    int32_t top_re = (top->re + t_re + round) >> shift;
+                    int32_t top_im = (top->im + t_im + round) >> shift;
+                    int32_t bottom_re = (top->re - t_re + round) >> shift;
+                    int32_t bottom_im = (top->im - t_im + round) >> shift;
+
+                    top->re = (int16_t)top_re;
+                    top->im = (int16_t)top_im;
+                    bottom->re = (int16_t)bottom_re;
+                    bottom->im = (int16_t)bottom_im;
+
+                    peak |= (uint32_t)abs(top_re) | (uint32_t)abs(top_im) | (uint32_t)abs(bottom_re) | (uint32_t)abs(bottom_im);
+                }
+            }
+        }
+    }
+
+    *exponent = total_shift;
+    return FFT_OK;
+}
+/**********************************************************************************************************************/
+
+
+/******************************************************************************************************** Замер */
+
+/** Тестовый сигнал: две гармоники + равномерный шум, модуль компонент меньше 0.75 */
+static double complex fft_test_sample(uint32_t i, uint32_t n)
+{
+    static uint32_t random = 1;
+    if (i == 0) random = 1;     // одинаковый сигнал при каждом заполнении
+
+    random = random * 1664525U + 1013904223U;
+    double noise_re = ((double)(random >> 8) / 16777216.0 - 0.5) * 0.2;
+    random = random * 1664525U + 1013904223U;
+    double noise_im = ((double)(random >> 8) / 16777216.0 - 0.5) * 0.2;
+
+    double phase = 2.0 * M_PI * (double)i / (double)n;
+    double re = 0.4 * sin(3.0 * phase) + 0.2 * cos((double)(n / 5) * phase + 0.3) + noise_re;
+    double im = 0.3 * cos(7.0 * phase) + noise_im;
+    return re + im * I;
+}
+
+/** Отношение сигнал/шум в дБ по накопленным энергиям */
+static float fft_snr_db(double signal_energy, double error_energy)
+{
+    if (error_energy <= 0.0) return 300.0f;
+    return (float)(10.0 * log10(signal_energy / error_energy));
+}
+
+/** Замер всех вариантов БПФ */
+uint32_t FFT_Benchmark(void *work, uint32_t work_size, FFT_Benchmark_Result_t *results, uint32_t max_results)
+{
+    uint32_t count = 0;
+
+    for (uint32_t n = FFT_MIN_SIZE; n <= FFT_MAX_SIZE && count < max_results && 32 * n <= work_size; n <<= 1)
+    {
+        FFT_Benchmark_Result_t *result = &results[count++];
+        double complex *reference = (double complex*)work;
+        void *test = (uint8_t*)work + n * sizeof(double complex);
+        double signal_energy, error_energy;
+        uint32_t cycles, start;
+        int32_t exponent = 0;
+
+        result->n = n;
+
+        /** F64: время прямого БПФ, точность - по прямому + обратному */
+        double complex *test_f64 = (double complex*)test;
+        cycles = 0;
+        for (uint32_t r = 0; r < FFT_BENCHMARK_REPEATS; r++)
+        {
+            for (uint32_t i = 0; i < n; i++) test_f64[i] = fft_test_sample(i, n);
+            start = Benchmark_Time();
+            FFT_Forward_F64(test_f64, n);
+            cycles += Benchmark_Time() - start;
+        }
+        result->cycles[FFT_TYPE_F64] = cycles / FFT_BENCHMARK_REPEATS;
+
+        FFT_Inverse_F64(test_f64, n);
+        signal_energy = 0.0;
+        error_energy = 0.0;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            double complex x = fft_test_sample(i, n);
+            double complex e = test_f64[i] - x;
+            signal_energy += creal(x) * creal(x) + cimag(x) * cimag(x);
+            error_energy += creal(e) * creal(e) + cimag(e) * cimag(e);
+        }
+        result->snr_db[FFT_TYPE_F64] = fft_snr_db(signal_energy, error_energy);
+
+        /** F32: эталон - F64 по тем же отсчетам */
+        float complex *test_f32 = (float complex*)test;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            double complex x = fft_test_sample(i, n);
+            test_f32[i] = (float)creal(x) + (float)cimag(x) * I;
+            reference[i] = (double)crealf(test_f32[i]) + (double)cimagf(test_f32[i]) * I;
+        }
+        FFT_Forward_F64(reference, n);
+
+        cycles = 0;
+        for (uint32_t r = 0; r < FFT_BENCHMARK_REPEATS; r++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                double complex x = fft_test_sample(i, n);
+                test_f32[i] = (float)creal(x) + (float)cimag(x) * I;
+            }
+            start = Benchmark_Time();
+            FFT_Forward_F32(test_f32, n);
+            cycles += Benchmark_Time() - start;
+        }
+        result->cycles[FFT_TYPE_F32] = cycles / FFT_BENCHMARK_REPEATS;
+
+        signal_energy = 0.0;
+        error_energy = 0.0;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            double e_re = (double)crealf(test_f32[i]) - creal(reference[i]);
+            double e_im = (double)cimagf(test_f32[i]) - cimag(reference[i]);
+            signal_energy += creal(reference[i]) * creal(reference[i]) + cimag(reference[i]) * cimag(reference[i]);
+            error_energy += e_re * e_re + e_im * e_im;
+        }
+        result->snr_db[FFT_TYPE_F32] = fft_snr_db(signal_energy, error_energy);
+
+        /** Q15: эталон - F64 по квантованным отсчетам */
+        FFT_Q15_t *test_q15 = (FFT_Q15_t*)test;
+        cycles = 0;
+        for (uint32_t r = 0; r < FFT_BENCHMARK_REPEATS; r++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                double complex x = fft_test_sample(i, n);
+                test_q15[i].re = (int16_t)floor(creal(x) * 32768.0 + 0.5);
+                test_q15[i].im = (int16_t)floor(cimag(x) * 32768.0 + 0.5);
+                reference[i] = test_q15[i].re / 32768.0 + (test_q15[i].im / 32768.0) * I;
+            }
+            start = Benchmark_Time();
+            FFT_Forward_Q15(test_q15, n, &exponent);
+            cycles += Benchmark_Time() - start;
+        }
+        result->cycles[FFT_TYPE_Q15] = cycles / FFT_BENCHMARK_REPEATS;
+        FFT_Forward_F64(reference, n);
+
+        signal_energy = 0.0;
+        error_energy = 0.0;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            double scale = ldexp(1.0, exponent) / 32768.0;
+            double e_re = test_q15[i].re * scale - creal(reference[i]);
+            double e_im = test_q15[i].im * scale - cimag(reference[i]);
+            signal_energy += creal(reference[i]) * creal(reference[i]) + cimag(reference[i]) * cimag(reference[i]);
+            error_energy += e_re * e_re + e_im * e_im;
+        }
+        result->snr_db[FFT_TYPE_Q15] = fft_snr_db(signal_energy, error_energy);
+
+        /** Q31 */
+        FFT_Q31_t *test_q31 = (FFT_Q31_t*)test;
+        cycles = 0;
+        for (uint32_t r = 0; r < FFT_BENCHMARK_REPEATS; r++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                double complex x = fft_test_sample(i, n);
+                test_q31[i].re = (int32_t)floor(creal(x) * 2147483648.0 + 0.5);
+                test_q31[i].im = (int32_t)floor(cimag(x) * 2147483648.0 + 0.5);
+                reference[i] = test_q31[i].re / 2147483648.0 + (test_q31[i].im / 2147483648.0) * I;
+            }
+            start = Benchmark_Time();
+            FFT_Forward_Q31(test_q31, n, &exponent);
+            cycles += Benchmark_Time() - start;
+        }
+        result->cycles[FFT_TYPE_Q31] = cycles / FFT_BENCHMARK_REPEATS;
+        FFT_Forward_F64(reference, n);
+
+        signal_energy = 0.0;
+        error_energy = 0.0;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            double scale = ldexp(1.0, exponent) / 2147483648.0;
+            double e_re = test_q31[i].re * scale - creal(reference[i]);
+            double e_im = test_q31[i].im * scale - cimag(reference[i]);
+            signal_energy += creal(reference[i]) * creal(reference[i]) + cimag(reference[i]) * cimag(reference[i]);
+            error_energy += e_re * e_re + e_im * e_im;
+        }
+        result->snr_db[FFT_TYPE_Q31] = fft_snr_db(signal_energy, error_energy);
+    }
+    return count;
+}
+
+/** Преобразований в секунду по времени cycles на transforms БПФ */
+static uint32_t fft_per_second(uint32_t cycles, uint32_t transforms)
+{
+    if (cycles == 0) return 0;
+    return (uint32_t)((uint64_t)BENCHMARK_TIME_FREQUENCY * transforms / cycles);
+}
+
+/** Замер пакетного БПФ против channels вызовов одиночного */
+FFT_Status_t FFT_Benchmark_Batch(void *work, uint32_t work_size, uint32_t n, uint32_t channels,
+                                 FFT_Batch_Benchmark_t *result)
+{
+    if (FFT_Log2(n) == 0 || channels == 0 || n * channels * sizeof(float complex) > work_size) return FFT_ERROR_SIZE;
+
+    float complex *test_f32 = (float complex*)work;
+    FFT_Q15_t *test_q15 = (FFT_Q15_t*)work;
+    const uint32_t total = n * channels;
+    int32_t exponent;
+    uint32_t start;
+    uint32_t cycles[3][2] = { { 0 } };  // [одиночные, раздельные, чередующиеся][F32, Q15]
+
+    result->n = n;
+    result->channels = channels;
+
+    for (uint32_t r = 0; r < FFT_BENCHMARK_REPEATS; r++)
+    {
+        for (uint32_t layout = 0; layout < 3; layout++)
+        {
+            // Одинаковые сигналы во всех каналах; для чередующихся - тот же отсчет i в каждом канале
+            for (uint32_t k = 0; k < total; k++)
+            {
+                uint32_t i = (layout == 2) ? k / channels : k % n;
+                double complex x = fft_test_sample(i, n);
+                test_f32[k] = (float)creal(x) + (float)cimag(x) * I;
+            }
+            start = Benchmark_Time();
+            if (layout == 0)
+            {
+                for (uint32_t c = 0; c < channels; c++) FFT_Forward_F32(&test_f32[c * n], n);
+            }
+            else
+            {
+                FFT_Forward_Batch_F32(test_f32, n, channels, (layout == 2) ? FFT_LAYOUT_INTERLEAVED : FFT_LAYOUT_PLANAR);
+            }
+            cycles[layout][0] += Benchmark_Time() - start;
+
+            for (uint32_t k = 0; k < total; k++)
+            {
+                uint32_t i = (layout == 2) ? k / channels : k % n;
+                double complex x = fft_test_sample(i, n);
+                test_q15[k].re = (int16_t)floor(creal(x) * 32768.0 + 0.5);
+                test_q15[k].im = (int16_t)floor(cimag(x) * 32768.0 + 0.5);
+            }
+            start = Benchmark_Time();
+            if (layout == 0)
+            {
+                for (uint32_t c = 0; c < channels; c++) FFT_Forward_Q15(&test_q15[c * n], n, &exponent);
+            }
+            else
+            {
+                FFT_Forward_Batch_Q15(test_q15, n, channels, (layout == 2) ? FFT_LAYOUT_INTERLEAVED : FFT_LAYOUT_PLANAR,
+                                      &exponent);
+            }
+            cycles[layout][1] += Benchmark_Time() - start;
+        }
+    }
+
+    const uint32_t transforms = channels * FFT_BENCHMARK_REPEATS;
+    for (uint32_t t = 0; t < 2; t++)
+    {
+        result->single_per_second[t] = fft_per_second(cycles[0][t], transforms);
+        result->planar_per_second[t] = fft_per_second(cycles[1][t], transforms);
+        result->interleaved_per_second[t] = fft_per_second(cycles[2][t], transforms);
+    }
+    return FFT_OK;
+}
+/**********************************************************************************************************************/
+
+
+/************************************************************************************** Прежний интерфейс */
+
+/** БПФ для 32 точек */
+void fft32(const double complex input[32], double complex output[32])
+{
+    for (int i = 0; i < 32; i++) output[i] = input[i];
+    FFT_Forward_F64(output, 32);
+}
+
+/** БПФ для 64 точек */
+void fft64(const double complex input[64], double complex output[64])
+{
+    for (int i = 0; i < 64; i++) output[i] = input[i];
+    FFT_Forward_F64(output, 64);
+}
+/**********************************************************************************************************************/
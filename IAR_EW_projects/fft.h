@@ -0,0 +1,167 @@
+/***********************************************************************************************************************
+*   Быстрое преобразование Фурье (БПФ) для N = 16 ... 4096 точек (степень двойки)
+*       Radix-2 с прореживанием по времени, вычисление на месте: перестановка с инверсией бит в самом массиве,
+*   затем log2(N) этапов бабочек. Поворотные коэффициенты берутся из одной таблицы четверти периода косинуса
+*   для N = 4096, перестановка - из таблицы инверсии 12 бит. Таблицы - константы во Flash (fft_tables.h),
+*   их генерирует на ПК fft_tables_gen.py, при старте ничего не считается.
+*
+*       Прямое преобразование: X[k] = sum x[n] * exp(-2*pi*i*k*n/N)
+*       Обратное преобразование: x[n] = 1/N * sum X[k] * exp(+2*pi*i*k*n/N)
+*
+*       Варианты по типу отсчетов:
+*   - F64 (double complex) - эталон точности, на Cortex-M4F считается программно;
+*   - F32 (float complex)  - на аппаратном FPU, основной вариант для МК;
+*   - Q15/Q31 (целые)      - блочная плавающая точка: перед каждым этапом по максимуму модуля выбирается сдвиг
+*                            0..2 бита, после которого компоненты меньше 1/4 шкалы и бабочка (рост до 1 + sqrt(2))
+*                            не переполняется при любом входе. Общий сдвиг возвращается в exponent,
+*                            X[k] = data[k] * 2^exponent (в единицах входного формата)
+***********************************************************************************************************************/
+
+#ifndef __FFT_H__
+#define __FFT_H__
+
+#include <stdint.h>
+#include <math.h>
+#include <complex.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FFT_MIN_SIZE        16
+#define FFT_MAX_SIZE        4096
+#define FFT_MAX_LOG2        12
+
+/** Отсчет Q15: значение = re / 32768 */
+typedef struct
+{
+    int16_t re;
+    int16_t im;
+}
+FFT_Q15_t;
+
+/** Отсчет Q31: значение = re / 2^31 */
+typedef struct
+{
+    int32_t re;
+    int32_t im;
+}
+FFT_Q31_t;
+
+typedef enum
+{
+    FFT_TYPE_F64 = 0,
+    FFT_TYPE_F32 = 1,
+    FFT_TYPE_Q15 = 2,
+    FFT_TYPE_Q31 = 3,
+    FFT_TYPE_COUNT = 4
+}
+FFT_Type_t;
+
+/** Результат FFT_Benchmark для одного размера */
+typedef struct
+{
+    uint32_t n;
+    uint32_t cycles[FFT_TYPE_COUNT];    // тактов на одно прямое БПФ (на ПК с HOST_BUILD - нс)
+    float    snr_db[FFT_TYPE_COUNT];    // отношение сигнал/шум относительно эталона, дБ
+}
+FFT_Benchmark_Result_t;
+
+/** Расположение каналов пакетного БПФ (channels сигналов по n отсчетов) */
+typedef enum
+{
+    FFT_LAYOUT_PLANAR = 0,          // каналы подряд: отсчет i канала c - data[c * n + i]
+    FFT_LAYOUT_INTERLEAVED = 1      // отсчеты чередуются (как из АЦП в режиме сканирования): data[i * channels + c]
+}
+FFT_Layout_t;
+
+/** Результат FFT_Benchmark_Batch: преобразований в секунду, [0] - F32, [1] - Q15 */
+typedef struct
+{
+    uint32_t n;
+    uint32_t channels;
+    uint32_t single_per_second[2];          // channels вызовов одиночного БПФ
+    uint32_t planar_per_second[2];          // пакетное БПФ, FFT_LAYOUT_PLANAR
+    uint32_t interleaved_per_second[2];     // пакетное БПФ, FFT_LAYOUT_INTERLEAVED
+}
+FFT_Batch_Benchmark_t;
+
+typedef enum
+{
+    FFT_OK = 0,
+    FFT_ERROR_SIZE = 1      // N не степень двойки или вне диапазона FFT_MIN_SIZE ... FFT_MAX_SIZE
+}
+FFT_Status_t;
+
+/** Прежний интерфейс: таблицы теперь во Flash, вызов ничего не делает */
+void FFT_Init(void);
+
+/** log2(n), если n - допустимый размер БПФ, иначе 0 */
+uint32_t FFT_Log2(uint32_t n);
+
+/** Прямое БПФ на месте, data - n комплексных отсчетов */
+FFT_Status_t FFT_Forward_F64(double complex *data, uint32_t n);
+
+/** Обратное БПФ на месте (с делением на n) */
+FFT_Status_t FFT_Inverse_F64(double complex *data, uint32_t n);
+
+/** Прямое БПФ на месте, одинарная точность */
+FFT_Status_t FFT_Forward_F32(float complex *data, uint32_t n);
+
+/** Обратное БПФ на месте, одинарная точность (с делением на n) */
+FFT_Status_t FFT_Inverse_F32(float complex *data, uint32_t n);
+
+/** Прямое БПФ на месте, Q15, exponent - общий сдвиг результата (обычно log2(n)+1, не больше 2*log2(n)) */
+FFT_Status_t FFT_Forward_Q15(FFT_Q15_t *data, uint32_t n, int32_t *exponent);
+
+/** Прямое БПФ на месте, Q31, exponent - общий сдвиг результата */
+FFT_Status_t FFT_Forward_Q31(FFT_Q31_t *data, uint32_t n, int32_t *exponent);
+
+/** БПФ вещественного сигнала из n отсчетов (n = 32 ... FFT_MAX_SIZE): БПФ n/2 комплексных точек над парами
+*   (x[2m] + i*x[2m+1]) и разделение спектров четных и нечетных отсчетов.
+*   spectrum - n/2 + 1 уникальных бинов X[0] ... X[n/2] (остальные - комплексно сопряженные), X[0] и X[n/2]
+*   вещественные. Время и память примерно вдвое меньше, чем у комплексного БПФ на n точек */
+FFT_Status_t FFT_Forward_Real_F32(const float *input, float complex *spectrum, uint32_t n);
+
+/** Обратное БПФ вещественного сигнала: n/2 + 1 бинов -> n отсчетов (с делением на n)
+*   spectrum используется как рабочий буфер и портится */
+FFT_Status_t FFT_Inverse_Real_F32(float complex *spectrum, float *output, uint32_t n);
+
+/** Двумерное БПФ на месте над изображением width x height (обе стороны - степени двойки FFT_MIN_SIZE ... FFT_MAX_SIZE),
+*   data - построчно, column - рабочий буфер на height отсчетов */
+FFT_Status_t FFT_Forward_2D_F32(float complex *data, uint32_t width, uint32_t height, float complex *column);
+
+/** Обратное двумерное БПФ на месте (с делением на width*height) */
+FFT_Status_t FFT_Inverse_2D_F32(float complex *data, uint32_t width, uint32_t height, float complex *column);
+
+/** Пакетное прямое БПФ channels независимых сигналов по n точек на месте. Поворотный коэффициент загружается
+*   один раз на бабочку сразу для всех каналов, внутренний цикл идет по каналам (для FFT_LAYOUT_INTERLEAVED - по
+*   соседним адресам). Результат каждого канала совпадает с FFT_Forward_F32 */
+FFT_Status_t FFT_Forward_Batch_F32(float complex *data, uint32_t n, uint32_t channels, FFT_Layout_t layout);
+
+/** Пакетное прямое БПФ, Q15: комплексное умножение - двойным MAC Cortex-M4 (SMUSD/SMUADX).
+*   exponent - общий сдвиг для всех каналов (выбирается по самому громкому каналу, у тихих каналов
+*   точность ниже, чем у отдельного FFT_Forward_Q15) */
+FFT_Status_t FFT_Forward_Batch_Q15(FFT_Q15_t *data, uint32_t n, uint32_t channels, FFT_Layout_t layout,
+                                   int32_t *exponent);
+
+/** Замер всех вариантов БПФ для N = FFT_MIN_SIZE ... пока хватает work (нужно 32*N байт, выравнивание 8)
+*   Время - счетчик DWT (нужен DWT_Init), при сборке на ПК с HOST_BUILD - часы ПК.
+*   Вызовы: FFT_BENCHMARK в main.c (такты на МК), make -C tests bench (таблица на ПК).
+*   Эталон - F64 по тем же (квантованным) входным отсчетам; для самого F64 - ошибка прямого+обратного БПФ.
+*   return: количество заполненных элементов results (не больше max_results) */
+uint32_t FFT_Benchmark(void *work, uint32_t work_size, FFT_Benchmark_Result_t *results, uint32_t max_results);
+
+/** Пропускная способность пакетного БПФ (обе раскладки) против channels вызовов одиночного, F32 и Q15
+*   work - n*channels*8 байт, выравнивание 8. Вызовы: FFT_BENCHMARK в main.c, make -C tests bench */
+FFT_Status_t FFT_Benchmark_Batch(void *work, uint32_t work_size, uint32_t n, uint32_t channels,
+                                 FFT_Batch_Benchmark_t *result);
+
+
+/** Прежний интерфейс: БПФ для 32 точек (обертка над FFT_Forward_F64) */
+void fft32(const double complex input[32], double complex output[32]);
+
+/** Прежний интерфейс: БПФ для 64 точек (обертка над FFT_Forward_F64) */
+void fft64(const double complex input[64], double complex output[64]);
+
+#endif /* __FFT_H__ */
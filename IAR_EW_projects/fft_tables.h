@@ -0,0 +1,1066 @@
+/***********************************************************************************************************************
+*   Таблицы БПФ во Flash (см. fft.c)
+*       СГЕНЕРИРОВАНО fft_tables_gen.py для FFT_MAX_SIZE = 4096, не редактировать вручную
+***********************************************************************************************************************/
+
+#ifndef __FFT_TABLES_H__
+#define __FFT_TABLES_H__
+
+#include <stdint.h>
+
+#define FFT_TABLES_MAX_SIZE     4096
+
+/** cos(2*pi*j / 4096) для j = 0 ... 1024 */
+static const double fft_cos_table[1025] =
+{
+    1.0, 0.9999988234517019, 0.9999952938095762, 0.9999894110819284, 0.9999811752826011, 0.9999705864309741, 0.9999576445519639, 0.9999423496760239,
+    0.9999247018391445, 0.9999047010828529, 0.9998823474542126, 0.9998576410058239, 0.9998305817958234, 0.9998011698878843, 0.9997694053512153, 0.9997352882605617,
+    0.9996988186962042, 0.9996599967439592, 0.9996188224951786, 0.9995752960467492, 0.9995294175010931, 0.999481186966167, 0.9994306045554617, 0.9993776703880028,
+    0.9993223845883495, 0.9992647472865944, 0.9992047586183639, 0.9991424187248169, 0.9990777277526454, 0.9990106858540734, 0.9989412931868569, 0.9988695499142836,
+    0.9987954562051724, 0.9987190122338729, 0.9986402181802653, 0.9985590742297593, 0.9984755805732948, 0.9983897374073402, 0.9983015449338929, 0.9982110033604782,
+    0.9981181129001492, 0.9980228737714862, 0.997925286198596, 0.9978253504111116, 0.9977230666441916, 0.9976184351385196, 0.9975114561403035, 0.9974021299012753,
+    0.9972904566786902, 0.9971764367353262, 0.997060070339483, 0.9969413577649822, 0.9968202992911657, 0.9966968952028961, 0.9965711457905548, 0.9964430513500426,
+    0.996312612182778, 0.996179828595697, 0.996044700901252, 0.9959072294174117, 0.9957674144676598, 0.9956252563809943, 0.9954807554919269, 0.9953339121404823,
+    0.9951847266721969, 0.9950331994381186, 0.9948793307948056, 0.9947231211043257, 0.9945645707342554, 0.9944036800576791, 0.9942404494531879, 0.9940748793048794,
+    0.9939069700023561, 0.9937367219407246, 0.9935641355205953, 0.9933892111480807, 0.9932119492347945, 0.9930323501978514, 0.9928504144598651, 0.992666142448948,
+    0.99247953459871, 0.9922905913482574, 0.9920993131421918, 0.9919057004306093, 0.9917097536690995, 0.9915114733187439, 0.9913108598461154, 0.9911079137232769,
+    0.99090263542778, 0.9906950254426646, 0.9904850842564571, 0.9902728123631691, 0.9900582102622971, 0.9898412784588205, 0.9896220174632009, 0.9894004277913804,
+    0.989176509964781, 0.988950264510303, 0.9887216919603238, 0.9884907928526966, 0.9882575677307495, 0.9880220171432835, 0.9877841416445722, 0.9875439417943592,
+    0.9873014181578584, 0.987056571305751, 0.9868094018141855, 0.9865599102647754, 0.9863080972445987, 0.9860539633461954, 0.9857975091675675, 0.9855387353121761,
+    0.9852776423889412, 0.9850142310122398, 0.9847485018019042, 0.9844804553832209, 0.984210092386929, 0.9839374134492189, 0.9836624192117303, 0.9833851103215512,
+    0.9831054874312163, 0.9828235511987052, 0.9825393022874412, 0.9822527413662894, 0.9819638691095552, 0.9816726861969831, 0.9813791933137546, 0.9810833911504867,
+    0.9807852804032304, 0.9804848617734694, 0.9801821359681174, 0.9798771036995176, 0.9795697656854405, 0.979260122649082, 0.9789481753190622, 0.9786339244294232,
+    0.9783173707196277, 0.9779985149345571, 0.9776773578245099, 0.9773539001452, 0.9770281426577544, 0.9767000861287118, 0.9763697313300211, 0.976037079039039,
+    0.9757021300385286, 0.975364885116657, 0.9750253450669941, 0.9746835106885107, 0.9743393827855759, 0.9739929621679558, 0.973644249650812, 0.9732932460546982,
+    0.9729399522055602, 0.9725843689347322, 0.9722264970789363, 0.9718663374802794, 0.9715038909862518, 0.9711391584497251, 0.9707721407289504, 0.9704028386875555,
+    0.970031253194544, 0.9696573851242924, 0.9692812353565485, 0.9689028047764289, 0.9685220942744174, 0.9681391047463624, 0.9677538370934755, 0.9673662922223285,
+    0.9669764710448521, 0.9665843744783331, 0.9661900034454125, 0.9657933588740837, 0.9653944416976894, 0.9649932528549203, 0.9645897932898128, 0.9641840639517458,
+    0.9637760657954398, 0.963365799780954, 0.9629532668736839, 0.9625384680443592, 0.9621214042690416, 0.9617020765291225, 0.9612804858113206, 0.9608566331076797,
+    0.9604305194155658, 0.960002145737666, 0.9595715130819845, 0.9591386224618419, 0.9587034748958716, 0.9582660714080177, 0.9578264130275329, 0.9573845007889759,
+    0.9569403357322088, 0.9564939189023951, 0.9560452513499964, 0.9555943341307711, 0.9551411683057708, 0.9546857549413383, 0.9542280951091057, 0.9537681898859903,
+    0.9533060403541939, 0.9528416476011987, 0.9523750127197659, 0.9519061368079323, 0.9514350209690083, 0.9509616663115751, 0.9504860739494817, 0.950008245001843,
+    0.9495281805930367, 0.9490458818527006, 0.9485613499157303, 0.9480745859222762, 0.9475855910177411, 0.9470943663527772, 0.9466009130832835, 0.9461052323704034,
+    0.9456073253805213, 0.9451071932852606, 0.9446048372614803, 0.9441002584912727, 0.9435934581619604, 0.9430844374660935, 0.9425731976014469, 0.9420597397710173,
+    0.9415440651830208, 0.9410261750508893, 0.9405060705932683, 0.939983753034014, 0.9394592236021899, 0.9389324835320646, 0.9384035340631081, 0.9378723764399899,
+    0.937339011912575, 0.9368034417359216, 0.9362656671702783, 0.9357256894810804, 0.9351835099389476, 0.9346391298196808, 0.934092550404259, 0.9335437729788362,
+    0.932992798834739, 0.9324396292684624, 0.9318842655816681, 0.9313267090811804, 0.9307669610789837, 0.9302050228922191, 0.9296408958431813, 0.9290745812593159,
+    0.9285060804732156, 0.9279353948226179, 0.9273625256504011, 0.9267874743045817, 0.9262102421383114, 0.9256308305098727, 0.9250492407826776, 0.9244654743252626,
+    0.9238795325112867, 0.9232914167195276, 0.9227011283338786, 0.9221086687433452, 0.921514039342042, 0.9209172415291895, 0.9203182767091106, 0.9197171462912274,
+    0.9191138516900578, 0.9185083943252123, 0.9179007756213905, 0.9172909970083779, 0.9166790599210427, 0.9160649657993317, 0.9154487160882678, 0.9148303122379462,
+    0.9142097557035307, 0.9135870479452508, 0.9129621904283982, 0.9123351846233227, 0.9117060320054299, 0.9110747340551764, 0.9104412922580672, 0.9098057081046522,
+    0.9091679830905224, 0.9085281187163061, 0.9078861164876663, 0.9072419779152958, 0.9065957045149153, 0.9059472978072685, 0.9052967593181188, 0.9046440905782462,
+    0.9039892931234433, 0.9033323684945118, 0.9026733182372588, 0.9020121439024932, 0.901348847046022, 0.900683429228647, 0.9000158920161603, 0.8993462369793416,
+    0.8986744656939538, 0.8980005797407399, 0.8973245807054183, 0.8966464701786802, 0.8959662497561852, 0.8952839210385576, 0.8945994856313827, 0.8939129451452033,
+    0.8932243011955153, 0.8925335554027646, 0.8918407093923427, 0.8911457647945832, 0.8904487232447579, 0.8897495863830728, 0.8890483558546646, 0.8883450333095964,
+    0.8876396204028539, 0.8869321187943422, 0.8862225301488806, 0.8855108561362, 0.8847970984309378, 0.884081258712635, 0.8833633386657316, 0.8826433399795628,
+    0.881921264348355, 0.8811971134712221, 0.8804708890521608, 0.8797425928000474, 0.8790122264286335, 0.8782797916565416, 0.8775452902072614, 0.8768087238091457,
+    0.8760700941954066, 0.8753294031041109, 0.8745866522781761, 0.8738418434653669, 0.8730949784182901, 0.8723460588943915, 0.871595086655951, 0.870842063470079,
+    0.8700869911087115, 0.8693298713486068, 0.8685707059713409, 0.8678094967633033, 0.8670462455156926, 0.866280954024513, 0.8655136240905691, 0.8647442575194624,
+    0.8639728561215868, 0.8631994217121242, 0.8624239561110406, 0.8616464611430813, 0.8608669386377673, 0.8600853904293901, 0.8593018183570085, 0.8585162242644427,
+    0.8577286100002721, 0.8569389774178288, 0.8561473283751945, 0.855353664735196, 0.8545579883654005, 0.8537603011381114, 0.8529606049303636, 0.8521589016239198,
+    0.8513551931052652, 0.8505494812656035, 0.8497417680008525, 0.8489320552116396, 0.8481203448032972, 0.8473066386858583, 0.8464909387740521, 0.8456732469872991,
+    0.8448535652497071, 0.8440318954900664, 0.8432082396418454, 0.8423825996431858, 0.8415549774368984, 0.8407253749704581, 0.8398937941959995, 0.8390602370703127,
+    0.8382247055548381, 0.8373872016156619, 0.836547727223512, 0.8357062843537526, 0.83486287498638, 0.8340175011060181, 0.8331701647019132, 0.8323208677679297,
+    0.8314696123025452, 0.8306164003088463, 0.829761233794523, 0.8289041147718649, 0.8280450452577558, 0.8271840272736691, 0.8263210628456635, 0.8254561540043776,
+    0.8245893027850253, 0.8237205112273914, 0.8228497813758264, 0.8219771152792416, 0.8211025149911046, 0.8202259825694347, 0.8193475200767969, 0.8184671295802987,
+    0.8175848131515837, 0.8167005728668278, 0.8158144108067338, 0.8149263290565266, 0.8140363297059484, 0.8131444148492536, 0.8122505865852039, 0.8113548470170637,
+    0.8104571982525948, 0.8095576424040513, 0.808656181588175, 0.8077528179261904, 0.8068475535437993, 0.8059403905711763, 0.8050313311429637, 0.8041203773982658,
+    0.8032075314806449, 0.8022927955381157, 0.8013761717231402, 0.8004576621926228, 0.799537269107905, 0.7986149946347608, 0.7976908409433912, 0.7967648102084188,
+    0.7958369046088836, 0.794907126328237, 0.7939754775543372, 0.7930419604794436, 0.7921065773002124, 0.7911693302176902, 0.79023022143731, 0.7892892531688857,
+    0.7883464276266063, 0.7874017470290314, 0.7864552135990858, 0.7855068295640539, 0.7845565971555752, 0.7836045186096382, 0.7826505961665757, 0.7816948320710594,
+    0.7807372285720945, 0.7797777879230146, 0.778816512381476, 0.7778534042094531, 0.7768884656732324, 0.7759216990434077, 0.7749531065948739, 0.7739826906068229,
+    0.773010453362737, 0.7720363971503845, 0.7710605242618138, 0.7700828369933479, 0.7691033376455797, 0.7681220285233654, 0.7671389119358204, 0.7661539901963129,
+    0.765167265622459, 0.7641787405361167, 0.7631884172633813, 0.7621962981345789, 0.7612023854842618, 0.7602066816512024, 0.7592091889783881, 0.7582099098130153,
+    0.7572088465064846, 0.7562060014143945, 0.7552013768965365, 0.7541949753168892, 0.7531867990436125, 0.7521768504490428, 0.7511651319096865, 0.7501516458062151,
+    0.7491363945234594, 0.7481193804504036, 0.7471006059801801, 0.7460800735100638, 0.7450577854414661, 0.7440337441799293, 0.7430079521351217, 0.7419804117208311,
+    0.7409511253549591, 0.7399200954595162, 0.7388873244606151, 0.737852814788466, 0.7368165688773699, 0.7357785891657136, 0.7347388780959635, 0.7336974381146604,
+    0.7326542716724128, 0.7316093812238926, 0.7305627692278276, 0.729514438146997, 0.7284643904482252, 0.7274126286023758, 0.726359155084346, 0.7253039723730608,
+    0.724247082951467, 0.7231884893065275, 0.7221281939292153, 0.7210661993145081, 0.7200025079613817, 0.7189371223728045, 0.7178700450557317, 0.7168012785210995,
+    0.7157308252838186, 0.7146586878627691, 0.7135848687807936, 0.7125093705646923, 0.7114321957452164, 0.7103533468570624, 0.7092728264388657, 0.7081906370331954,
+    0.7071067811865476, 0.7060212614493397, 0.704934080375905, 0.7038452405244849, 0.7027547444572253, 0.7016625947401686, 0.7005687939432484, 0.6994733446402838,
+    0.6983762494089729, 0.6972775108308866, 0.696177131491463, 0.6950751139800009, 0.693971460889654, 0.6928661748174247, 0.6917592583641577, 0.6906507141345347,
+    0.6895405447370669, 0.6884287527840905, 0.6873153408917592, 0.6862003116800387, 0.6850836677727004, 0.6839654117973155, 0.6828455463852481, 0.6817240741716498,
+    0.6806009977954531, 0.6794763198993651, 0.6783500431298616, 0.6772221701371804, 0.676092703575316, 0.674961646102012, 0.6738290003787561, 0.672694769070773,
+    0.6715589548470183, 0.6704215603801731, 0.669282588346636, 0.6681420414265186, 0.6669999223036375, 0.6658562336655097, 0.6647109782033449, 0.6635641586120399,
+    0.6624157775901718, 0.6612658378399923, 0.6601143420674205, 0.6589612929820373, 0.6578066932970786, 0.656650545729429, 0.6554928529996155, 0.6543336178318006,
+    0.6531728429537768, 0.6520105310969595, 0.650846684996381, 0.6496813073906832, 0.6485144010221126, 0.6473459686365121, 0.6461760129833164, 0.645004536815544,
+    0.6438315428897915, 0.6426570339662269, 0.6414810128085832, 0.6403034821841517, 0.6391244448637757, 0.6379439036218442, 0.6367618612362842, 0.6355783204885562,
+    0.6343932841636455, 0.6332067550500572, 0.6320187359398091, 0.6308292296284245, 0.6296382389149271, 0.6284457666018327, 0.6272518154951442, 0.6260563884043435,
+    0.6248594881423865, 0.6236611175256946, 0.6224612793741501, 0.6212599765110877, 0.6200572117632892, 0.6188529879609763, 0.617647307937804, 0.6164401745308536,
+    0.6152315905806268, 0.6140215589310385, 0.6128100824294097, 0.611597163926462, 0.6103828062763095, 0.6091670123364532, 0.6079497849677737, 0.6067311270345245,
+    0.6055110414043255, 0.6042895309481561, 0.6030665985403483, 0.60184224705858, 0.600616479383869, 0.5993892984005645, 0.5981607069963424, 0.5969307080621965,
+    0.5956993044924335, 0.5944664991846645, 0.5932322950397998, 0.591996694962041, 0.5907597018588743, 0.5895213186410639, 0.5882815482226453, 0.5870403935209181,
+    0.5857978574564389, 0.5845539429530153, 0.5833086529376983, 0.5820619903407755, 0.5808139580957645, 0.5795645591394057, 0.5783137964116556, 0.5770616728556796,
+    0.5758081914178453, 0.5745533550477158, 0.5732971666980423, 0.572039629324757, 0.5707807458869674, 0.5695205193469473, 0.5682589526701315, 0.5669960488251087,
+    0.5657318107836132, 0.5644662415205195, 0.5631993440138341, 0.5619311212446895, 0.560661576197336, 0.5593907118591361, 0.5581185312205561, 0.5568450372751601,
+    0.5555702330196023, 0.5542941214536201, 0.5530167055800276, 0.5517379884047074, 0.5504579729366048, 0.5491766621877198, 0.5478940591731002, 0.5466101669108349,
+    0.5453249884220465, 0.5440385267308839, 0.542750784864516, 0.5414617658531236, 0.540171472729893, 0.5388799085310084, 0.5375870762956455, 0.5362929790659632,
+    0.5349976198870973, 0.533701001807153, 0.532403127877198, 0.531104001151255, 0.5298036246862948, 0.5285020015422285, 0.5271991347819014, 0.5258950274710847,
+    0.5245896826784688, 0.5232831034756564, 0.5219752929371544, 0.5206662541403673, 0.5193559901655895, 0.5180445040959993, 0.51673179901765, 0.5154178780194631,
+    0.5141027441932217, 0.5127864006335631, 0.5114688504379705, 0.5101500967067667, 0.508830142543107, 0.5075089910529709, 0.5061866453451555, 0.5048631085312675,
+    0.5035383837257176, 0.5022124740457109, 0.5008853826112409, 0.4995571125450819, 0.49822766697278187, 0.49689704902265464, 0.4955652618257725, 0.49423230851595973,
+    0.4928981922297841, 0.49156291610655006, 0.4902264832882911, 0.4888888969197632, 0.48755016014843605, 0.48621027612448653, 0.4848692480007911, 0.48352707893291874,
+    0.48218377207912283, 0.4808393306003339, 0.479493757660153, 0.4781470564248431, 0.47679923006332225, 0.47545028174715587, 0.47410021465055, 0.4727490319503429,
+    0.4713967368259978, 0.4700433324595956, 0.46868882203582796, 0.4673332087419885, 0.4659764957679661, 0.4646186863062378, 0.46325978355186026, 0.46189979070246284,
+    0.46053871095824, 0.45917654752194415, 0.4578133035988773, 0.45644898239688386, 0.45508358712634384, 0.4537171210001639, 0.452349587233771, 0.4509809890451038,
+    0.4496113296546066, 0.44824061228522, 0.4468688401623743, 0.44549601651398174, 0.44412214457042926, 0.44274722756457013, 0.4413712687317166, 0.43999427130963326,
+    0.4386162385385277, 0.4372371736610442, 0.4358570799222555, 0.4344759605696557, 0.433093818853152, 0.43171065802505737, 0.4303264813400826, 0.42894129205532955,
+    0.4275550934302822, 0.4261678887267996, 0.4247796812091088, 0.4233904741437961, 0.4220002707997998, 0.4206090744484025, 0.41921688836322396, 0.4178237158202124,
+    0.4164295600976373, 0.41503442447608163, 0.41363831223843456, 0.412241226669883, 0.4108431710579039, 0.4094441486922576, 0.40804416286497874, 0.40664321687036914,
+    0.40524131400498986, 0.40383845756765413, 0.40243465085941854, 0.4010298971835758, 0.3996241998456468, 0.3982175621533736, 0.3968099874167104, 0.3954014789478163,
+    0.3939920400610481, 0.3925816740729515, 0.391170384302254, 0.3897581740698564, 0.3883450466988263, 0.3869310055143887, 0.385516053843919, 0.38410019501693504,
+    0.38268343236508984, 0.3812657692221625, 0.3798472089240511, 0.3784277548087656, 0.3770074102164183, 0.3755861784892173, 0.374164062971458, 0.3727410670095158,
+    0.3713171939518376, 0.36989244714893427, 0.3684668299533723, 0.36704034571976724, 0.36561299780477396, 0.36418478956707984, 0.3627557243673972, 0.36132580556845434,
+    0.3598950365349883, 0.35846342063373654, 0.35703096123343003, 0.35559766170478396, 0.3541635254204905, 0.3527285557552107, 0.35129275608556715, 0.34985612979013503,
+    0.3484186802494345, 0.3469804108459237, 0.34554132496398915, 0.344101425989939, 0.3426607173119944, 0.3412192023202824, 0.33977688440682696, 0.3383337669655413,
+    0.33688985339222005, 0.33544514708453166, 0.3339996514420095, 0.3325533698660442, 0.33110630575987643, 0.32965846252858755, 0.32820984357909266, 0.3267604523201318,
+    0.325310292162263, 0.32385936651785296, 0.32240767880107, 0.3209552324278752, 0.31950203081601575, 0.31804807738501506, 0.31659337555616585, 0.31513792875252244,
+    0.3136817403988916, 0.31222481392182505, 0.3107671527496115, 0.3093087603122688, 0.307849640041535, 0.3063897953708611, 0.30492922973540243, 0.30346794657201137,
+    0.3020059493192282, 0.3005432414172734, 0.2990798263080405, 0.2976157074350863, 0.29615088824362396, 0.2946853721805143, 0.2932191626942587, 0.2917522632349894,
+    0.29028467725446233, 0.2888164082060495, 0.28734745954472957, 0.2858778347270807, 0.2844075372112718, 0.2829365704570554, 0.28146493792575805, 0.2799926430802734,
+    0.27851968938505306, 0.27704608030609995, 0.27557181931095825, 0.27409690986870633, 0.272621355449949, 0.27114515952680807, 0.2696683255729152, 0.2681908570634032,
+    0.2667127574748984, 0.2652340302855119, 0.2637546789748315, 0.2622747070239136, 0.26079411791527557, 0.25931291513288635, 0.25783110216215893, 0.2563486824899429,
+    0.2548656596045146, 0.25338203699557027, 0.2518978181542169, 0.2504130065729653, 0.24892760574572026, 0.24744161916777344, 0.2459550503357946, 0.2444679027478242,
+    0.24298017990326398, 0.2414918853028693, 0.2400030224487415, 0.2385135948443185, 0.23702360599436734, 0.23553305940497546, 0.23404195858354346, 0.23255030703877533,
+    0.23105810828067128, 0.22956536582051887, 0.2280720831708858, 0.2265782638456101, 0.22508391135979278, 0.22358902922979002, 0.2220936209732036, 0.22059769010887365,
+    0.21910124015686977, 0.21760427463848367, 0.2161067970762196, 0.21460881099378692, 0.21311031991609136, 0.2116113273692276, 0.21011183688046972, 0.20861185197826346,
+    0.20711137619221856, 0.20561041305309932, 0.204108966092817, 0.2026070388444211, 0.20110463484209196, 0.19960175762113105, 0.19809841071795373, 0.19659459767008022,
+    0.19509032201612833, 0.19358558729580375, 0.19208039704989238, 0.1905747548202528, 0.18906866414980628, 0.18756212858252974, 0.18605515166344663, 0.18454773693861964,
+    0.18303988795514106, 0.18153160826112513, 0.18002290140569951, 0.1785137709389976, 0.17700422041214886, 0.17549425337727137, 0.17398387338746385, 0.17247308399679603,
+    0.17096188876030136, 0.16945029123396793, 0.16793829497473123, 0.16642590354046422, 0.1649131204899701, 0.16339994938297323, 0.16188639378011188, 0.1603724572429284,
+    0.1588581433338614, 0.15734345561623828, 0.15582839765426532, 0.15431297301302024, 0.1527971852584434, 0.15128103795733025, 0.14976453467732162, 0.1482476789868962,
+    0.14673047445536175, 0.14521292465284752, 0.14369503315029458, 0.142176803519448, 0.14065823933284924, 0.13913934416382628, 0.13762012158648618, 0.1361005751757062,
+    0.13458070850712622, 0.13306052515713918, 0.13154002870288328, 0.13001922272223335, 0.12849811079379322, 0.12697669649688598, 0.1254549834115462, 0.1239329751185122,
+    0.12241067519921628, 0.12088808723577722, 0.11936521481099135, 0.11784206150832502, 0.11631863091190488, 0.11479492660651025, 0.11327095217756436, 0.11174671121112666,
+    0.11022220729388318, 0.10869744401313867, 0.10717242495680887, 0.1056471537134107, 0.10412163387205473, 0.10259586902243628, 0.10106986275482788, 0.09954361866006944,
+    0.09801714032956077, 0.0964904313552526, 0.09496349532963906, 0.09343633584574791, 0.0919089564971327, 0.09038136087786501, 0.08885355258252468, 0.08732553520619223,
+    0.08579731234443988, 0.08426888759332413, 0.0827402645493758, 0.08121144680959239, 0.07968243797143013, 0.07815324163279432, 0.07662386139203162, 0.07509430084792129,
+    0.07356456359966745, 0.07203465324688942, 0.07050457338961401, 0.06897432762826673, 0.0674439195636641, 0.06591335279700393, 0.06438263092985741, 0.06285175756416142,
+    0.06132073630220865, 0.05978957074664001, 0.05825826450043573, 0.05672682116690778, 0.05519524434969003, 0.05366353765273068, 0.05213170468028332, 0.05059974903689934,
+    0.049067674327418126, 0.04753548415695926, 0.046003182130914644, 0.044470771854938744, 0.04293825693494096, 0.04140564097707671, 0.039872927587739845, 0.03834012037355279,
+    0.03680722294135899, 0.03527423889821395, 0.03374117185137764, 0.032208025408304704, 0.03067480317663658, 0.02914150876419374, 0.02760814577896582, 0.02607471782910404,
+    0.024541228522912264, 0.02300768146883941, 0.021474080275469605, 0.019940428551514598, 0.01840672990580482, 0.016872987947281773, 0.01533920628498822, 0.013805388528060349,
+    0.012271538285719944, 0.010737659167264572, 0.00920375478205996, 0.007669828739531077, 0.006135884649154515, 0.004601926120448672, 0.003067956762966138, 0.0015339801862847662,
+    0.0
+};
+
+/** То же, одинарная точность (округление до ближайшего float) */
+static const float fft_cos_table_f32[1025] =
+{
+    1.000000000e+00f, 9.999988079e-01f, 9.999952912e-01f, 9.999893904e-01f, 9.999811649e-01f, 9.999706149e-01f, 9.999576211e-01f, 9.999423623e-01f,
+    9.999247193e-01f, 9.999046922e-01f, 9.998823404e-01f, 9.998576641e-01f, 9.998306036e-01f, 9.998011589e-01f, 9.997693896e-01f, 9.997352958e-01f,
+    9.996988177e-01f, 9.996600151e-01f, 9.996188283e-01f, 9.995753169e-01f, 9.995294213e-01f, 9.994812012e-01f, 9.994305968e-01f, 9.993776679e-01f,
+    9.993223548e-01f, 9.992647767e-01f, 9.992047548e-01f, 9.991424084e-01f, 9.990777373e-01f, 9.990106821e-01f, 9.989413023e-01f, 9.988695383e-01f,
+    9.987954497e-01f, 9.987190366e-01f, 9.986402392e-01f, 9.985590577e-01f, 9.984755516e-01f, 9.983897209e-01f, 9.983015656e-01f, 9.982110262e-01f,
+    9.981181026e-01f, 9.980228543e-01f, 9.979252815e-01f, 9.978253245e-01f, 9.977230430e-01f, 9.976184368e-01f, 9.975114465e-01f, 9.974021316e-01f,
+    9.972904325e-01f, 9.971764088e-01f, 9.970600605e-01f, 9.969413280e-01f, 9.968202710e-01f, 9.966968894e-01f, 9.965711236e-01f, 9.964430332e-01f,
+    9.963126183e-01f, 9.961798191e-01f, 9.960446954e-01f, 9.959072471e-01f, 9.957674146e-01f, 9.956252575e-01f, 9.954807758e-01f, 9.953339100e-01f,
+    9.951847196e-01f, 9.950332046e-01f, 9.948793054e-01f, 9.947231412e-01f, 9.945645928e-01f, 9.944036603e-01f, 9.942404628e-01f, 9.940748811e-01f,
+    9.939069748e-01f, 9.937367439e-01f, 9.935641289e-01f, 9.933891892e-01f, 9.932119250e-01f, 9.930323362e-01f, 9.928504229e-01f, 9.926661253e-01f,
+    9.924795628e-01f, 9.922906160e-01f, 9.920992851e-01f, 9.919056892e-01f, 9.917097688e-01f, 9.915114641e-01f, 9.913108349e-01f, 9.911079407e-01f,
+    9.909026623e-01f, 9.906949997e-01f, 9.904850721e-01f, 9.902728200e-01f, 9.900581837e-01f, 9.898412824e-01f, 9.896219969e-01f, 9.894004464e-01f,
+    9.891765118e-01f, 9.889502525e-01f, 9.887216687e-01f, 9.884908199e-01f, 9.882575870e-01f, 9.880220294e-01f, 9.877841473e-01f, 9.875439405e-01f,
+    9.873014092e-01f, 9.870565534e-01f, 9.868093729e-01f, 9.865599275e-01f, 9.863080978e-01f, 9.860539436e-01f, 9.857975245e-01f, 9.855387211e-01f,
+    9.852776527e-01f, 9.850142598e-01f, 9.847484827e-01f, 9.844804406e-01f, 9.842100739e-01f, 9.839374423e-01f, 9.836624265e-01f, 9.833850861e-01f,
+    9.831054807e-01f, 9.828235507e-01f, 9.825392962e-01f, 9.822527170e-01f, 9.819638729e-01f, 9.816727042e-01f, 9.813792109e-01f, 9.810833931e-01f,
+    9.807852507e-01f, 9.804848433e-01f, 9.801821113e-01f, 9.798771143e-01f, 9.795697927e-01f, 9.792601466e-01f, 9.789481759e-01f, 9.786339402e-01f,
+    9.783173800e-01f, 9.779984951e-01f, 9.776773453e-01f, 9.773538709e-01f, 9.770281315e-01f, 9.767000675e-01f, 9.763697386e-01f, 9.760370851e-01f,
+    9.757021070e-01f, 9.753648639e-01f, 9.750253558e-01f, 9.746835232e-01f, 9.743393660e-01f, 9.739929438e-01f, 9.736442566e-01f, 9.732932448e-01f,
+    9.729399681e-01f, 9.725843668e-01f, 9.722265005e-01f, 9.718663096e-01f, 9.715039134e-01f, 9.711391330e-01f, 9.707721472e-01f, 9.704028368e-01f,
+    9.700312614e-01f, 9.696573615e-01f, 9.692812562e-01f, 9.689028263e-01f, 9.685220718e-01f, 9.681391120e-01f, 9.677538276e-01f, 9.673662782e-01f,
+    9.669764638e-01f, 9.665843844e-01f, 9.661899805e-01f, 9.657933712e-01f, 9.653944373e-01f, 9.649932384e-01f, 9.645897746e-01f, 9.641840458e-01f,
+    9.637760520e-01f, 9.633657932e-01f, 9.629532695e-01f, 9.625384808e-01f, 9.621214271e-01f, 9.617020488e-01f, 9.612804651e-01f, 9.608566165e-01f,
+    9.604305029e-01f, 9.600021243e-01f, 9.595715404e-01f, 9.591386318e-01f, 9.587034583e-01f, 9.582660794e-01f, 9.578264356e-01f, 9.573845267e-01f,
+    9.569403529e-01f, 9.564939141e-01f, 9.560452700e-01f, 9.555943608e-01f, 9.551411867e-01f, 9.546857476e-01f, 9.542281032e-01f, 9.537681937e-01f,
+    9.533060193e-01f, 9.528416395e-01f, 9.523749948e-01f, 9.519061446e-01f, 9.514350295e-01f, 9.509616494e-01f, 9.504860640e-01f, 9.500082731e-01f,
+    9.495281577e-01f, 9.490458965e-01f, 9.485613704e-01f, 9.480745792e-01f, 9.475855827e-01f, 9.470943809e-01f, 9.466009140e-01f, 9.461052418e-01f,
+    9.456073046e-01f, 9.451072216e-01f, 9.446048141e-01f, 9.441002607e-01f, 9.435934424e-01f, 9.430844188e-01f, 9.425731897e-01f, 9.420597553e-01f,
+    9.415440559e-01f, 9.410261512e-01f, 9.405060410e-01f, 9.399837255e-01f, 9.394592047e-01f, 9.389324784e-01f, 9.384035468e-01f, 9.378723502e-01f,
+    9.373390079e-01f, 9.368034601e-01f, 9.362656474e-01f, 9.357256889e-01f, 9.351835251e-01f, 9.346391559e-01f, 9.340925217e-01f, 9.335438013e-01f,
+    9.329928160e-01f, 9.324396253e-01f, 9.318842888e-01f, 9.313266873e-01f, 9.307669401e-01f, 9.302050471e-01f, 9.296408892e-01f, 9.290745854e-01f,
+    9.285060763e-01f, 9.279354215e-01f, 9.273625016e-01f, 9.267874956e-01f, 9.262102246e-01f, 9.256308079e-01f, 9.250492454e-01f, 9.244654775e-01f,
+    9.238795042e-01f, 9.232914448e-01f, 9.227011204e-01f, 9.221086502e-01f, 9.215140343e-01f, 9.209172130e-01f, 9.203183055e-01f, 9.197171330e-01f,
+    9.191138744e-01f, 9.185084105e-01f, 9.179008007e-01f, 9.172909856e-01f, 9.166790843e-01f, 9.160649776e-01f, 9.154487252e-01f, 9.148303270e-01f,
+    9.142097831e-01f, 9.135870337e-01f, 9.129621983e-01f, 9.123351574e-01f, 9.117060304e-01f, 9.110747576e-01f, 9.104412794e-01f, 9.098057151e-01f,
+    9.091680050e-01f, 9.085280895e-01f, 9.078860879e-01f, 9.072420001e-01f, 9.065957069e-01f, 9.059472680e-01f, 9.052967429e-01f, 9.046440721e-01f,
+    9.039893150e-01f, 9.033323526e-01f, 9.026733041e-01f, 9.020121694e-01f, 9.013488293e-01f, 9.006834030e-01f, 9.000158906e-01f, 8.993462324e-01f,
+    8.986744881e-01f, 8.980005980e-01f, 8.973245621e-01f, 8.966464996e-01f, 8.959662318e-01f, 8.952839375e-01f, 8.945994973e-01f, 8.939129710e-01f,
+    8.932242990e-01f, 8.925335407e-01f, 8.918406963e-01f, 8.911457658e-01f, 8.904487491e-01f, 8.897495866e-01f, 8.890483379e-01f, 8.883450627e-01f,
+    8.876396418e-01f, 8.869321346e-01f, 8.862225413e-01f, 8.855108619e-01f, 8.847970963e-01f, 8.840812445e-01f, 8.833633661e-01f, 8.826433420e-01f,
+    8.819212914e-01f, 8.811970949e-01f, 8.804708719e-01f, 8.797426224e-01f, 8.790122271e-01f, 8.782798052e-01f, 8.775452971e-01f, 8.768087029e-01f,
+    8.760700822e-01f, 8.753293753e-01f, 8.745866418e-01f, 8.738418221e-01f, 8.730949759e-01f, 8.723460436e-01f, 8.715950847e-01f, 8.708420396e-01f,
+    8.700869679e-01f, 8.693298697e-01f, 8.685706854e-01f, 8.678094745e-01f, 8.670462370e-01f, 8.662809730e-01f, 8.655136228e-01f, 8.647442460e-01f,
+    8.639728427e-01f, 8.631994128e-01f, 8.624239564e-01f, 8.616464734e-01f, 8.608669639e-01f, 8.600853682e-01f, 8.593018055e-01f, 8.585162163e-01f,
+    8.577286005e-01f, 8.569389582e-01f, 8.561473489e-01f, 8.553536534e-01f, 8.545579910e-01f, 8.537603021e-01f, 8.529605865e-01f, 8.521589041e-01f,
+    8.513551950e-01f, 8.505494595e-01f, 8.497417569e-01f, 8.489320278e-01f, 8.481203318e-01f, 8.473066092e-01f, 8.464909196e-01f, 8.456732631e-01f,
+    8.448535800e-01f, 8.440318704e-01f, 8.432082534e-01f, 8.423826098e-01f, 8.415549994e-01f, 8.407253623e-01f, 8.398938179e-01f, 8.390602469e-01f,
+    8.382247090e-01f, 8.373872042e-01f, 8.365477324e-01f, 8.357062936e-01f, 8.348628879e-01f, 8.340175152e-01f, 8.331701756e-01f, 8.323208690e-01f,
+    8.314695954e-01f, 8.306164145e-01f, 8.297612071e-01f, 8.289040923e-01f, 8.280450702e-01f, 8.271840215e-01f, 8.263210654e-01f, 8.254561424e-01f,
+    8.245893121e-01f, 8.237205148e-01f, 8.228498101e-01f, 8.219771385e-01f, 8.211025000e-01f, 8.202259541e-01f, 8.193475008e-01f, 8.184671402e-01f,
+    8.175848126e-01f, 8.167005777e-01f, 8.158144355e-01f, 8.149263263e-01f, 8.140363097e-01f, 8.131443858e-01f, 8.122506142e-01f, 8.113548756e-01f,
+    8.104571700e-01f, 8.095576167e-01f, 8.086561561e-01f, 8.077528477e-01f, 8.068475723e-01f, 8.059403896e-01f, 8.050313592e-01f, 8.041203618e-01f,
+    8.032075167e-01f, 8.022928238e-01f, 8.013761640e-01f, 8.004576564e-01f, 7.995372415e-01f, 7.986149788e-01f, 7.976908684e-01f, 7.967647910e-01f,
+    7.958369255e-01f, 7.949071527e-01f, 7.939754725e-01f, 7.930419445e-01f, 7.921065688e-01f, 7.911693454e-01f, 7.902302146e-01f, 7.892892361e-01f,
+    7.883464098e-01f, 7.874017358e-01f, 7.864552140e-01f, 7.855068445e-01f, 7.845565677e-01f, 7.836045027e-01f, 7.826505899e-01f, 7.816948295e-01f,
+    7.807372212e-01f, 7.797777653e-01f, 7.788165212e-01f, 7.778534293e-01f, 7.768884897e-01f, 7.759217024e-01f, 7.749531269e-01f, 7.739827037e-01f,
+    7.730104327e-01f, 7.720363736e-01f, 7.710605264e-01f, 7.700828314e-01f, 7.691033483e-01f, 7.681220174e-01f, 7.671388984e-01f, 7.661539912e-01f,
+    7.651672363e-01f, 7.641787529e-01f, 7.631884217e-01f, 7.621963024e-01f, 7.612023950e-01f, 7.602066994e-01f, 7.592092156e-01f, 7.582098842e-01f,
+    7.572088242e-01f, 7.562059760e-01f, 7.552013993e-01f, 7.541949749e-01f, 7.531868219e-01f, 7.521768212e-01f, 7.511651516e-01f, 7.501516342e-01f,
+    7.491363883e-01f, 7.481193542e-01f, 7.471005917e-01f, 7.460801005e-01f, 7.450577617e-01f, 7.440337539e-01f, 7.430079579e-01f, 7.419804335e-01f,
+    7.409511209e-01f, 7.399200797e-01f, 7.388873100e-01f, 7.378528118e-01f, 7.368165851e-01f, 7.357785702e-01f, 7.347388864e-01f, 7.336974144e-01f,
+    7.326542735e-01f, 7.316094041e-01f, 7.305627465e-01f, 7.295144200e-01f, 7.284643650e-01f, 7.274126410e-01f, 7.263591290e-01f, 7.253039479e-01f,
+    7.242470980e-01f, 7.231884599e-01f, 7.221282125e-01f, 7.210661769e-01f, 7.200025320e-01f, 7.189370990e-01f, 7.178700566e-01f, 7.168012857e-01f,
+    7.157308459e-01f, 7.146586776e-01f, 7.135848403e-01f, 7.125093937e-01f, 7.114322186e-01f, 7.103533745e-01f, 7.092728019e-01f, 7.081906199e-01f,
+    7.071067691e-01f, 7.060212493e-01f, 7.049340606e-01f, 7.038452625e-01f, 7.027547359e-01f, 7.016626000e-01f, 7.005687952e-01f, 6.994733214e-01f,
+    6.983762383e-01f, 6.972774863e-01f, 6.961771250e-01f, 6.950750947e-01f, 6.939714551e-01f, 6.928661466e-01f, 6.917592287e-01f, 6.906507015e-01f,
+    6.895405650e-01f, 6.884287596e-01f, 6.873153448e-01f, 6.862003207e-01f, 6.850836873e-01f, 6.839653850e-01f, 6.828455329e-01f, 6.817240715e-01f,
+    6.806010008e-01f, 6.794763207e-01f, 6.783500314e-01f, 6.772221923e-01f, 6.760926843e-01f, 6.749616265e-01f, 6.738290191e-01f, 6.726947427e-01f,
+    6.715589762e-01f, 6.704215407e-01f, 6.692826152e-01f, 6.681420207e-01f, 6.669999361e-01f, 6.658562422e-01f, 6.647109985e-01f, 6.635641456e-01f,
+    6.624158025e-01f, 6.612658501e-01f, 6.601143479e-01f, 6.589612961e-01f, 6.578066945e-01f, 6.566505432e-01f, 6.554928422e-01f, 6.543335915e-01f,
+    6.531728506e-01f, 6.520105600e-01f, 6.508466601e-01f, 6.496813297e-01f, 6.485143900e-01f, 6.473459601e-01f, 6.461760402e-01f, 6.450045109e-01f,
+    6.438315511e-01f, 6.426570415e-01f, 6.414810419e-01f, 6.403034925e-01f, 6.391244531e-01f, 6.379439235e-01f, 6.367618442e-01f, 6.355783343e-01f,
+    6.343932748e-01f, 6.332067847e-01f, 6.320187449e-01f, 6.308292150e-01f, 6.296382546e-01f, 6.284457445e-01f, 6.272518039e-01f, 6.260563731e-01f,
+    6.248595119e-01f, 6.236611009e-01f, 6.224612594e-01f, 6.212599874e-01f, 6.200572252e-01f, 6.188529730e-01f, 6.176472902e-01f, 6.164401770e-01f,
+    6.152315736e-01f, 6.140215397e-01f, 6.128100753e-01f, 6.115971804e-01f, 6.103827953e-01f, 6.091670394e-01f, 6.079497933e-01f, 6.067311168e-01f,
+    6.055110693e-01f, 6.042895317e-01f, 6.030666232e-01f, 6.018422246e-01f, 6.006164551e-01f, 5.993893147e-01f, 5.981606841e-01f, 5.969306827e-01f,
+    5.956993103e-01f, 5.944665074e-01f, 5.932322741e-01f, 5.919966698e-01f, 5.907596946e-01f, 5.895212889e-01f, 5.882815719e-01f, 5.870403647e-01f,
+    5.857978463e-01f, 5.845539570e-01f, 5.833086371e-01f, 5.820620060e-01f, 5.808139443e-01f, 5.795645714e-01f, 5.783137679e-01f, 5.770616531e-01f,
+    5.758081675e-01f, 5.745533705e-01f, 5.732971430e-01f, 5.720396042e-01f, 5.707807541e-01f, 5.695205331e-01f, 5.682589412e-01f, 5.669960380e-01f,
+    5.657318234e-01f, 5.644662380e-01f, 5.631993413e-01f, 5.619311333e-01f, 5.606615543e-01f, 5.593907237e-01f, 5.581185222e-01f, 5.568450093e-01f,
+    5.555702448e-01f, 5.542941093e-01f, 5.530167222e-01f, 5.517379642e-01f, 5.504579544e-01f, 5.491766334e-01f, 5.478940606e-01f, 5.466101766e-01f,
+    5.453249812e-01f, 5.440385342e-01f, 5.427507758e-01f, 5.414617658e-01f, 5.401714444e-01f, 5.388799310e-01f, 5.375870466e-01f, 5.362929702e-01f,
+    5.349976420e-01f, 5.337010026e-01f, 5.324031115e-01f, 5.311040282e-01f, 5.298036337e-01f, 5.285019875e-01f, 5.271991491e-01f, 5.258949995e-01f,
+    5.245896578e-01f, 5.232831240e-01f, 5.219752789e-01f, 5.206662416e-01f, 5.193560123e-01f, 5.180445313e-01f, 5.167317986e-01f, 5.154178739e-01f,
+    5.141027570e-01f, 5.127863884e-01f, 5.114688277e-01f, 5.101500750e-01f, 5.088301301e-01f, 5.075089931e-01f, 5.061866641e-01f, 5.048630834e-01f,
+    5.035383701e-01f, 5.022124648e-01f, 5.008853674e-01f, 4.995571077e-01f, 4.982276559e-01f, 4.968970418e-01f, 4.955652654e-01f, 4.942322969e-01f,
+    4.928981960e-01f, 4.915629029e-01f, 4.902264774e-01f, 4.888888896e-01f, 4.875501692e-01f, 4.862102866e-01f, 4.848692417e-01f, 4.835270643e-01f,
+    4.821837842e-01f, 4.808393419e-01f, 4.794937670e-01f, 4.781470597e-01f, 4.767992198e-01f, 4.754502773e-01f, 4.741002023e-01f, 4.727490246e-01f,
+    4.713967443e-01f, 4.700433314e-01f, 4.686888158e-01f, 4.673331976e-01f, 4.659765065e-01f, 4.646186829e-01f, 4.632597864e-01f, 4.618997872e-01f,
+    4.605387151e-01f, 4.591765404e-01f, 4.578132927e-01f, 4.564489722e-01f, 4.550835788e-01f, 4.537171125e-01f, 4.523495734e-01f, 4.509809911e-01f,
+    4.496113360e-01f, 4.482406080e-01f, 4.468688369e-01f, 4.454960227e-01f, 4.441221356e-01f, 4.427472353e-01f, 4.413712621e-01f, 4.399942756e-01f,
+    4.386162460e-01f, 4.372371733e-01f, 4.358570874e-01f, 4.344759583e-01f, 4.330938160e-01f, 4.317106605e-01f, 4.303264916e-01f, 4.289412796e-01f,
+    4.275550842e-01f, 4.261678755e-01f, 4.247796834e-01f, 4.233904779e-01f, 4.220002592e-01f, 4.206090868e-01f, 4.192169011e-01f, 4.178237021e-01f,
+    4.164295495e-01f, 4.150344133e-01f, 4.136383235e-01f, 4.122412205e-01f, 4.108431637e-01f, 4.094441533e-01f, 4.080441594e-01f, 4.066432118e-01f,
+    4.052413106e-01f, 4.038384557e-01f, 4.024346471e-01f, 4.010298848e-01f, 3.996241987e-01f, 3.982175589e-01f, 3.968099952e-01f, 3.954014778e-01f,
+    3.939920366e-01f, 3.925816715e-01f, 3.911703825e-01f, 3.897581697e-01f, 3.883450329e-01f, 3.869310021e-01f, 3.855160475e-01f, 3.841001987e-01f,
+    3.826834261e-01f, 3.812657595e-01f, 3.798471987e-01f, 3.784277439e-01f, 3.770074248e-01f, 3.755861819e-01f, 3.741640747e-01f, 3.727410734e-01f,
+    3.713172078e-01f, 3.698924482e-01f, 3.684668243e-01f, 3.670403361e-01f, 3.656129837e-01f, 3.641847968e-01f, 3.627557158e-01f, 3.613258004e-01f,
+    3.598950505e-01f, 3.584634066e-01f, 3.570309579e-01f, 3.555976748e-01f, 3.541635275e-01f, 3.527285457e-01f, 3.512927592e-01f, 3.498561382e-01f,
+    3.484186828e-01f, 3.469804227e-01f, 3.455413282e-01f, 3.441014290e-01f, 3.426607251e-01f, 3.412192166e-01f, 3.397768736e-01f, 3.383337557e-01f,
+    3.368898630e-01f, 3.354451358e-01f, 3.339996636e-01f, 3.325533569e-01f, 3.311063051e-01f, 3.296584487e-01f, 3.282098472e-01f, 3.267604411e-01f,
+    3.253102899e-01f, 3.238593638e-01f, 3.224076927e-01f, 3.209552467e-01f, 3.195020258e-01f, 3.180480897e-01f, 3.165933788e-01f, 3.151379228e-01f,
+    3.136817515e-01f, 3.122248054e-01f, 3.107671440e-01f, 3.093087673e-01f, 3.078496456e-01f, 3.063898087e-01f, 3.049292266e-01f, 3.034679592e-01f,
+    3.020059466e-01f, 3.005432487e-01f, 2.990798354e-01f, 2.976157069e-01f, 2.961508930e-01f, 2.946853638e-01f, 2.932191491e-01f, 2.917522490e-01f,
+    2.902846634e-01f, 2.888164222e-01f, 2.873474658e-01f, 2.858778238e-01f, 2.844075263e-01f, 2.829365730e-01f, 2.814649343e-01f, 2.799926400e-01f,
+    2.785196900e-01f, 2.770460844e-01f, 2.755718231e-01f, 2.740969062e-01f, 2.726213634e-01f, 2.711451650e-01f, 2.696683109e-01f, 2.681908607e-01f,
+    2.667127550e-01f, 2.652340233e-01f, 2.637546659e-01f, 2.622747123e-01f, 2.607941031e-01f, 2.593129277e-01f, 2.578310966e-01f, 2.563486695e-01f,
+    2.548656464e-01f, 2.533820271e-01f, 2.518978119e-01f, 2.504130006e-01f, 2.489276081e-01f, 2.474416196e-01f, 2.459550500e-01f, 2.444678992e-01f,
+    2.429801822e-01f, 2.414918840e-01f, 2.400030196e-01f, 2.385135889e-01f, 2.370236069e-01f, 2.355330586e-01f, 2.340419590e-01f, 2.325503081e-01f,
+    2.310581058e-01f, 2.295653671e-01f, 2.280720770e-01f, 2.265782654e-01f, 2.250839174e-01f, 2.235890329e-01f, 2.220936269e-01f, 2.205976844e-01f,
+    2.191012353e-01f, 2.176042795e-01f, 2.161068022e-01f, 2.146088183e-01f, 2.131103128e-01f, 2.116113305e-01f, 2.101118416e-01f, 2.086118460e-01f,
+    2.071113735e-01f, 2.056104094e-01f, 2.041089684e-01f, 2.026070356e-01f, 2.011046410e-01f, 1.996017545e-01f, 1.980984062e-01f, 1.965945959e-01f,
+    1.950903237e-01f, 1.935855895e-01f, 1.920803934e-01f, 1.905747503e-01f, 1.890686601e-01f, 1.875621229e-01f, 1.860551536e-01f, 1.845477372e-01f,
+    1.830398887e-01f, 1.815316081e-01f, 1.800228953e-01f, 1.785137653e-01f, 1.770042181e-01f, 1.754942536e-01f, 1.739838719e-01f, 1.724730879e-01f,
+    1.709618866e-01f, 1.694502980e-01f, 1.679382920e-01f, 1.664258987e-01f, 1.649131179e-01f, 1.633999497e-01f, 1.618863940e-01f, 1.603724509e-01f,
+    1.588581502e-01f, 1.573434621e-01f, 1.558284014e-01f, 1.543129683e-01f, 1.527971923e-01f, 1.512810439e-01f, 1.497645378e-01f, 1.482476741e-01f,
+    1.467304677e-01f, 1.452129185e-01f, 1.436950266e-01f, 1.421768069e-01f, 1.406582445e-01f, 1.391393393e-01f, 1.376201212e-01f, 1.361005753e-01f,
+    1.345807016e-01f, 1.330605298e-01f, 1.315400302e-01f, 1.300192177e-01f, 1.284981072e-01f, 1.269766986e-01f, 1.254549772e-01f, 1.239329726e-01f,
+    1.224106774e-01f, 1.208880842e-01f, 1.193652153e-01f, 1.178420633e-01f, 1.163186282e-01f, 1.147949249e-01f, 1.132709533e-01f, 1.117467135e-01f,
+    1.102222055e-01f, 1.086974442e-01f, 1.071724221e-01f, 1.056471542e-01f, 1.041216329e-01f, 1.025958657e-01f, 1.010698602e-01f, 9.954361618e-02f,
+    9.801714122e-02f, 9.649042785e-02f, 9.496349841e-02f, 9.343633801e-02f, 9.190895408e-02f, 9.038136154e-02f, 8.885355294e-02f, 8.732553571e-02f,
+    8.579730988e-02f, 8.426889032e-02f, 8.274026215e-02f, 8.121144772e-02f, 7.968243957e-02f, 7.815324515e-02f, 7.662386447e-02f, 7.509429753e-02f,
+    7.356456667e-02f, 7.203464955e-02f, 7.050457597e-02f, 6.897433102e-02f, 6.744392216e-02f, 6.591334939e-02f, 6.438262761e-02f, 6.285175681e-02f,
+    6.132073700e-02f, 5.978957191e-02f, 5.825826526e-02f, 5.672682077e-02f, 5.519524589e-02f, 5.366353691e-02f, 5.213170499e-02f, 5.059975013e-02f,
+    4.906767607e-02f, 4.753548279e-02f, 4.600318149e-02f, 4.447077215e-02f, 4.293825850e-02f, 4.140564054e-02f, 3.987292573e-02f, 3.834012151e-02f,
+    3.680722415e-02f, 3.527423739e-02f, 3.374117240e-02f, 3.220802546e-02f, 3.067480400e-02f, 2.914150804e-02f, 2.760814503e-02f, 2.607471868e-02f,
+    2.454122901e-02f, 2.300768159e-02f, 2.147408016e-02f, 1.994042844e-02f, 1.840673015e-02f, 1.687298715e-02f, 1.533920597e-02f, 1.380538847e-02f,
+    1.227153838e-02f, 1.073765941e-02f, 9.203754365e-03f, 7.669828832e-03f, 6.135884672e-03f, 4.601926077e-03f, 3.067956772e-03f, 1.533980132e-03f,
+    0.000000000e+00f
+};
+
+/** cos * 32767 */
+static const int16_t fft_cos_table_q15[1025] =
+{
+    32767, 32767, 32767, 32767, 32766, 32766, 32766, 32765,
+    32765, 32764, 32763, 32762, 32761, 32760, 32759, 32758,
+    32757, 32756, 32755, 32753, 32752, 32750, 32748, 32747,
+    32745, 32743, 32741, 32739, 32737, 32735, 32732, 32730,
+    32728, 32725, 32722, 32720, 32717, 32714, 32711, 32708,
+    32705, 32702, 32699, 32696, 32692, 32689, 32685, 32682,
+    32678, 32674, 32671, 32667, 32663, 32659, 32655, 32650,
+    32646, 32642, 32637, 32633, 32628, 32624, 32619, 32614,
+    32609, 32604, 32599, 32594, 32589, 32584, 32578, 32573,
+    32567, 32562, 32556, 32550, 32545, 32539, 32533, 32527,
+    32521, 32514, 32508, 32502, 32495, 32489, 32482, 32476,
+    32469, 32462, 32455, 32448, 32441, 32434, 32427, 32420,
+    32412, 32405, 32397, 32390, 32382, 32375, 32367, 32359,
+    32351, 32343, 32335, 32327, 32318, 32310, 32302, 32293,
+    32285, 32276, 32267, 32258, 32250, 32241, 32232, 32223,
+    32213, 32204, 32195, 32185, 32176, 32166, 32157, 32147,
+    32137, 32128, 32118, 32108, 32098, 32087, 32077, 32067,
+    32057, 32046, 32036, 32025, 32014, 32004, 31993, 31982,
+    31971, 31960, 31949, 31937, 31926, 31915, 31903, 31892,
+    31880, 31869, 31857, 31845, 31833, 31821, 31809, 31797,
+    31785, 31773, 31760, 31748, 31736, 31723, 31710, 31698,
+    31685, 31672, 31659, 31646, 31633, 31620, 31607, 31593,
+    31580, 31567, 31553, 31539, 31526, 31512, 31498, 31484,
+    31470, 31456, 31442, 31428, 31414, 31400, 31385, 31371,
+    31356, 31341, 31327, 31312, 31297, 31282, 31267, 31252,
+    31237, 31222, 31206, 31191, 31176, 31160, 31145, 31129,
+    31113, 31097, 31082, 31066, 31050, 31033, 31017, 31001,
+    30985, 30968, 30952, 30935, 30919, 30902, 30885, 30868,
+    30852, 30835, 30818, 30800, 30783, 30766, 30749, 30731,
+    30714, 30696, 30679, 30661, 30643, 30625, 30607, 30589,
+    30571, 30553, 30535, 30517, 30498, 30480, 30462, 30443,
+    30424, 30406, 30387, 30368, 30349, 30330, 30311, 30292,
+    30273, 30253, 30234, 30215, 30195, 30176, 30156, 30136,
+    30117, 30097, 30077, 30057, 30037, 30017, 29997, 29976,
+    29956, 29936, 29915, 29894, 29874, 29853, 29832, 29812,
+    29791, 29770, 29749, 29728, 29706, 29685, 29664, 29642,
+    29621, 29599, 29578, 29556, 29534, 29513, 29491, 29469,
+    29447, 29425, 29403, 29380, 29358, 29336, 29313, 29291,
+    29268, 29246, 29223, 29200, 29177, 29154, 29131, 29108,
+    29085, 29062, 29039, 29016, 28992, 28969, 28945, 28922,
+    28898, 28874, 28850, 28827, 28803, 28779, 28755, 28730,
+    28706, 28682, 28658, 28633, 28609, 28584, 28560, 28535,
+    28510, 28485, 28460, 28436, 28411, 28385, 28360, 28335,
+    28310, 28284, 28259, 28234, 28208, 28182, 28157, 28131,
+    28105, 28079, 28053, 28027, 28001, 27975, 27949, 27923,
+    27896, 27870, 27843, 27817, 27790, 27764, 27737, 27710,
+    27683, 27656, 27629, 27602, 27575, 27548, 27521, 27493,
+    27466, 27439, 27411, 27384, 27356, 27328, 27300, 27273,
+    27245, 27217, 27189, 27161, 27133, 27104, 27076, 27048,
+    27019, 26991, 26962, 26934, 26905, 26876, 26848, 26819,
+    26790, 26761, 26732, 26703, 26674, 26644, 26615, 26586,
+    26556, 26527, 26497, 26468, 26438, 26408, 26378, 26349,
+    26319, 26289, 26259, 26229, 26198, 26168, 26138, 26108,
+    26077, 26047, 26016, 25986, 25955, 25924, 25893, 25863,
+    25832, 25801, 25770, 25739, 25708, 25676, 25645, 25614,
+    25582, 25551, 25519, 25488, 25456, 25425, 25393, 25361,
+    25329, 25297, 25265, 25233, 25201, 25169, 25137, 25105,
+    25072, 25040, 25007, 24975, 24942, 24910, 24877, 24844,
+    24811, 24779, 24746, 24713, 24680, 24647, 24613, 24580,
+    24547, 24514, 24480, 24447, 24413, 24380, 24346, 24312,
+    24279, 24245, 24211, 24177, 24143, 24109, 24075, 24041,
+    24007, 23973, 23938, 23904, 23870, 23835, 23801, 23766,
+    23731, 23697, 23662, 23627, 23592, 23557, 23522, 23487,
+    23452, 23417, 23382, 23347, 23311, 23276, 23241, 23205,
+    23170, 23134, 23099, 23063, 23027, 22991, 22956, 22920,
+    22884, 22848, 22812, 22776, 22739, 22703, 22667, 22631,
+    22594, 22558, 22521, 22485, 22448, 22411, 22375, 22338,
+    22301, 22264, 22227, 22191, 22154, 22116, 22079, 22042,
+    22005, 21968, 21930, 21893, 21856, 21818, 21781, 21743,
+    21705, 21668, 21630, 21592, 21554, 21516, 21479, 21441,
+    21403, 21364, 21326, 21288, 21250, 21212, 21173, 21135,
+    21096, 21058, 21019, 20981, 20942, 20904, 20865, 20826,
+    20787, 20748, 20709, 20670, 20631, 20592, 20553, 20514,
+    20475, 20436, 20396, 20357, 20317, 20278, 20238, 20199,
+    20159, 20120, 20080, 20040, 20000, 19961, 19921, 19881,
+    19841, 19801, 19761, 19721, 19680, 19640, 19600, 19560,
+    19519, 19479, 19438, 19398, 19357, 19317, 19276, 19236,
+    19195, 19154, 19113, 19072, 19032, 18991, 18950, 18909,
+    18868, 18826, 18785, 18744, 18703, 18661, 18620, 18579,
+    18537, 18496, 18454, 18413, 18371, 18330, 18288, 18246,
+    18204, 18163, 18121, 18079, 18037, 17995, 17953, 17911,
+    17869, 17827, 17784, 17742, 17700, 17657, 17615, 17573,
+    17530, 17488, 17445, 17403, 17360, 17317, 17275, 17232,
+    17189, 17146, 17104, 17061, 17018, 16975, 16932, 16889,
+    16846, 16802, 16759, 16716, 16673, 16630, 16586, 16543,
+    16499, 16456, 16413, 16369, 16325, 16282, 16238, 16195,
+    16151, 16107, 16063, 16019, 15976, 15932, 15888, 15844,
+    15800, 15756, 15712, 15667, 15623, 15579, 15535, 15491,
+    15446, 15402, 15358, 15313, 15269, 15224, 15180, 15135,
+    15090, 15046, 15001, 14956, 14912, 14867, 14822, 14777,
+    14732, 14688, 14643, 14598, 14553, 14507, 14462, 14417,
+    14372, 14327, 14282, 14236, 14191, 14146, 14101, 14055,
+    14010, 13964, 13919, 13873, 13828, 13782, 13736, 13691,
+    13645, 13599, 13554, 13508, 13462, 13416, 13370, 13324,
+    13279, 13233, 13187, 13141, 13094, 13048, 13002, 12956,
+    12910, 12864, 12817, 12771, 12725, 12679, 12632, 12586,
+    12539, 12493, 12446, 12400, 12353, 12307, 12260, 12214,
+    12167, 12120, 12074, 12027, 11980, 11933, 11886, 11840,
+    11793, 11746, 11699, 11652, 11605, 11558, 11511, 11464,
+    11417, 11370, 11322, 11275, 11228, 11181, 11133, 11086,
+    11039, 10992, 10944, 10897, 10849, 10802, 10754, 10707,
+    10659, 10612, 10564, 10517, 10469, 10421, 10374, 10326,
+    10278, 10231, 10183, 10135, 10087, 10039, 9992, 9944,
+    9896, 9848, 9800, 9752, 9704, 9656, 9608, 9560,
+    9512, 9464, 9416, 9367, 9319, 9271, 9223, 9175,
+    9126, 9078, 9030, 8981, 8933, 8885, 8836, 8788,
+    8739, 8691, 8642, 8594, 8545, 8497, 8448, 8400,
+    8351, 8303, 8254, 8205, 8157, 8108, 8059, 8010,
+    7962, 7913, 7864, 7815, 7767, 7718, 7669, 7620,
+    7571, 7522, 7473, 7424, 7375, 7326, 7277, 7228,
+    7179, 7130, 7081, 7032, 6983, 6934, 6885, 6836,
+    6786, 6737, 6688, 6639, 6590, 6540, 6491, 6442,
+    6393, 6343, 6294, 6245, 6195, 6146, 6096, 6047,
+    5998, 5948, 5899, 5849, 5800, 5750, 5701, 5651,
+    5602, 5552, 5503, 5453, 5404, 5354, 5305, 5255,
+    5205, 5156, 5106, 5056, 5007, 4957, 4907, 4858,
+    4808, 4758, 4708, 4659, 4609, 4559, 4509, 4460,
+    4410, 4360, 4310, 4260, 4210, 4161, 4111, 4061,
+    4011, 3961, 3911, 3861, 3811, 3761, 3712, 3662,
+    3612, 3562, 3512, 3462, 3412, 3362, 3312, 3262,
+    3212, 3162, 3112, 3062, 3012, 2962, 2911, 2861,
+    2811, 2761, 2711, 2661, 2611, 2561, 2511, 2461,
+    2410, 2360, 2310, 2260, 2210, 2160, 2110, 2059,
+    2009, 1959, 1909, 1859, 1809, 1758, 1708, 1658,
+    1608, 1558, 1507, 1457, 1407, 1357, 1307, 1256,
+    1206, 1156, 1106, 1055, 1005, 955, 905, 854,
+    804, 754, 704, 653, 603, 553, 503, 452,
+    402, 352, 302, 251, 201, 151, 101, 50,
+    0
+};
+
+/** cos * (2^31 - 1) */
+static const int32_t fft_cos_table_q31[1025] =
+{
+    2147483647, 2147481120, 2147473541, 2147460907, 2147443221, 2147420482, 2147392689, 2147359844,
+    2147321945, 2147278994, 2147230990, 2147177933, 2147119824, 2147056663, 2146988449, 2146915183,
+    2146836865, 2146753496, 2146665075, 2146571602, 2146473079, 2146369504, 2146260880, 2146147204,
+    2146028479, 2145904704, 2145775879, 2145642005, 2145503082, 2145359111, 2145210091, 2145056024,
+    2144896909, 2144732747, 2144563538, 2144389282, 2144209981, 2144025634, 2143836243, 2143641806,
+    2143442325, 2143237801, 2143028233, 2142813623, 2142593970, 2142369275, 2142139540, 2141904763,
+    2141664947, 2141420091, 2141170196, 2140915263, 2140655292, 2140390283, 2140120239, 2139845158,
+    2139565042, 2139279891, 2138989707, 2138694489, 2138394239, 2138088957, 2137778643, 2137463300,
+    2137142926, 2136817524, 2136487094, 2136151636, 2135811152, 2135465641, 2135115106, 2134759547,
+    2134398965, 2134033360, 2133662733, 2133287086, 2132906419, 2132520733, 2132130029, 2131734308,
+    2131333571, 2130927818, 2130517051, 2130101271, 2129680479, 2129254675, 2128823861, 2128388037,
+    2127947205, 2127501366, 2127050521, 2126594671, 2126133816, 2125667959, 2125197099, 2124721239,
+    2124240379, 2123754521, 2123263665, 2122767813, 2122266966, 2121761125, 2121250291, 2120734466,
+    2120213650, 2119687846, 2119157053, 2118621274, 2118080510, 2117534761, 2116984030, 2116428318,
+    2115867625, 2115301953, 2114731304, 2114155679, 2113575079, 2112989505, 2112398959, 2111803443,
+    2111202958, 2110597504, 2109987084, 2109371699, 2108751351, 2108126040, 2107495769, 2106860539,
+    2106220351, 2105575207, 2104925108, 2104270056, 2103610053, 2102945100, 2102275198, 2101600349,
+    2100920555, 2100235818, 2099546138, 2098851518, 2098151959, 2097447463, 2096738031, 2096023666,
+    2095304369, 2094580141, 2093850984, 2093116900, 2092377891, 2091633959, 2090885104, 2090131330,
+    2089372637, 2088609028, 2087840504, 2087067067, 2086288719, 2085505462, 2084717297, 2083924227,
+    2083126253, 2082323378, 2081515602, 2080702929, 2079885359, 2079062895, 2078235539, 2077403293,
+    2076566159, 2075724138, 2074877232, 2074025445, 2073168776, 2072307230, 2071440807, 2070569510,
+    2069693341, 2068812301, 2067926393, 2067035620, 2066139982, 2065239483, 2064334123, 2063423907,
+    2062508835, 2061588909, 2060664132, 2059734507, 2058800035, 2057860718, 2056916559, 2055967559,
+    2055013722, 2054055049, 2053091543, 2052123206, 2051150040, 2050172047, 2049189230, 2048201591,
+    2047209132, 2046211856, 2045209766, 2044202862, 2043191149, 2042174627, 2041153301, 2040127171,
+    2039096240, 2038060512, 2037019987, 2035974669, 2034924561, 2033869664, 2032809981, 2031745515,
+    2030676268, 2029602242, 2028523441, 2027439866, 2026351521, 2025258407, 2024160528, 2023057886,
+    2021950483, 2020838322, 2019721407, 2018599738, 2017473320, 2016342154, 2015206244, 2014065591,
+    2012920200, 2011770072, 2010615209, 2009455616, 2008291295, 2007122247, 2005948477, 2004769986,
+    2003586778, 2002398856, 2001206221, 2000008878, 1998806828, 1997600075, 1996388621, 1995172470,
+    1993951624, 1992726086, 1991495859, 1990260945, 1989021349, 1987777072, 1986528117, 1985274488,
+    1984016188, 1982753219, 1981485584, 1980213287, 1978936330, 1977654716, 1976368449, 1975077532,
+    1973781966, 1972481756, 1971176905, 1969867416, 1968553291, 1967234534, 1965911147, 1964583135,
+    1963250500, 1961913246, 1960571374, 1959224890, 1957873795, 1956518093, 1955157787, 1953792880,
+    1952423376, 1951049278, 1949670588, 1948287311, 1946899450, 1945507007, 1944109986, 1942708391,
+    1941302224, 1939891489, 1938476189, 1937056328, 1935631909, 1934202935, 1932769410, 1931331337,
+    1929888719, 1928441560, 1926989863, 1925533632, 1924072870, 1922607580, 1921137766, 1919663432,
+    1918184580, 1916701215, 1915213339, 1913720957, 1912224072, 1910722687, 1909216806, 1907706432,
+    1906191569, 1904672221, 1903148391, 1901620083, 1900087300, 1898550046, 1897008324, 1895462139,
+    1893911493, 1892356391, 1890796836, 1889232832, 1887664382, 1886091490, 1884514160, 1882932396,
+    1881346201, 1879755579, 1878160534, 1876561069, 1874957188, 1873348896, 1871736195, 1870119090,
+    1868497585, 1866871683, 1865241387, 1863606703, 1861967633, 1860324182, 1858676354, 1857024152,
+    1855367580, 1853706642, 1852041343, 1850371685, 1848697673, 1847019311, 1845336603, 1843649552,
+    1841958164, 1840262440, 1838562387, 1836858007, 1835149305, 1833436285, 1831718951, 1829997306,
+    1828271355, 1826541102, 1824806551, 1823067706, 1821324571, 1819577151, 1817825448, 1816069469,
+    1814309215, 1812544693, 1810775906, 1809002857, 1807225552, 1805443994, 1803658188, 1801868138,
+    1800073848, 1798275322, 1796472564, 1794665579, 1792854372, 1791038945, 1789219304, 1787395453,
+    1785567395, 1783735137, 1781898680, 1780058031, 1778213194, 1776364172, 1774510970, 1772653592,
+    1770792043, 1768926328, 1767056449, 1765182413, 1763304223, 1761421884, 1759535401, 1757644776,
+    1755750016, 1753851125, 1751948106, 1750040965, 1748129706, 1746214334, 1744294852, 1742371266,
+    1740443580, 1738511798, 1736575926, 1734635967, 1732691927, 1730743809, 1728791619, 1726835361,
+    1724875039, 1722910659, 1720942224, 1718969740, 1716993211, 1715012641, 1713028036, 1711039400,
+    1709046738, 1707050055, 1705049354, 1703044642, 1701035921, 1699023199, 1697006478, 1694985764,
+    1692961061, 1690932375, 1688899710, 1686863071, 1684822463, 1682777889, 1680729357, 1678676869,
+    1676620431, 1674560048, 1672495724, 1670427465, 1668355276, 1666279160, 1664199124, 1662115171,
+    1660027308, 1657935538, 1655839867, 1653740299, 1651636840, 1649529495, 1647418268, 1645303165,
+    1643184190, 1641061349, 1638934646, 1636804086, 1634669675, 1632531417, 1630389318, 1628243382,
+    1626093615, 1623940022, 1621782607, 1619621376, 1617456334, 1615287486, 1613114837, 1610938392,
+    1608758157, 1606574136, 1604386334, 1602194757, 1599999410, 1597800298, 1595597427, 1593390801,
+    1591180425, 1588966305, 1586748446, 1584526854, 1582301533, 1580072488, 1577839726, 1575603250,
+    1573363067, 1571119182, 1568871600, 1566620326, 1564365366, 1562106725, 1559844407, 1557578420,
+    1555308767, 1553035454, 1550758488, 1548477871, 1546193612, 1543905714, 1541614182, 1539319024,
+    1537020243, 1534717845, 1532411836, 1530102222, 1527789006, 1525472196, 1523151796, 1520827812,
+    1518500249, 1516169113, 1513834410, 1511496144, 1509154322, 1506808948, 1504460029, 1502107569,
+    1499751575, 1497392052, 1495029005, 1492662441, 1490292364, 1487918780, 1485541695, 1483161114,
+    1480777044, 1478389489, 1475998455, 1473603948, 1471205973, 1468804537, 1466399644, 1463991301,
+    1461579513, 1459164286, 1456745625, 1454323536, 1451898025, 1449469097, 1447036759, 1444601016,
+    1442161874, 1439719338, 1437273414, 1434824108, 1432371426, 1429915373, 1427455956, 1424993179,
+    1422527050, 1420057573, 1417584755, 1415108601, 1412629117, 1410146309, 1407660183, 1405170744,
+    1402677999, 1400181953, 1397682613, 1395179983, 1392674071, 1390164882, 1387652421, 1385136695,
+    1382617710, 1380095471, 1377569985, 1375041257, 1372509294, 1369974101, 1367435684, 1364894050,
+    1362349204, 1359801152, 1357249900, 1354695455, 1352137822, 1349577007, 1347013016, 1344445856,
+    1341875532, 1339302051, 1336725418, 1334145640, 1331562722, 1328976672, 1326387493, 1323795194,
+    1321199780, 1318601257, 1315999631, 1313394908, 1310787095, 1308176197, 1305562221, 1302945173,
+    1300325059, 1297701886, 1295075658, 1292446384, 1289814068, 1287178717, 1284540337, 1281898934,
+    1279254515, 1276607086, 1273956652, 1271303222, 1268646799, 1265987391, 1263325005, 1260659645,
+    1257991319, 1255320033, 1252645793, 1249968606, 1247288477, 1244605413, 1241919421, 1239230506,
+    1236538675, 1233843934, 1231146290, 1228445749, 1225742318, 1223036002, 1220326808, 1217614743,
+    1214899812, 1212182023, 1209461381, 1206737894, 1204011566, 1201282406, 1198550419, 1195815611,
+    1193077990, 1190337561, 1187594332, 1184848308, 1182099495, 1179347901, 1176593532, 1173836395,
+    1171076495, 1168313839, 1165548435, 1162780288, 1160009404, 1157235791, 1154459455, 1151680403,
+    1148898640, 1146114174, 1143327011, 1140537157, 1137744620, 1134949406, 1132151521, 1129350972,
+    1126547765, 1123741907, 1120933406, 1118122266, 1115308496, 1112492101, 1109673088, 1106851464,
+    1104027236, 1101200410, 1098370992, 1095538990, 1092704410, 1089867259, 1087027543, 1084185270,
+    1081340445, 1078493075, 1075643168, 1072790730, 1069935767, 1067078287, 1064218296, 1061355800,
+    1058490807, 1055623324, 1052753356, 1049880911, 1047005996, 1044128617, 1041248781, 1038366495,
+    1035481765, 1032594599, 1029705003, 1026812985, 1023918549, 1021021705, 1018122458, 1015220815,
+    1012316784, 1009410370, 1006501581, 1003590423, 1000676905, 997761031, 994842809, 991922247,
+    988999351, 986074127, 983146583, 980216725, 977284561, 974350098, 971413341, 968474299,
+    965532978, 962589385, 959643527, 956695410, 953745043, 950792431, 947837582, 944880502,
+    941921200, 938959680, 935995952, 933030020, 930061894, 927091578, 924119082, 921144410,
+    918167571, 915188572, 912207419, 909224120, 906238681, 903251109, 900261412, 897269597,
+    894275670, 891279640, 888281511, 885281293, 882278991, 879274614, 876268167, 873259658,
+    870249095, 867236484, 864221832, 861205146, 858186434, 855165703, 852142959, 849118210,
+    846091463, 843062725, 840032003, 836999305, 833964637, 830928007, 827889421, 824848888,
+    821806413, 818762005, 815715670, 812667415, 809617248, 806565176, 803511207, 800455346,
+    797397602, 794337981, 791276492, 788213140, 785147934, 782080880, 779011986, 775941259,
+    772868706, 769794334, 766718151, 763640163, 760560379, 757478805, 754395449, 751310318,
+    748223418, 745134758, 742044345, 738952185, 735858287, 732762657, 729665303, 726566232,
+    723465451, 720362968, 717258790, 714152924, 711045377, 707936157, 704825272, 701712728,
+    698598533, 695482694, 692365218, 689246113, 686125386, 683003045, 679879097, 676753549,
+    673626408, 670497682, 667367379, 664235505, 661102068, 657967075, 654830534, 651692453,
+    648552837, 645411696, 642269036, 639124865, 635979190, 632832018, 629683357, 626533214,
+    623381597, 620228514, 617073970, 613917975, 610760535, 607601658, 604441351, 601279622,
+    598116478, 594951927, 591785976, 588618632, 585449903, 582279796, 579108319, 575935480,
+    572761285, 569585743, 566408860, 563230644, 560051103, 556870245, 553688076, 550504604,
+    547319836, 544133781, 540946445, 537757837, 534567963, 531376831, 528184448, 524990823,
+    521795963, 518599875, 515402566, 512204045, 509004318, 505803393, 502601279, 499397981,
+    496193509, 492987869, 489781069, 486573116, 483364019, 480153784, 476942419, 473729932,
+    470516330, 467301621, 464085813, 460868912, 457650927, 454431865, 451211734, 447990541,
+    444768293, 441545000, 438320667, 435095303, 431868915, 428641510, 425413098, 422183684,
+    418953276, 415721883, 412489512, 409256170, 406021864, 402786604, 399550396, 396313247,
+    393075166, 389836160, 386596237, 383355404, 380113669, 376871039, 373627523, 370383127,
+    367137860, 363891729, 360644742, 357396906, 354148229, 350898719, 347648383, 344397229,
+    341145265, 337892498, 334638936, 331384586, 328129457, 324873555, 321616889, 318359466,
+    315101294, 311842381, 308582734, 305322361, 302061269, 298799466, 295536961, 292273760,
+    289009871, 285745302, 282480061, 279214155, 275947592, 272680379, 269412525, 266144037,
+    262874923, 259605190, 256334847, 253063900, 249792358, 246520228, 243247517, 239974235,
+    236700388, 233425983, 230151030, 226875535, 223599506, 220322951, 217045877, 213768293,
+    210490206, 207211623, 203932553, 200653003, 197372981, 194092494, 190811551, 187530159,
+    184248325, 180966058, 177683365, 174400254, 171116732, 167832808, 164548489, 161263783,
+    157978697, 154693240, 151407418, 148121241, 144834714, 141547847, 138260647, 134973122,
+    131685278, 128397125, 125108670, 121819921, 118530885, 115241570, 111951983, 108662134,
+    105372028, 102081675, 98791081, 95500255, 92209205, 88917937, 85626460, 82334782,
+    79042909, 75750851, 72458615, 69166208, 65873638, 62580914, 59288042, 55995030,
+    52701887, 49408620, 46115236, 42821744, 39528151, 36234466, 32940695, 29646846,
+    26352928, 23058947, 19764913, 16470832, 13176712, 9882561, 6588387, 3294197,
+    0
+};
+
+/** Индекс i с обратным порядком 12 бит */
+static const uint16_t fft_bit_reverse_table[4096] =
+{
+    0, 2048, 1024, 3072, 512, 2560, 1536, 3584,
+    256, 2304, 1280, 3328, 768, 2816, 1792, 3840,
+    128, 2176, 1152, 3200, 640, 2688, 1664, 3712,
+    384, 2432, 1408, 3456, 896, 2944, 1920, 3968,
+    64, 2112, 1088, 3136, 576, 2624, 1600, 3648,
+    320, 2368, 1344, 3392, 832, 2880, 1856, 3904,
+    192, 2240, 1216, 3264, 704, 2752, 1728, 3776,
+    448, 2496, 1472, 3520, 960, 3008, 1984, 4032,
+    32, 2080, 1056, 3104, 544, 2592, 1568, 3616,
+    288, 2336, 1312, 3360, 800, 2848, 1824, 3872,
+    160, 2208, 1184, 3232, 672, 2720, 1696, 3744,
+    416, 2464, 1440, 3488, 928, 2976, 1952, 4000,
+    96, 2144, 1120, 3168, 608, 2656, 1632, 3680,
+    352, 2400, 1376, 3424, 864, 2912, 1888, 3936,
+    224, 2272, 1248, 3296, 736, 2784, 1760, 3808,
+    480, 2528, 1504, 3552, 992, 3040, 2016, 4064,
+    16, 2064, 1040, 3088, 528, 2576, 1552, 3600,
+    272, 2320, 1296, 3344, 784, 2832, 1808, 3856,
+    144, 2192, 1168, 3216, 656, 2704, 1680, 3728,
+    400, 2448, 1424, 3472, 912, 2960, 1936, 3984,
+    80, 2128, 1104, 3152, 592, 2640, 1616, 3664,
+    336, 2384, 1360, 3408, 848, 2896, 1872, 3920,
+    208, 2256, 1232, 3280, 720, 2768, 1744, 3792,
+    464, 2512, 1488, 3536, 976, 3024, 2000, 4048,
+    48, 2096, 1072, 3120, 560, 2608, 1584, 3632,
+    304, 2352, 1328, 3376, 816, 2864, 1840, 3888,
+    176, 2224, 1200, 3248, 688, 2736, 1712, 3760,
+    432, 2480, 1456, 3504, 944, 2992, 1968, 4016,
+    112, 2160, 1136, 3184, 624, 2672, 1648, 3696,
+    368, 2416, 1392, 3440, 880, 2928, 1904, 3952,
+    240, 2288, 1264, 3312, 752, 2800, 1776, 3824,
+    496, 2544, 1520, 3568, 1008, 3056, 2032, 4080,
+    8, 2056, 1032, 3080, 520, 2568, 1544, 3592,
+    264, 2312, 1288, 3336, 776, 2824, 1800, 3848,
+    136, 2184, 1160, 3208, 648, 2696, 1672, 3720,
+    392, 2440, 1416, 3464, 904, 2952, 1928, 3976,
+    72, 2120, 1096, 3144, 584, 2632, 1608, 3656,
+    328, 2376, 1352, 3400, 840, 2888, 1864, 3912,
+    200, 2248, 1224, 3272, 712, 2760, 1736, 3784,
+    456, 2504, 1480, 3528, 968, 3016, 1992, 4040,
+    40, 2088, 1064, 3112, 552, 2600, 1576, 3624,
+    296, 2344, 1320, 3368, 808, 2856, 1832, 3880,
+    168, 2216, 1192, 3240, 680, 2728, 1704, 3752,
+    424, 2472, 1448, 3496, 936, 2984, 1960, 4008,
+    104, 2152, 1128, 3176, 616, 2664, 1640, 3688,
+    360, 2408, 1384, 3432, 872, 2920, 1896, 3944,
+    232, 2280, 1256, 3304, 744, 2792, 1768, 3816,
+    488, 2536, 1512, 3560, 1000, 3048, 2024, 4072,
+    24, 2072, 1048, 3096, 536, 2584, 1560, 3608,
+    280, 2328, 1304, 3352, 792, 2840, 1816, 3864,
+    152, 2200, 1176, 3224, 664, 2712, 1688, 3736,
+    408, 2456, 1432, 3480, 920, 2968, 1944, 3992,
+    88, 2136, 1112, 3160, 600, 2648, 1624, 3672,
+    344, 2392, 1368, 3416, 856, 2904, 1880, 3928,
+    216, 2264, 1240, 3288, 728, 2776, 1752, 3800,
+    472, 2520, 1496, 3544, 984, 3032, 2008, 4056,
+    56, 2104, 1080, 3128, 568, 2616, 1592, 3640,
+    312, 2360, 1336, 3384, 824, 2872, 1848, 3896,
+    184, 2232, 1208, 3256, 696, 2744, 1720, 3768,
+    440, 2488, 1464, 3512, 952, 3000, 1976, 4024,
+    120, 2168, 1144, 3192, 632, 2680, 1656, 3704,
+    376, 2424, 1400, 3448, 888, 2936, 1912, 3960,
+    248, 2296, 1272, 3320, 760, 2808, 1784, 3832,
+    504, 2552, 1528, 3576, 1016, 3064, 2040, 4088,
+    4, 2052, 1028, 3076, 516, 2564, 1540, 3588,
+    260, 2308, 1284, 3332, 772, 2820, 1796, 3844,
+    132, 2180, 1156, 3204, 644, 2692, 1668, 3716,
+    388, 2436, 1412, 3460, 900, 2948, 1924, 3972,
+    68, 2116, 1092, 3140, 580, 2628, 1604, 3652,
+    324, 2372, 1348, 3396, 836, 2884, 1860, 3908,
+    196, 2244, 1220, 3268, 708, 2756, 1732, 3780,
+    452, 2500, 1476, 3524, 964, 3012, 1988, 4036,
+    36, 2084, 1060, 3108, 548, 2596, 1572, 3620,
+    292, 2340, 1316, 3364, 804, 2852, 1828, 3876,
+    164, 2212, 1188, 3236, 676, 2724, 1700, 3748,
+    420, 2468, 1444, 3492, 932, 2980, 1956, 4004,
+    100, 2148, 1124, 3172, 612, 2660, 1636, 3684,
+    356, 2404, 1380, 3428, 868, 2916, 1892, 3940,
+    228, 2276, 1252, 3300, 740, 2788, 1764, 3812,
+    484, 2532, 1508, 3556, 996, 3044, 2020, 4068,
+    20, 2068, 1044, 3092, 532, 2580, 1556, 3604,
+    276, 2324, 1300, 3348, 788, 2836, 1812, 3860,
+    148, 2196, 1172, 3220, 660, 2708, 1684, 3732,
+    404, 2452, 1428, 3476, 916, 2964, 1940, 3988,
+    84, 2132, 1108, 3156, 596, 2644, 1620, 3668,
+    340, 2388, 1364, 3412, 852, 2900, 1876, 3924,
+    212, 2260, 1236, 3284, 724, 2772, 1748, 3796,
+    468, 2516, 1492, 3540, 980, 3028, 2004, 4052,
+    52, 2100, 1076, 3124, 564, 2612, 1588, 3636,
+    308, 2356, 1332, 3380, 820, 2868, 1844, 3892,
+    180, 2228, 1204, 3252, 692, 2740, 1716, 3764,
+    436, 2484, 1460, 3508, 948, 2996, 1972, 4020,
+    116, 2164, 1140, 3188, 628, 2676, 1652, 3700,
+    372, 2420, 1396, 3444, 884, 2932, 1908, 3956,
+    244, 2292, 1268, 3316, 756, 2804, 1780, 3828,
+    500, 2548, 1524, 3572, 1012, 3060, 2036, 4084,
+    12, 2060, 1036, 3084, 524, 2572, 1548, 3596,
+    268, 2316, 1292, 3340, 780, 2828, 1804, 3852,
+    140, 2188, 1164, 3212, 652, 2700, 1676, 3724,
+    396, 2444, 1420, 3468, 908, 2956, 1932, 3980,
+    76, 2124, 1100, 3148, 588, 2636, 1612, 3660,
+    332, 2380, 1356, 3404, 844, 2892, 1868, 3916,
+    204, 2252, 1228, 3276, 716, 2764, 1740, 3788,
+    460, 2508, 1484, 3532, 972, 3020, 1996, 4044,
+    44, 2092, 1068, 3116, 556, 2604, 1580, 3628,
+    300, 2348, 1324, 3372, 812, 2860, 1836, 3884,
+    172, 2220, 1196, 3244, 684, 2732, 1708, 3756,
+    428, 2476, 1452, 3500, 940, 2988, 1964, 4012,
+    108, 2156, 1132, 3180, 620, 2668, 1644, 3692,
+    364, 2412, 1388, 3436, 876, 2924, 1900, 3948,
+    236, 2284, 1260, 3308, 748, 2796, 1772, 3820,
+    492, 2540, 1516, 3564, 1004, 3052, 2028, 4076,
+    28, 2076, 1052, 3100, 540, 2588, 1564, 3612,
+    284, 2332, 1308, 3356, 796, 2844, 1820, 3868,
+    156, 2204, 1180, 3228, 668, 2716, 1692, 3740,
+    412, 2460, 1436, 3484, 924, 2972, 1948, 3996,
+    92, 2140, 1116, 3164, 604, 2652, 1628, 3676,
+    348, 2396, 1372, 3420, 860, 2908, 1884, 3932,
+    220, 2268, 1244, 3292, 732, 2780, 1756, 3804,
+    476, 2524, 1500, 3548, 988, 3036, 2012, 4060,
+    60, 2108, 1084, 3132, 572, 2620, 1596, 3644,
+    316, 2364, 1340, 3388, 828, 2876, 1852, 3900,
+    188, 2236, 1212, 3260, 700, 2748, 1724, 3772,
+    444, 2492, 1468, 3516, 956, 3004, 1980, 4028,
+    124, 2172, 1148, 3196, 636, 2684, 1660, 3708,
+    380, 2428, 1404, 3452, 892, 2940, 1916, 3964,
+    252, 2300, 1276, 3324, 764, 2812, 1788, 3836,
+    508, 2556, 1532, 3580, 1020, 3068, 2044, 4092,
+    2, 2050, 1026, 3074, 514, 2562, 1538, 3586,
+    258, 2306, 1282, 3330, 770, 2818, 1794, 3842,
+    130, 2178, 1154, 3202, 642, 2690, 1666, 3714,
+    386, 2434, 1410, 3458, 898, 2946, 1922, 3970,
+    66, 2114, 1090, 3138, 578, 2626, 1602, 3650,
+    322, 2370, 1346, 3394, 834, 2882, 1858, 3906,
+    194, 2242, 1218, 3266, 706, 2754, 1730, 3778,
+    450, 2498, 1474, 3522, 962, 3010, 1986, 4034,
+    34, 2082, 1058, 3106, 546, 2594, 1570, 3618,
+    290, 2338, 1314, 3362, 802, 2850, 1826, 3874,
+    162, 2210, 1186, 3234, 674, 2722, 1698, 3746,
+    418, 2466, 1442, 3490, 930, 2978, 1954, 4002,
+    98, 2146, 1122, 3170, 610, 2658, 1634, 3682,
+    354, 2402, 1378, 3426, 866, 2914, 1890, 3938,
+    226, 2274, 1250, 3298, 738, 2786, 1762, 3810,
+    482, 2530, 1506, 3554, 994, 3042, 2018, 4066,
+    18, 2066, 1042, 3090, 530, 2578, 1554, 3602,
+    274, 2322, 1298, 3346, 786, 2834, 1810, 3858,
+    146, 2194, 1170, 3218, 658, 2706, 1682, 3730,
+    402, 2450, 1426, 3474, 914, 2962, 1938, 3986,
+    82, 2130, 1106, 3154, 594, 2642, 1618, 3666,
+    338, 2386, 1362, 3410, 850, 2898, 1874, 3922,
+    210, 2258, 1234, 3282, 722, 2770, 1746, 3794,
+    466, 2514, 1490, 3538, 978, 3026, 2002, 4050,
+    50, 2098, 1074, 3122, 562, 2610, 1586, 3634,
+    306, 2354, 1330, 3378, 818, 2866, 1842, 3890,
+    178, 2226, 1202, 3250, 690, 2738, 1714, 3762,
+    434, 2482, 1458, 3506, 946, 2994, 1970, 4018,
+    114, 2162, 1138, 3186, 626, 2674, 1650, 3698,
+    370, 2418, 1394, 3442, 882, 2930, 1906, 3954,
+    242, 2290, 1266, 3314, 754, 2802, 1778, 3826,
+    498, 2546, 1522, 3570, 1010, 3058, 2034, 4082,
+    10, 2058, 1034, 3082, 522, 2570, 1546, 3594,
+    266, 2314, 1290, 3338, 778, 2826, 1802, 3850,
+    138, 2186, 1162, 3210, 650, 2698, 1674, 3722,
+    394, 2442, 1418, 3466, 906, 2954, 1930, 3978,
+    74, 2122, 1098, 3146, 586, 2634, 1610, 3658,
+    330, 2378, 1354, 3402, 842, 2890, 1866, 3914,
+    202, 2250, 1226, 3274, 714, 2762, 1738, 3786,
+    458, 2506, 1482, 3530, 970, 3018, 1994, 4042,
+    42, 2090, 1066, 3114, 554, 2602, 1578, 3626,
+    298, 2346, 1322, 3370, 810, 2858, 1834, 3882,
+    170, 2218, 1194, 3242, 682, 2730, 1706, 3754,
+    426, 2474, 1450, 3498, 938, 2986, 1962, 4010,
+    106, 2154, 1130, 3178, 618, 2666, 1642, 3690,
+    362, 2410, 1386, 3434, 874, 2922, 1898, 3946,
+    234, 2282, 1258, 3306, 746, 2794, 1770, 3818,
+    490, 2538, 1514, 3562, 1002, 3050, 2026, 4074,
+    26, 2074, 1050, 3098, 538, 2586, 1562, 3610,
+    282, 2330, 1306, 3354, 794, 2842, 1818, 3866,
+    154, 2202, 1178, 3226, 666, 2714, 1690, 3738,
+    410, 2458, 1434, 3482, 922, 2970, 1946, 3994,
+    90, 2138, 1114, 3162, 602, 2650, 1626, 3674,
+    346, 2394, 1370, 3418, 858, 2906, 1882, 3930,
+    218, 2266, 1242, 3290, 730, 2778, 1754, 3802,
+    474, 2522, 1498, 3546, 986, 3034, 2010, 4058,
+    58, 2106, 1082, 3130, 570, 2618, 1594, 3642,
+    314, 2362, 1338, 3386, 826, 2874, 1850, 3898,
+    186, 2234, 1210, 3258, 698, 2746, 1722, 3770,
+    442, 2490, 1466, 3514, 954, 3002, 1978, 4026,
+    122, 2170, 1146, 3194, 634, 2682, 1658, 3706,
+    378, 2426, 1402, 3450, 890, 2938, 1914, 3962,
+    250, 2298, 1274, 3322, 762, 2810, 1786, 3834,
+    506, 2554, 1530, 3578, 1018, 3066, 2042, 4090,
+    6, 2054, 1030, 3078, 518, 2566, 1542, 3590,
+    262, 2310, 1286, 3334, 774, 2822, 1798, 3846,
+    134, 2182, 1158, 3206, 646, 2694, 1670, 3718,
+    390, 2438, 1414, 3462, 902, 2950, 1926, 3974,
+    70, 2118, 1094, 3142, 582, 2630, 1606, 3654,
+    326, 2374, 1350, 3398, 838, 2886, 1862, 3910,
+    198, 2246, 1222, 3270, 710, 2758, 1734, 3782,
+    454, 2502, 1478, 3526, 966, 3014, 1990, 4038,
+    38, 2086, 1062, 3110, 550, 2598, 1574, 3622,
+    294, 2342, 1318, 3366, 806, 2854, 1830, 3878,
+    166, 2214, 1190, 3238, 678, 2726, 1702, 3750,
+    422, 2470, 1446, 3494, 934, 2982, 1958, 4006,
+    102, 2150, 1126, 3174, 614, 2662, 1638, 3686,
+    358, 2406, 1382, 3430, 870, 2918, 1894, 3942,
+    230, 2278, 1254, 3302, 742, 2790, 1766, 3814,
+    486, 2534, 1510, 3558, 998, 3046, 2022, 4070,
+    22, 2070, 1046, 3094, 534, 2582, 1558, 3606,
+    278, 2326, 1302, 3350, 790, 2838, 1814, 3862,
+    150, 2198, 1174, 3222, 662, 2710, 1686, 3734,
+    406, 2454, 1430, 3478, 918, 2966, 1942, 3990,
+    86, 2134, 1110, 3158, 598, 2646, 1622, 3670,
+    342, 2390, 1366, 3414, 854, 2902, 1878, 3926,
+    214, 2262, 1238, 3286, 726, 2774, 1750, 3798,
+    470, 2518, 1494, 3542, 982, 3030, 2006, 4054,
+    54, 2102, 1078, 3126, 566, 2614, 1590, 3638,
+    310, 2358, 1334, 3382, 822, 2870, 1846, 3894,
+    182, 2230, 1206, 3254, 694, 2742, 1718, 3766,
+    438, 2486, 1462, 3510, 950, 2998, 1974, 4022,
+    118, 2166, 1142, 3190, 630, 2678, 1654, 3702,
+    374, 2422, 1398, 3446, 886, 2934, 1910, 3958,
+    246, 2294, 1270, 3318, 758, 2806, 1782, 3830,
+    502, 2550, 1526, 3574, 1014, 3062, 2038, 4086,
+    14, 2062, 1038, 3086, 526, 2574, 1550, 3598,
+    270, 2318, 1294, 3342, 782, 2830, 1806, 3854,
+    142, 2190, 1166, 3214, 654, 2702, 1678, 3726,
+    398, 2446, 1422, 3470, 910, 2958, 1934, 3982,
+    78, 2126, 1102, 3150, 590, 2638, 1614, 3662,
+    334, 2382, 1358, 3406, 846, 2894, 1870, 3918,
+    206, 2254, 1230, 3278, 718, 2766, 1742, 3790,
+    462, 2510, 1486, 3534, 974, 3022, 1998, 4046,
+    46, 2094, 1070, 3118, 558, 2606, 1582, 3630,
+    302, 2350, 1326, 3374, 814, 2862, 1838, 3886,
+    174, 2222, 1198, 3246, 686, 2734, 1710, 3758,
+    430, 2478, 1454, 3502, 942, 2990, 1966, 4014,
+    110, 2158, 1134, 3182, 622, 2670, 1646, 3694,
+    366, 2414, 1390, 3438, 878, 2926, 1902, 3950,
+    238, 2286, 1262, 3310, 750, 2798, 1774, 3822,
+    494, 2542, 1518, 3566, 1006, 3054, 2030, 4078,
+    30, 2078, 1054, 3102, 542, 2590, 1566, 3614,
+    286, 2334, 1310, 3358, 798, 2846, 1822, 3870,
+    158, 2206, 1182, 3230, 670, 2718, 1694, 3742,
+    414, 2462, 1438, 3486, 926, 2974, 1950, 3998,
+    94, 2142, 1118, 3166, 606, 2654, 1630, 3678,
+    350, 2398, 1374, 3422, 862, 2910, 1886, 3934,
+    222, 2270, 1246, 3294, 734, 2782, 1758, 3806,
+    478, 2526, 1502, 3550, 990, 3038, 2014, 4062,
+    62, 2110, 1086, 3134, 574, 2622, 1598, 3646,
+    318, 2366, 1342, 3390, 830, 2878, 1854, 3902,
+    190, 2238, 1214, 3262, 702, 2750, 1726, 3774,
+    446, 2494, 1470, 3518, 958, 3006, 1982, 4030,
+    126, 2174, 1150, 3198, 638, 2686, 1662, 3710,
+    382, 2430, 1406, 3454, 894, 2942, 1918, 3966,
+    254, 2302, 1278, 3326, 766, 2814, 1790, 3838,
+    510, 2558, 1534, 3582, 1022, 3070, 2046, 4094,
+    1, 2049, 1025, 3073, 513, 2561, 1537, 3585,
+    257, 2305, 1281, 3329, 769, 2817, 1793, 3841,
+    129, 2177, 1153, 3201, 641, 2689, 1665, 3713,
+    385, 2433, 1409, 3457, 897, 2945, 1921, 3969,
+    65, 2113, 1089, 3137, 577, 2625, 1601, 3649,
+    321, 2369, 1345, 3393, 833, 2881, 1857, 3905,
+    193, 2241, 1217, 3265, 705, 2753, 1729, 3777,
+    449, 2497, 1473, 3521, 961, 3009, 1985, 4033,
+    33, 2081, 1057, 3105, 545, 2593, 1569, 3617,
+    289, 2337, 1313, 3361, 801, 2849, 1825, 3873,
+    161, 2209, 1185, 3233, 673, 2721, 1697, 3745,
+    417, 2465, 1441, 3489, 929, 2977, 1953, 4001,
+    97, 2145, 1121, 3169, 609, 2657, 1633, 3681,
+    353, 2401, 1377, 3425, 865, 2913, 1889, 3937,
+    225, 2273, 1249, 3297, 737, 2785, 1761, 3809,
+    481, 2529, 1505, 3553, 993, 3041, 2017, 4065,
+    17, 2065, 1041, 3089, 529, 2577, 1553, 3601,
+    273, 2321, 1297, 3345, 785, 2833, 1809, 3857,
+    145, 2193, 1169, 3217, 657, 2705, 1681, 3729,
+    401, 2449, 1425, 3473, 913, 2961, 1937, 3985,
+    81, 2129, 1105, 3153, 593, 2641, 1617, 3665,
+    337, 2385, 1361, 3409, 849, 2897, 1873, 3921,
+    209, 2257, 1233, 3281, 721, 2769, 1745, 3793,
+    465, 2513, 1489, 3537, 977, 3025, 2001, 4049,
+    49, 2097, 1073, 3121, 561, 2609, 1585, 3633,
+    305, 2353, 1329, 3377, 817, 2865, 1841, 3889,
+    177, 2225, 1201, 3249, 689, 2737, 1713, 3761,
+    433, 2481, 1457, 3505, 945, 2993, 1969, 4017,
+    113, 2161, 1137, 3185, 625, 2673, 1649, 3697,
+    369, 2417, 1393, 3441, 881, 2929, 1905, 3953,
+    241, 2289, 1265, 3313, 753, 2801, 1777, 3825,
+    497, 2545, 1521, 3569, 1009, 3057, 2033, 4081,
+    9, 2057, 1033, 3081, 521, 2569, 1545, 3593,
+    265, 2313, 1289, 3337, 777, 2825, 1801, 3849,
+    137, 2185, 1161, 3209, 649, 2697, 1673, 3721,
+    393, 2441, 1417, 3465, 905, 2953, 1929, 3977,
+    73, 2121, 1097, 3145, 585, 2633, 1609, 3657,
+    329, 2377, 1353, 3401, 841, 2889, 1865, 3913,
+    201, 2249, 1225, 3273, 713, 2761, 1737, 3785,
+    457, 2505, 1481, 3529, 969, 3017, 1993, 4041,
+    41, 2089, 1065, 3113, 553, 2601, 1577, 3625,
+    297, 2345, 1321, 3369, 809, 2857, 1833, 3881,
+    169, 2217, 1193, 3241, 681, 2729, 1705, 3753,
+    425, 2473, 1449, 3497, 937, 2985, 1961, 4009,
+    105, 2153, 1129, 3177, 617, 2665, 1641, 3689,
+    361, 2409, 1385, 3433, 873, 2921, 1897, 3945,
+    233, 2281, 1257, 3305, 745, 2793, 1769, 3817,
+    489, 2537, 1513, 3561, 1001, 3049, 2025, 4073,
+    25, 2073, 1049, 3097, 537, 2585, 1561, 3609,
+    281, 2329, 1305, 3353, 793, 2841, 1817, 3865,
+    153, 2201, 1177, 3225, 665, 2713, 1689, 3737,
+    409, 2457, 1433, 3481, 921, 2969, 1945, 3993,
+    89, 2137, 1113, 3161, 601, 2649, 1625, 3673,
+    345, 2393, 1369, 3417, 857, 2905, 1881, 3929,
+    217, 2265, 1241, 3289, 729, 2777, 1753, 3801,
+    473, 2521, 1497, 3545, 985, 3033, 2009, 4057,
+    57, 2105, 1081, 3129, 569, 2617, 1593, 3641,
+    313, 2361, 1337, 3385, 825, 2873, 1849, 3897,
+    185, 2233, 1209, 3257, 697, 2745, 1721, 3769,
+    441, 2489, 1465, 3513, 953, 3001, 1977, 4025,
+    121, 2169, 1145, 3193, 633, 2681, 1657, 3705,
+    377, 2425, 1401, 3449, 889, 2937, 1913, 3961,
+    249, 2297, 1273, 3321, 761, 2809, 1785, 3833,
+    505, 2553, 1529, 3577, 1017, 3065, 2041, 4089,
+    5, 2053, 1029, 3077, 517, 2565, 1541, 3589,
+    261, 2309, 1285, 3333, 773, 2821, 1797, 3845,
+    133, 2181, 1157, 3205, 645, 2693, 1669, 3717,
+    389, 2437, 1413, 3461, 901, 2949, 1925, 3973,
+    69, 2117, 1093, 3141, 581, 2629, 1605, 3653,
+    325, 2373, 1349, 3397, 837, 2885, 1861, 3909,
+    197, 2245, 1221, 3269, 709, 2757, 1733, 3781,
+    453, 2501, 1477, 3525, 965, 3013, 1989, 4037,
+    37, 2085, 1061, 3109, 549, 2597, 1573, 3621,
+    293, 2341, 1317, 3365, 805, 2853, 1829, 3877,
+    165, 2213, 1189, 3237, 677, 2725, 1701, 3749,
+    421, 2469, 1445, 3493, 933, 2981, 1957, 4005,
+    101, 2149, 1125, 3173, 613, 2661, 1637, 3685,
+    357, 2405, 1381, 3429, 869, 2917, 1893, 3941,
+    229, 2277, 1253, 3301, 741, 2789, 1765, 3813,
+    485, 2533, 1509, 3557, 997, 3045, 2021, 4069,
+    21, 2069, 1045, 3093, 533, 2581, 1557, 3605,
+    277, 2325, 1301, 3349, 789, 2837, 1813, 3861,
+    149, 2197, 1173, 3221, 661, 2709, 1685, 3733,
+    405, 2453, 1429, 3477, 917, 2965, 1941, 3989,
+    85, 2133, 1109, 3157, 597, 2645, 1621, 3669,
+    341, 2389, 1365, 3413, 853, 2901, 1877, 3925,
+    213, 2261, 1237, 3285, 725, 2773, 1749, 3797,
+    469, 2517, 1493, 3541, 981, 3029, 2005, 4053,
+    53, 2101, 1077, 3125, 565, 2613, 1589, 3637,
+    309, 2357, 1333, 3381, 821, 2869, 1845, 3893,
+    181, 2229, 1205, 3253, 693, 2741, 1717, 3765,
+    437, 2485, 1461, 3509, 949, 2997, 1973, 4021,
+    117, 2165, 1141, 3189, 629, 2677, 1653, 3701,
+    373, 2421, 1397, 3445, 885, 2933, 1909, 3957,
+    245, 2293, 1269, 3317, 757, 2805, 1781, 3829,
+    501, 2549, 1525, 3573, 1013, 3061, 2037, 4085,
+    13, 2061, 1037, 3085, 525, 2573, 1549, 3597,
+    269, 2317, 1293, 3341, 781, 2829, 1805, 3853,
+    141, 2189, 1165, 3213, 653, 2701, 1677, 3725,
+    397, 2445, 1421, 3469, 909, 2957, 1933, 3981,
+    77, 2125, 1101, 3149, 589, 2637, 1613, 3661,
+    333, 2381, 1357, 3405, 845, 2893, 1869, 3917,
+    205, 2253, 1229, 3277, 717, 2765, 1741, 3789,
+    461, 2509, 1485, 3533, 973, 3021, 1997, 4045,
+    45, 2093, 1069, 3117, 557, 2605, 1581, 3629,
+    301, 2349, 1325, 3373, 813, 2861, 1837, 3885,
+    173, 2221, 1197, 3245, 685, 2733, 1709, 3757,
+    429, 2477, 1453, 3501, 941, 2989, 1965, 4013,
+    109, 2157, 1133, 3181, 621, 2669, 1645, 3693,
+    365, 2413, 1389, 3437, 877, 2925, 1901, 3949,
+    237, 2285, 1261, 3309, 749, 2797, 1773, 3821,
+    493, 2541, 1517, 3565, 1005, 3053, 2029, 4077,
+    29, 2077, 1053, 3101, 541, 2589, 1565, 3613,
+    285, 2333, 1309, 3357, 797, 2845, 1821, 3869,
+    157, 2205, 1181, 3229, 669, 2717, 1693, 3741,
+    413, 2461, 1437, 3485, 925, 2973, 1949, 3997,
+    93, 2141, 1117, 3165, 605, 2653, 1629, 3677,
+    349, 2397, 1373, 3421, 861, 2909, 1885, 3933,
+    221, 2269, 1245, 3293, 733, 2781, 1757, 3805,
+    477, 2525, 1501, 3549, 989, 3037, 2013, 4061,
+    61, 2109, 1085, 3133, 573, 2621, 1597, 3645,
+    317, 2365, 1341, 3389, 829, 2877, 1853, 3901,
+    189, 2237, 1213, 3261, 701, 2749, 1725, 3773,
+    445, 2493, 1469, 3517, 957, 3005, 1981, 4029,
+    125, 2173, 1149, 3197, 637, 2685, 1661, 3709,
+    381, 2429, 1405, 3453, 893, 2941, 1917, 3965,
+    253, 2301, 1277, 3325, 765, 2813, 1789, 3837,
+    509, 2557, 1533, 3581, 1021, 3069, 2045, 4093,
+    3, 2051, 1027, 3075, 515, 2563, 1539, 3587,
+    259, 2307, 1283, 3331, 771, 2819, 1795, 3843,
+    131, 2179, 1155, 3203, 643, 2691, 1667, 3715,
+    387, 2435, 1411, 3459, 899, 2947, 1923, 3971,
+    67, 2115, 1091, 3139, 579, 2627, 1603, 3651,
+    323, 2371, 1347, 3395, 835, 2883, 1859, 3907,
+    195, 2243, 1219, 3267, 707, 2755, 1731, 3779,
+    451, 2499, 1475, 3523, 963, 3011, 1987, 4035,
+    35, 2083, 1059, 3107, 547, 2595, 1571, 3619,
+    291, 2339, 1315, 3363, 803, 2851, 1827, 3875,
+    163, 2211, 1187, 3235, 675, 2723, 1699, 3747,
+    419, 2467, 1443, 3491, 931, 2979, 1955, 4003,
+    99, 2147, 1123, 3171, 611, 2659, 1635, 3683,
+    355, 2403, 1379, 3427, 867, 2915, 1891, 3939,
+    227, 2275, 1251, 3299, 739, 2787, 1763, 3811,
+    483, 2531, 1507, 3555, 995, 3043, 2019, 4067,
+    19, 2067, 1043, 3091, 531, 2579, 1555, 3603,
+    275, 2323, 1299, 3347, 787, 2835, 1811, 3859,
+    147, 2195, 1171, 3219, 659, 2707, 1683, 3731,
+    403, 2451, 1427, 3475, 915, 2963, 1939, 3987,
+    83, 2131, 1107, 3155, 595, 2643, 1619, 3667,
+    339, 2387, 1363, 3411, 851, 2899, 1875, 3923,
+    211, 2259, 1235, 3283, 723, 2771, 1747, 3795,
+    467, 2515, 1491, 3539, 979, 3027, 2003, 4051,
+    51, 2099, 1075, 3123, 563, 2611, 1587, 3635,
+    307, 2355, 1331, 3379, 819, 2867, 1843, 3891,
+    179, 2227, 1203, 3251, 691, 2739, 1715, 3763,
+    435, 2483, 1459, 3507, 947, 2995, 1971, 4019,
+    115, 2163, 1139, 3187, 627, 2675, 1651, 3699,
+    371, 2419, 1395, 3443, 883, 2931, 1907, 3955,
+    243, 2291, 1267, 3315, 755, 2803, 1779, 3827,
+    499, 2547, 1523, 3571, 1011, 3059, 2035, 4083,
+    11, 2059, 1035, 3083, 523, 2571, 1547, 3595,
+    267, 2315, 1291, 3339, 779, 2827, 1803, 3851,
+    139, 2187, 1163, 3211, 651, 2699, 1675, 3723,
+    395, 2443, 1419, 3467, 907, 2955, 1931, 3979,
+    75, 2123, 1099, 3147, 587, 2635, 1611, 3659,
+    331, 2379, 1355, 3403, 843, 2891, 1867, 3915,
+    203, 2251, 1227, 3275, 715, 2763, 1739, 3787,
+    459, 2507, 1483, 3531, 971, 3019, 1995, 4043,
+    43, 2091, 1067, 3115, 555, 2603, 1579, 3627,
+    299, 2347, 1323, 3371, 811, 2859, 1835, 3883,
+    171, 2219, 1195, 3243, 683, 2731, 1707, 3755,
+    427, 2475, 1451, 3499, 939, 2987, 1963, 4011,
+    107, 2155, 1131, 3179, 619, 2667, 1643, 3691,
+    363, 2411, 1387, 3435, 875, 2923, 1899, 3947,
+    235, 2283, 1259, 3307, 747, 2795, 1771, 3819,
+    491, 2539, 1515, 3563, 1003, 3051, 2027, 4075,
+    27, 2075, 1051, 3099, 539, 2587, 1563, 3611,
+    283, 2331, 1307, 3355, 795, 2843, 1819, 3867,
+    155, 2203, 1179, 3227, 667, 2715, 1691, 3739,
+    411, 2459, 1435, 3483, 923, 2971, 1947, 3995,
+    91, 2139, 1115, 3163, 603, 2651, 1627, 3675,
+    347, 2395, 1371, 3419, 859, 2907, 1883, 3931,
+    219, 2267, 1243, 3291, 731, 2779, 1755, 3803,
+    475, 2523, 1499, 3547, 987, 3035, 2011, 4059,
+    59, 2107, 1083, 3131, 571, 2619, 1595, 3643,
+    315, 2363, 1339, 3387, 827, 2875, 1851, 3899,
+    187, 2235, 1211, 3259, 699, 2747, 1723, 3771,
+    443, 2491, 1467, 3515, 955, 3003, 1979, 4027,
+    123, 2171, 1147, 3195, 635, 2683, 1659, 3707,
+    379, 2427, 1403, 3451, 891, 2939, 1915, 3963,
+    251, 2299, 1275, 3323, 763, 2811, 1787, 3835,
+    507, 2555, 1531, 3579, 1019, 3067, 2043, 4091,
+    7, 2055, 1031, 3079, 519, 2567, 1543, 3591,
+    263, 2311, 1287, 3335, 775, 2823, 1799, 3847,
+    135, 2183, 1159, 3207, 647, 2695, 1671, 3719,
+    391, 2439, 1415, 3463, 903, 2951, 1927, 3975,
+    71, 2119, 1095, 3143, 583, 2631, 1607, 3655,
+    327, 2375, 1351, 3399, 839, 2887, 1863, 3911,
+    199, 2247, 1223, 3271, 711, 2759, 1735, 3783,
+    455, 2503, 1479, 3527, 967, 3015, 1991, 4039,
+    39, 2087, 1063, 3111, 551, 2599, 1575, 3623,
+    295, 2343, 1319, 3367, 807, 2855, 1831, 3879,
+    167, 2215, 1191, 3239, 679, 2727, 1703, 3751,
+    423, 2471, 1447, 3495, 935, 2983, 1959, 4007,
+    103, 2151, 1127, 3175, 615, 2663, 1639, 3687,
+    359, 2407, 1383, 3431, 871, 2919, 1895, 3943,
+    231, 2279, 1255, 3303, 743, 2791, 1767, 3815,
+    487, 2535, 1511, 3559, 999, 3047, 2023, 4071,
+    23, 2071, 1047, 3095, 535, 2583, 1559, 3607,
+    279, 2327, 1303, 3351, 791, 2839, 1815, 3863,
+    151, 2199, 1175, 3223, 663, 2711, 1687, 3735,
+    407, 2455, 1431, 3479, 919, 2967, 1943, 3991,
+    87, 2135, 1111, 3159, 599, 2647, 1623, 3671,
+    343, 2391, 1367, 3415, 855, 2903, 1879, 3927,
+    215, 2263, 1239, 3287, 727, 2775, 1751, 3799,
+    471, 2519, 1495, 3543, 983, 3031, 2007, 4055,
+    55, 2103, 1079, 3127, 567, 2615, 1591, 3639,
+    311, 2359, 1335, 3383, 823, 2871, 1847, 3895,
+    183, 2231, 1207, 3255, 695, 2743, 1719, 3767,
+    439, 2487, 1463, 3511, 951, 2999, 1975, 4023,
+    119, 2167, 1143, 3191, 631, 2679, 1655, 3703,
+    375, 2423, 1399, 3447, 887, 2935, 1911, 3959,
+    247, 2295, 1271, 3319, 759, 2807, 1783, 3831,
+    503, 2551, 1527, 3575, 1015, 3063, 2039, 4087,
+    15, 2063, 1039, 3087, 527, 2575, 1551, 3599,
+    271, 2319, 1295, 3343, 783, 2831, 1807, 3855,
+    143, 2191, 1167, 3215, 655, 2703, 1679, 3727,
+    399, 2447, 1423, 3471, 911, 2959, 1935, 3983,
+    79, 2127, 1103, 3151, 591, 2639, 1615, 3663,
+    335, 2383, 1359, 3407, 847, 2895, 1871, 3919,
+    207, 2255, 1231, 3279, 719, 2767, 1743, 3791,
+    463, 2511, 1487, 3535, 975, 3023, 1999, 4047,
+    47, 2095, 1071, 3119, 559, 2607, 1583, 3631,
+    303, 2351, 1327, 3375, 815, 2863, 1839, 3887,
+    175, 2223, 1199, 3247, 687, 2735, 1711, 3759,
+    431, 2479, 1455, 3503, 943, 2991, 1967, 4015,
+    111, 2159, 1135, 3183, 623, 2671, 1647, 3695,
+    367, 2415, 1391, 3439, 879, 2927, 1903, 3951,
+    239, 2287, 1263, 3311, 751, 2799, 1775, 3823,
+    495, 2543, 1519, 3567, 1007, 3055, 2031, 4079,
+    31, 2079, 1055, 3103, 543, 2591, 1567, 3615,
+    287, 2335, 1311, 3359, 799, 2847, 1823, 3871,
+    159, 2207, 1183, 3231, 671, 2719, 1695, 3743,
+    415, 2463, 1439, 3487, 927, 2975, 1951, 3999,
+    95, 2143, 1119, 3167, 607, 2655, 1631, 3679,
+    351, 2399, 1375, 3423, 863, 2911, 1887, 3935,
+    223, 2271, 1247, 3295, 735, 2783, 1759, 3807,
+    479, 2527, 1503, 3551, 991, 3039, 2015, 4063,
+    63, 2111, 1087, 3135, 575, 2623, 1599, 3647,
+    319, 2367, 1343, 3391, 831, 2879, 1855, 3903,
+    191, 2239, 1215, 3263, 703, 2751, 1727, 3775,
+    447, 2495, 1471, 3519, 959, 3007, 1983, 4031,
+    127, 2175, 1151, 3199, 639, 2687, 1663, 3711,
+    383, 2431, 1407, 3455, 895, 2943, 1919, 3967,
+    255, 2303, 1279, 3327, 767, 2815, 1791, 3839,
+    511, 2559, 1535, 3583, 1023, 3071, 2047, 4095
+};
+
+#endif /* __FFT_TABLES_H__ */
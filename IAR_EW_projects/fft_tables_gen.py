@@ -0,0 +1,95 @@
+import math
+import os
+import struct
+import sys
+
+# Генератор fft_tables.h - константных таблиц БПФ (fft.c), которые лежат во Flash и не требуют расчета при старте:
+#   - четверть периода косинуса cos(2*pi*j / MAX_SIZE), j = 0 ... MAX_SIZE/4, в форматах double, float, Q15, Q31;
+#   - инверсия бит индекса для MAX_SIZE точек (для меньших N: rev_N(i) = rev_MAX(i) >> (log2(MAX_SIZE) - log2(N))).
+# MAX_SIZE должен совпадать с FFT_MAX_SIZE в fft.h (иначе fft.c не соберется).
+# Запуск после изменения FFT_MAX_SIZE: python fft_tables_gen.py [MAX_SIZE] - файл пишется рядом со скриптом
+
+MAX_SIZE = 4096
+VALUES_PER_LINE = 8
+
+def cos_quarter_table(max_size):
+    quarter = max_size // 4
+    table = [math.cos(2.0 * math.pi * j / max_size) for j in range(quarter + 1)]
+
+    # Точные значения в узлах, где cos() дает погрешность последнего разряда
+    table[0] = 1.0
+    table[quarter] = 0.0
+    table[quarter // 2] = math.sqrt(0.5)
+    return table
+
+def to_float32(value):
+    return struct.unpack('f', struct.pack('f', value))[0]
+
+def round_fixed(value, scale):
+    return int(math.floor(value * scale + 0.5))
+
+def bit_reverse_table(max_size):
+    bits = max_size.bit_length() - 1
+    return [int(format(i, f'0{bits}b')[::-1], 2) for i in range(max_size)]
+
+def emit_table(lines, declaration, values):
+    lines.append(f"{declaration} =")
+    lines.append("{")
+    for start in range(0, len(values), VALUES_PER_LINE):
+        chunk = values[start:start + VALUES_PER_LINE]
+        end = "," if start + VALUES_PER_LINE < len(values) else ""
+        lines.append("    " + ", ".join(chunk) + end)
+    lines.append("};")
+    lines.append("")
+
+def generate(max_size):
+    if max_size < 16 or max_size & (max_size - 1):
+        raise ValueError("MAX_SIZE должен быть степенью двойки от 16")
+
+    quarter = max_size // 4
+    table = cos_quarter_table(max_size)
+    index_type = 'uint16_t' if max_size <= 65536 else 'uint32_t'
+
+    lines = [
+        "/***********************************************************************************************************************",
+        "*   Таблицы БПФ во Flash (см. fft.c)",
+        f"*       СГЕНЕРИРОВАНО fft_tables_gen.py для FFT_MAX_SIZE = {max_size}, не редактировать вручную",
+        "***********************************************************************************************************************/",
+        "",
+        "#ifndef __FFT_TABLES_H__",
+        "#define __FFT_TABLES_H__",
+        "",
+        "#include <stdint.h>",
+        "",
+        f"#define FFT_TABLES_MAX_SIZE     {max_size}",
+        "",
+        f"/** cos(2*pi*j / {max_size}) для j = 0 ... {quarter} */",
+    ]
+    emit_table(lines, f"static const double fft_cos_table[{quarter + 1}]", [repr(v) for v in table])
+
+    lines.append("/** То же, одинарная точность (округление до ближайшего float) */")
+    emit_table(lines, f"static const float fft_cos_table_f32[{quarter + 1}]",
+               ["%.9ef" % to_float32(v) for v in table])
+
+    lines.append("/** cos * 32767 */")
+    emit_table(lines, f"static const int16_t fft_cos_table_q15[{quarter + 1}]",
+               [str(round_fixed(v, 32767.0)) for v in table])
+
+    lines.append("/** cos * (2^31 - 1) */")
+    emit_table(lines, f"static const int32_t fft_cos_table_q31[{quarter + 1}]",
+               [str(round_fixed(v, 2147483647.0)) for v in table])
+
+    lines.append(f"/** Индекс i с обратным порядком {max_size.bit_length() - 1} бит */")
+    emit_table(lines, f"static const {index_type} fft_bit_reverse_table[{max_size}]",
+               [str(v) for v in bit_reverse_table(max_size)])
+
+    lines.append("#endif /* __FFT_TABLES_H__ */")
+    return "\n".join(lines) + "\n"
+
+if __name__ == '__main__':
+    size = int(sys.argv[1]) if len(sys.argv) > 1 else MAX_SIZE
+    filename = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'fft_tables.h')
+
+    with open(filename, 'w', encoding='utf-8', newline='\n') as f:
+        f.write(generate(size))
+    print(f"Записано {filename} для N до {size}")
@@ -0,0 +1,56 @@
+import sys
+import time
+import serial
+
+# Прием оценок резкости, которые МК отправляет после каждого кадра (main.c, FOCUS_STREAM = 1):
+#     FOCUS <кадр> <fft_ratio * 10000> <дисперсия лапласиана>
+# Во время развертки фокуса (объектив крутится вручную или приводом) запоминается кадр с максимальной резкостью.
+
+PORT = 'COM5'
+BAUDRATE = 115200
+
+def parse_focus_line(line):
+    parts = line.split()
+    if len(parts) != 4 or parts[0] != 'FOCUS':
+        return None
+    try:
+        return int(parts[1]), int(parts[2]) / 10000.0, int(parts[3])
+    except ValueError:
+        return None
+
+def monitor_focus(port, baudrate, log_filename='focus_log.csv'):
+    best = None
+
+    with serial.Serial(port, baudrate, timeout=2) as uart, open(log_filename, 'w') as log:
+        log.write('time,frame,fft_ratio,laplacian_variance\n')
+        print(f"Прием с {port}, Ctrl+C - остановка")
+
+        try:
+            while True:
+                raw = uart.readline()
+                if not raw:
+                    continue
+
+                value = parse_focus_line(raw.decode('ascii', errors='ignore'))
+                if value is None:
+                    continue
+
+                frame, fft_ratio, laplacian_variance = value
+                log.write(f"{time.time():.3f},{frame},{fft_ratio:.4f},{laplacian_variance}\n")
+
+                marker = ''
+                if best is None or fft_ratio > best[1]:
+                    best = value
+                    marker = '  <- лучший'
+
+                # Полоска для настройки на глаз: длина пропорциональна доле высоких частот
+                bar = '#' * int(fft_ratio * 200)
+                print(f"кадр {frame:6d}  БПФ {fft_ratio:.4f}  лапласиан {laplacian_variance:8d}  {bar}{marker}")
+        except KeyboardInterrupt:
+            pass
+
+    if best is not None:
+        print(f"Максимальная резкость: кадр {best[0]}, БПФ {best[1]:.4f}, лапласиан {best[2]}")
+
+if __name__ == '__main__':
+    monitor_focus(sys.argv[1] if len(sys.argv) > 1 else PORT, BAUDRATE)
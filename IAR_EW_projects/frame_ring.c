@@ -0,0 +1,114 @@
+/***********************************************************************************************************************
+*   Кольцо кадров камеры OV2640 с метаданными (см. frame_ring.h)
+***********************************************************************************************************************/
+
+#include <stddef.h>
+#include "frame_ring.h"
+#include "ov2640.h"
+
+#ifndef OV2640_DVP_EMULATOR
+#include "systick.h"
+#endif
+
+/** Инициализация кольца */
+void Frame_Ring_Init(Frame_Ring_t *ring, uint8_t *const *buffers, uint8_t count, uint32_t slot_size,
+                     Frame_Source_t source, uint16_t width, uint16_t height)
+{
+    if (count > FRAME_RING_MAX_SLOTS) count = FRAME_RING_MAX_SLOTS;
+
+    // Кадр GPIO должен поместиться в буфер целиком
+    if (source == FRAME_SOURCE_GPIO && width != 0 && (uint32_t)width * height > slot_size)
+    {
+        height = slot_size / width;
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        ring->slots[i].buffer = buffers[i];
+        ring->slots[i].size = 0;
+        ring->slots[i].sequence = 0;
+        ring->slots[i].timestamp_us = 0;
+        ring->slots[i].lines = 0;
+        ring->slots[i].exposure = 0;
+        ring->slots[i].gain_index = 0;
+        ring->slots[i].error = FRAME_OK;
+    }
+
+    ring->slot_size = slot_size;
+    ring->next_sequence = 0;
+    ring->width = width;
+    ring->height = height;
+    ring->count = count;
+    ring->head = 0;
+    ring->filled = 0;
+    ring->source = source;
+}
+
+/** Захват одного кадра в следующий буфер кольца */
+const Frame_Descriptor_t *Frame_Ring_Capture(Frame_Ring_t *ring)
+{
+    if (ring->count == 0) return NULL;
+
+    Frame_Descriptor_t *frame = &ring->slots[ring->head];
+
+    // Экспозиция фиксируется до захвата: регулятор может поменять ее только между кадрами
+    frame->exposure = ov2640_exposure.exposure;
+    frame->gain_index = ov2640_exposure.gain_index;
+
+    if (ring->source == FRAME_SOURCE_DCMI_JPEG)
+    {
+        frame->lines = 0;
+        frame->size = ov2640_capture_jpeg((uint32_t*)frame->buffer, ring->slot_size / 4);
+        frame->error = (frame->size == 0) ? FRAME_ERROR_JPEG : FRAME_OK;
+    }
+    else
+    {
+        int lines = ov2640_capture_snapshot(frame->buffer, ring->width, ring->height);
+        frame->lines = (uint16_t)lines;
+        frame->size = (uint32_t)lines * ring->width;
+        frame->error = (lines < ring->height) ? FRAME_ERROR_LINES : FRAME_OK;
+    }
+
+    frame->timestamp_us = get_current_us();
+    frame->sequence = ring->next_sequence++;
+
+    ring->head = (ring->head + 1) % ring->count;
+    if (ring->filled < ring->count) ring->filled++;
+
+    return frame;
+}
+
+/** Захват серии кадров подряд */
+uint32_t Frame_Ring_Capture_Burst(Frame_Ring_t *ring, uint32_t frames)
+{
+    uint32_t good_frames = 0;
+
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        const Frame_Descriptor_t *frame = Frame_Ring_Capture(ring);
+        if (frame != NULL && frame->error == FRAME_OK) good_frames++;
+    }
+    return good_frames;
+}
+
+/** Последний захваченный кадр */
+const Frame_Descriptor_t *Frame_Ring_Get_Latest(const Frame_Ring_t *ring)
+{
+    return Frame_Ring_Get(ring, 0);
+}
+
+/** Кадр, захваченный age захватов назад */
+const Frame_Descriptor_t *Frame_Ring_Get(const Frame_Ring_t *ring, uint32_t age)
+{
+    if (age >= ring->filled) return NULL;
+
+    uint32_t index = (ring->head + ring->count - 1 - age) % ring->count;
+    return &ring->slots[index];
+}
+
+/** Сбросить кольцо */
+void Frame_Ring_Clear(Frame_Ring_t *ring)
+{
+    ring->head = 0;
+    ring->filled = 0;
+}
@@ -0,0 +1,95 @@
+/***********************************************************************************************************************
+*   Кольцо кадров камеры OV2640 с метаданными
+*       Захват серии из N кадров подряд (усреднение шума, съемка движущейся детали). Каждый кадр лежит в своем буфере,
+*   к нему прилагается дескриптор: номер в последовательности, время, количество строк, экспозиция и флаг ошибки.
+*       Потребитель получает указатель на дескриптор последнего (или более раннего) кадра и читает буфер на месте,
+*   без копирования. Буфер кадра остается нетронутым, пока планировщик не сделает еще count - 1 захватов.
+*
+*   Пример:
+*       static uint8_t frame_buffers[4][160 * 120];
+*       static uint8_t *frame_slots[4] = { frame_buffers[0], frame_buffers[1], frame_buffers[2], frame_buffers[3] };
+*       Frame_Ring_t ring;
+*
+*       Frame_Ring_Init(&ring, frame_slots, 4, sizeof(frame_buffers[0]), FRAME_SOURCE_GPIO, 160, 120);
+*       Frame_Ring_Capture_Burst(&ring, 4);
+*       const Frame_Descriptor_t *frame = Frame_Ring_Get_Latest(&ring);
+***********************************************************************************************************************/
+
+#ifndef __FRAME_RING_H__
+#define __FRAME_RING_H__
+
+#include <stdint.h>
+
+#define FRAME_RING_MAX_SLOTS    8       // максимальное количество буферов в кольце
+
+/** Способ захвата кадра */
+typedef enum
+{
+    FRAME_SOURCE_GPIO = 0,          // яркость через GPIO (ov2640_capture_snapshot), width x height байт
+    FRAME_SOURCE_DCMI_JPEG = 1      // JPEG через DCMI + DMA (ov2640_capture_jpeg), буфер выровнен на 4 байта
+}
+Frame_Source_t;
+
+/** Флаги ошибки кадра */
+typedef enum
+{
+    FRAME_OK = 0,
+    FRAME_ERROR_LINES = 1,          // захвачено меньше строк, чем запрошено
+    FRAME_ERROR_JPEG = 2            // кадр JPEG не принят или не найден маркер конца
+}
+Frame_Error_t;
+
+/** Дескриптор кадра в кольце */
+typedef struct
+{
+    uint8_t  *buffer;           // данные кадра
+    uint32_t size;              // количество полезных байт в буфере
+    uint32_t sequence;          // порядковый номер захвата (растет на 1 с каждым захватом, в т.ч. неудачным)
+    uint32_t timestamp_us;      // момент окончания захвата, мкс (get_current_us)
+    uint16_t lines;             // количество принятых строк (для JPEG - 0)
+    uint16_t exposure;          // AEC[15:0] на момент захвата (ov2640_exposure)
+    uint8_t  gain_index;        // ступень усиления на момент захвата (ov2640_exposure)
+    uint8_t  error;             // Frame_Error_t
+}
+Frame_Descriptor_t;
+
+/** Кольцо кадров */
+typedef struct
+{
+    Frame_Descriptor_t slots[FRAME_RING_MAX_SLOTS];
+    uint32_t slot_size;         // размер каждого буфера в байтах
+    uint32_t next_sequence;     // номер, который получит следующий кадр
+    uint16_t width;             // ширина кадра в байтах яркости (для GPIO)
+    uint16_t height;            // высота кадра в строках (для GPIO)
+    uint8_t  count;             // количество буферов в кольце
+    uint8_t  head;              // буфер, в который пойдет следующий кадр
+    uint8_t  filled;            // количество буферов с кадрами
+    uint8_t  source;            // Frame_Source_t
+}
+Frame_Ring_t;
+
+
+/** Инициализация кольца
+*   buffers - массив из count указателей на буферы размером slot_size байт каждый (count не больше FRAME_RING_MAX_SLOTS)
+*   width, height - размер кадра для захвата через GPIO (height урезается, если кадр не помещается в slot_size) */
+void Frame_Ring_Init(Frame_Ring_t *ring, uint8_t *const *buffers, uint8_t count, uint32_t slot_size,
+                     Frame_Source_t source, uint16_t width, uint16_t height);
+
+/** Захват одного кадра в следующий буфер кольца (самый старый кадр перезаписывается)
+*   return: дескриптор захваченного кадра (поле error показывает, удачен ли захват) */
+const Frame_Descriptor_t *Frame_Ring_Capture(Frame_Ring_t *ring);
+
+/** Захват серии из frames кадров подряд
+*   return: количество кадров серии без ошибок */
+uint32_t Frame_Ring_Capture_Burst(Frame_Ring_t *ring, uint32_t frames);
+
+/** Последний захваченный кадр, NULL - кольцо пустое */
+const Frame_Descriptor_t *Frame_Ring_Get_Latest(const Frame_Ring_t *ring);
+
+/** Кадр, захваченный age захватов назад (0 - последний), NULL - такого кадра в кольце уже (или еще) нет */
+const Frame_Descriptor_t *Frame_Ring_Get(const Frame_Ring_t *ring, uint32_t age);
+
+/** Сбросить кольцо: кадры считаются отсутствующими, нумерация продолжается */
+void Frame_Ring_Clear(Frame_Ring_t *ring);
+
+#endif /* __FRAME_RING_H__ */
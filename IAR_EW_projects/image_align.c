@@ -0,0 +1,228 @@
+/***********************************************************************************************************************
+*   Оценка общего сдвига кадра через двумерную взаимную корреляцию (см. image_align.h)
+***********************************************************************************************************************/
+
+#include <stddef.h>
+#include "image_align.h"
+#include "systick.h"
+
+/** Настройка */
+Align_Status_t Image_Align_Init(Image_Align_t *align, float complex *work, uint8_t *reference, uint32_t size,
+                                uint32_t frame_width, uint32_t frame_height, uint8_t phase_only)
+{
+    if (size < ALIGN_MIN_SIZE || size > ALIGN_MAX_SIZE || FFT_Log2(size) == 0) return ALIGN_ERROR_SIZE;
+
+    uint32_t scale = ((frame_width < frame_height) ? frame_width : frame_height) / size;
+    if (scale == 0) return ALIGN_ERROR_SIZE;
+
+    align->work = work;
+    align->reference = reference;
+    align->size = (uint16_t)size;
+    align->scale = (uint16_t)scale;
+    align->origin_x = (uint16_t)((frame_width - size * scale) / 2);
+    align->origin_y = (uint16_t)((frame_height - size * scale) / 2);
+    align->frame_width = (uint16_t)frame_width;
+    align->frame_height = (uint16_t)frame_height;
+    align->phase_only = phase_only;
+    align->has_reference = 0;
+
+    // Окно Ханна без нулевых краев: край тайла не должен давать ложный пик на нулевом сдвиге
+    for (uint32_t i = 0; i < size; i++)
+    {
+        align->window[i] = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * ((float)i + 0.5f) / (float)size);
+    }
+
+    align->shift_x = 0.0f;
+    align->shift_y = 0.0f;
+    align->score = 0.0f;
+    align->cycles = 0;
+
+    Image_Align_Begin(align);
+    return ALIGN_OK;
+}
+
+/** Начать накопление тайла */
+void Image_Align_Begin(Image_Align_t *align)
+{
+    uint32_t n = (uint32_t)align->size * align->size;
+    for (uint32_t i = 0; i < n; i++) align->work[i] = 0.0f;
+}
+
+/** Добавить строки яркости */
+void Image_Align_Add_Lines(Image_Align_t *align, const uint8_t *lines, uint32_t first_line, uint32_t line_count)
+{
+    if (lines == NULL) return;
+
+    const uint32_t size = align->size;
+    const uint32_t scale = align->scale;
+    const uint32_t top = align->origin_y;
+    const uint32_t bottom = top + size * scale;
+
+    for (uint32_t line = 0; line < line_count; line++)
+    {
+        uint32_t y = first_line + line;
+        if (y < top || y >= bottom) continue;
+
+        float complex *row = &align->work[((y - top) / scale) * size];
+        const uint8_t *pixel = &lines[line * align->frame_width + align->origin_x];
+
+        for (uint32_t tx = 0; tx < size; tx++)
+        {
+            uint32_t sum = 0;
+            for (uint32_t i = 0; i < scale; i++) sum += *pixel++;
+            row[tx] += (float)sum;
+        }
+    }
+}
+
+/** Добавить упакованный бинарный кадр */
+void Image_Align_Add_Packed(Image_Align_t *align, const uint8_t *packed)
+{
+    if (packed == NULL) return;
+
+    const uint32_t size = align->size;
+    const uint32_t scale = align->scale;
+
+    for (uint32_t y = 0; y < size * scale; y++)
+    {
+        float complex *row = &align->work[(y / scale) * size];
+        uint32_t index = (align->origin_y + y) * align->frame_width + align->origin_x;     // номер пикселя кадра
+
+        for (uint32_t tx = 0; tx < size; tx++)
+        {
+            uint32_t white = 0;
+            for (uint32_t i = 0; i < scale; i++, index++) white += (packed[index >> 3] >> (7 - (index & 7))) & 1;
+            row[tx] += (float)(white * 255);
+        }
+    }
+}
+
+/** Запомнить накопленный тайл как эталон */
+void Image_Align_Store_Reference(Image_Align_t *align)
+{
+    uint32_t n = (uint32_t)align->size * align->size;
+    float area = (float)align->scale * (float)align->scale;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        float mean = crealf(align->work[i]) / area;
+        align->reference[i] = (uint8_t)(mean + 0.5f);
+    }
+    align->has_reference = 1;
+}
+
+/** Уточнение положения максимума параболой по соседям (-0.5 ... +0.5) */
+static float align_parabola(float left, float center, float right)
+{
+    float denominator = left - 2.0f * center + right;
+    if (denominator >= 0.0f) return 0.0f;
+    return 0.5f * (left - right) / denominator;
+}
+
+/** Оценить сдвиг */
+Align_Status_t Image_Align_Estimate(Image_Align_t *align)
+{
+    if (!align->has_reference) return ALIGN_ERROR_FLAT;
+
+    uint32_t start = Benchmark_Time();
+
+    const uint32_t size = align->size;
+    const uint32_t n = size * size;
+    const uint32_t mask = size - 1;
+    float complex *work = align->work;
+    float area = (float)align->scale * (float)align->scale;
+
+    // Средние яркости тайлов: постоянная составляющая дала бы пик на нулевом сдвиге
+    float mean_current = 0.0f, mean_reference = 0.0f;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        mean_current += crealf(work[i]);
+        mean_reference += (float)align->reference[i];
+    }
+    mean_current /= (float)n * area;
+    mean_reference /= (float)n;
+
+    // Смесь z = a + i*b: a - текущий тайл, b - эталон (после вычитания среднего и окна)
+    float energy_current = 0.0f, energy_reference = 0.0f;
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            uint32_t i = y * size + x;
+            float w = align->window[x] * align->window[y];
+            float a = (crealf(work[i]) / area - mean_current) * w;
+            float b = ((float)align->reference[i] - mean_reference) * w;
+
+            work[i] = a + b * I;
+            energy_current += a * a;
+            energy_reference += b * b;
+        }
+    }
+    if (energy_current <= 0.0f || energy_reference <= 0.0f) return ALIGN_ERROR_FLAT;
+
+    FFT_Forward_2D_F32(work, size, size, align->column);
+
+    // A[k] = (Z[k] + conj(Z[-k])) / 2, B[k] = (Z[k] - conj(Z[-k])) / 2i, P[k] = A[k] * conj(B[k])
+    // P эрмитов (P[-k] = conj(P[k])), поэтому пары k и -k обрабатываются вместе и пишутся на место Z
+    for (uint32_t v = 0; v < size; v++)
+    {
+        for (uint32_t u = 0; u < size; u++)
+        {
+            uint32_t i = v * size + u;
+            uint32_t j = ((size - v) & mask) * size + ((size - u) & mask);
+            if (j < i) continue;
+
+            float complex z = work[i];
+            float complex p;
+
+            if (j == i)
+            {
+                p = crealf(z) * cimagf(z);
+            }
+            else
+            {
+                float complex z_mirror = conjf(work[j]);
+                float complex a = 0.5f * (z + z_mirror);
+                float complex b = -0.5f * I * (z - z_mirror);
+                p = a * conjf(b);
+            }
+
+            if (align->phase_only)
+            {
+                float magnitude = cabsf(p);
+                p = (magnitude > 1e-20f) ? p / magnitude : 0.0f;
+            }
+
+            work[i] = p;
+            work[j] = conjf(p);
+        }
+    }
+
+    FFT_Inverse_2D_F32(work, size, size, align->column);
+
+    // Максимум корреляции (мнимая часть - только ошибка округления)
+    uint32_t peak = 0;
+    for (uint32_t i = 1; i < n; i++)
+    {
+        if (crealf(work[i]) > crealf(work[peak])) peak = i;
+    }
+
+    uint32_t px = peak & mask;
+    uint32_t py = peak / size;
+    float center = crealf(work[peak]);
+    float dx = align_parabola(crealf(work[py * size + ((px - 1) & mask)]), center,
+                              crealf(work[py * size + ((px + 1) & mask)]));
+    float dy = align_parabola(crealf(work[((py - 1) & mask) * size + px]), center,
+                              crealf(work[((py + 1) & mask) * size + px]));
+
+    // Круговой сдвиг: индексы больше size/2 - отрицательные сдвиги
+    float sx = (float)((px < size / 2) ? (int32_t)px : (int32_t)px - (int32_t)size) + dx;
+    float sy = (float)((py < size / 2) ? (int32_t)py : (int32_t)py - (int32_t)size) + dy;
+
+    align->shift_x = sx * (float)align->scale;
+    align->shift_y = sy * (float)align->scale;
+    align->score = align->phase_only ? center : center / sqrtf(energy_current * energy_reference);
+    align->cycles = Benchmark_Time() - start;
+
+    return ALIGN_OK;
+}
@@ -0,0 +1,90 @@
+/***********************************************************************************************************************
+*   Оценка общего сдвига кадра относительно эталона через двумерную взаимную корреляцию (БПФ)
+*       На ПК то же делает compare_images_conv.py (scipy fftconvolve), в ImageProcessing_compare_packed_with_tolerance
+*   на МК допускается сдвиг только +-2 пикселя. Здесь центральная область кадра уменьшается усреднением блоков
+*   scale x scale до тайла size x size (32, 64 или 128), тайлы текущего кадра и эталона с вычтенным средним и окном
+*   Ханна упаковываются в один комплексный массив (текущий - re, эталон - im) и проходят через одно прямое
+*   двумерное БПФ. Из спектра смеси выделяются спектры A (текущий) и B (эталон), произведение A * conj(B)
+*   после обратного БПФ дает круговую корреляцию, ее максимум - сдвиг с точностью до доли пикселя тайла.
+*
+*       Время ограничено размером тайла и не зависит от сдвига: два двумерных БПФ size x size
+*   (размах поиска - +-size/2 пикселя тайла, т.е. +-size*scale/2 пикселей кадра).
+*   Память: work - size*size*8 байт (64 x 64 - 32 КБ, 128 x 128 - 128 КБ), reference - size*size байт.
+*
+*   Пример (кадр 800 x 600 по фрагментам, тайл 64 x 64, 1 пиксель тайла = 9 x 9 пикселей кадра):
+*       static float complex align_work[64 * 64];
+*       static uint8_t align_reference[64 * 64];
+*       static Image_Align_t align;
+*       Image_Align_Init(&align, align_work, align_reference, 64, CAM_WIDTH, CAM_HEIGHT, 0);
+*       Image_Align_Begin(&align);
+*       Image_Align_Add_Packed(&align, (const uint8_t*)0x080E0000);      // эталон из Flash
+*       Image_Align_Store_Reference(&align);
+*       ...
+*       Image_Align_Begin(&align);
+*       Image_Align_Add_Lines(&align, fragment, first_line, line_count);   // для каждого фрагмента кадра
+*       if (Image_Align_Estimate(&align) == ALIGN_OK) { ... align.shift_x, align.shift_y, align.score ... }
+***********************************************************************************************************************/
+
+#ifndef __IMAGE_ALIGN_H__
+#define __IMAGE_ALIGN_H__
+
+#include <stdint.h>
+#include "fft.h"
+
+#define ALIGN_MIN_SIZE      16
+#define ALIGN_MAX_SIZE      128     // максимальная сторона тайла (определяет размер рабочих буферов структуры)
+
+typedef enum
+{
+    ALIGN_OK = 0,
+    ALIGN_ERROR_SIZE = 1,           // сторона тайла не степень двойки 16 ... 128 или кадр меньше тайла
+    ALIGN_ERROR_FLAT = 2            // тайл однотонный (или нет эталона) - сдвиг не определить
+}
+Align_Status_t;
+
+typedef struct
+{
+    float complex *work;                    // size*size: re - текущий тайл (суммы яркости), im - эталон, затем спектр
+    uint8_t *reference;                     // size*size: эталонный тайл (средняя яркость блока)
+    float complex column[ALIGN_MAX_SIZE];   // столбец для двумерного БПФ
+    float window[ALIGN_MAX_SIZE];           // окно Ханна по одной оси
+
+    uint16_t size;                  // сторона тайла
+    uint16_t scale;                 // сторона блока кадра, усредняемого в 1 пиксель тайла
+    uint16_t origin_x;              // левый верхний угол области кадра, из которой строится тайл
+    uint16_t origin_y;
+    uint16_t frame_width;
+    uint16_t frame_height;
+    uint8_t  phase_only;            // 1 - фазовая корреляция (|A*conj(B)| = 1): пик острее, не зависит от контраста
+    uint8_t  has_reference;
+
+    // Результат Image_Align_Estimate
+    float    shift_x;               // сдвиг текущего кадра относительно эталона в пикселях кадра (вправо > 0)
+    float    shift_y;               // (вниз > 0)
+    float    score;                 // высота пика: коэффициент корреляции 0 ... 1 (при phase_only - доля энергии пика)
+    uint32_t cycles;                // время оценки (такты DWT, на ПК с HOST_BUILD - нс)
+}
+Image_Align_t;
+
+/** Настройка: size - сторона тайла, область кадра - size*scale пикселей по центру, scale = min(width, height) / size
+*   phase_only - 0 взаимная корреляция, 1 фазовая корреляция */
+Align_Status_t Image_Align_Init(Image_Align_t *align, float complex *work, uint8_t *reference, uint32_t size,
+                                uint32_t frame_width, uint32_t frame_height, uint8_t phase_only);
+
+/** Начать накопление тайла нового кадра */
+void Image_Align_Begin(Image_Align_t *align);
+
+/** Добавить строки яркости first_line ... first_line + line_count - 1 (кадр можно подавать фрагментами) */
+void Image_Align_Add_Lines(Image_Align_t *align, const uint8_t *lines, uint32_t first_line, uint32_t line_count);
+
+/** Добавить весь упакованный бинарный кадр (8 пикселей в байте, 1 - белый), например образец во Flash */
+void Image_Align_Add_Packed(Image_Align_t *align, const uint8_t *packed);
+
+/** Запомнить накопленный тайл как эталон */
+void Image_Align_Store_Reference(Image_Align_t *align);
+
+/** Оценить сдвиг накопленного тайла относительно эталона (результат - в полях shift_x, shift_y, score)
+*   Тайл накопления при этом расходуется (для следующей оценки - снова Image_Align_Begin) */
+Align_Status_t Image_Align_Estimate(Image_Align_t *align);
+
+#endif /* __IMAGE_ALIGN_H__ */
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include "image_processing.h"
+#include "systick.h"
 
 /***********       ,   ,     ********/
 //       
@@ -157,181 +158,302 @@ float ImageProcessing_compare_packed_with_tolerance(uint8_t *current_packed, uin
 /**********************************************************************************************************************/
 
 
-/******************************  ***********************************************************************************/
+/**************************************************************************   () */
 
-//    W_32^r  r  0  15
-const double complex W32[16] =
+/**      */
+void ImageProcessing_temporal_filter_init(ImageProcessing_Temporal_Filter_t *filter, void *state, uint8_t bits,
+                                          uint8_t shift, uint16_t width, uint16_t height)
 {
-    1.000000 + 0.000000 * I,  // W^0
-    0.980785 - 0.195090 * I,  // W^1
-    0.923880 - 0.382683 * I,  // W^2
-    0.831470 - 0.555570 * I,  // W^3
-    0.707107 - 0.707107 * I,  // W^4
-    0.555570 - 0.831470 * I,  // W^5
-    0.382683 - 0.923880 * I,  // W^6
-    0.195090 - 0.980785 * I,  // W^7
-    0.000000 - 1.000000 * I,  // W^8
-   -0.195090 - 0.980785 * I,  // W^9
-   -0.382683 - 0.923880 * I,  // W^10
-   -0.555570 - 0.831470 * I,  // W^11
-   -0.707107 - 0.707107 * I,  // W^12
-   -0.831470 - 0.555570 * I,  // W^13
-   -0.923880 - 0.382683 * I,  // W^14
-   -0.980785 - 0.195090 * I   // W^15
-};
-
-//    W_32^r  r  0  31
-const double complex W64[32] =
-{
-    1.0000 + 0.0000 * I,  // W_64^0  // W32^0  // W16^0  // W8^0    // W4^0             ( +1)
-    0.9952 - 0.0980 * I,  // W_64^1
-    0.9808 - 0.1951 * I,  // W_64^2  // W32^1
-    0.9569 - 0.2903 * I,  // W_64^3
-    0.9239 - 0.3827 * I,  // W_64^4  // W32^2  // W16^1
-    0.8819 - 0.4714 * I,  // W_64^5
-    0.8315 - 0.5556 * I,  // W_64^6  // W32^3
-    0.7730 - 0.6344 * I,  // W_64^7
-    0.7071 - 0.7071 * I,  // W_64^8  // W32^4  // W16^2  // W8^1
-    0.6344 - 0.7730 * I,  // W_64^9
-    0.5556 - 0.8315 * I,  // W_64^10 // W32^5
-    0.4714 - 0.8819 * I,  // W_64^11
-    0.3827 - 0.9239 * I,  // W_64^12 // W32^6  // W16^3
-    0.2903 - 0.9569 * I,  // W_64^13
-    0.1951 - 0.9808 * I,  // W_64^14 // W32^7
-    0.0980 - 0.9952 * I,  // W_64^15
-    0.0000 - 1.0000 * I,  // W_64^16 // W32^8  // W16^4  // W8^2     // W4^1                  (  -j)
-   -0.0980 - 0.9952 * I,  // W_64^17
-   -0.1951 - 0.9808 * I,  // W_64^18 // W32^9
-   -0.2903 - 0.9569 * I,  // W_64^19
-   -0.3827 - 0.9239 * I,  // W_64^20 // W32^10  // W16^5
-   -0.4714 - 0.8819 * I,  // W_64^21
-   -0.5556 - 0.8315 * I,  // W_64^22 // W32^11
-   -0.6344 - 0.7730 * I,  // W_64^23
-   -0.7071 - 0.7071 * I,  // W_64^24 // W32^12  // W16^6  // W8^3
-   -0.7730 - 0.6344 * I,  // W_64^25
-   -0.8315 - 0.5556 * I,  // W_64^26 // W32^13
-   -0.8819 - 0.4714 * I,  // W_64^27
-   -0.9239 - 0.3827 * I,  // W_64^28 // W32^14  // W16^7
-   -0.9569 - 0.2903 * I,  // W_64^29
-   -0.9808 - 0.1951 * I,  // W_64^30 // W32^15
-   -0.9952 - 0.0980 * I   // W_64^31
-};
-
-
-//   5   N=32
-static unsigned int bit_reverse_5bit(unsigned int x)
-{
-    unsigned int rev = 0;
-    for (int i = 0; i < 5; i++)
-    {
-        rev = (rev << 1) | (x & 1);
-        x >>= 1;
-    }
-    return rev;
+    filter->state = state;
+    filter->bits = (bits == 16) ? 16 : 8;
+    filter->shift = shift;
+    filter->width = width;
+    filter->height = height;
+    ImageProcessing_temporal_filter_set_roi(filter, 0, 0, width, height);
 }
 
-//   6   N=64
-static unsigned int bit_reverse_6bit(unsigned int x)
+/**    */
+void ImageProcessing_temporal_filter_set_roi(ImageProcessing_Temporal_Filter_t *filter,
+                                             uint16_t x, uint16_t y, uint16_t roi_width, uint16_t roi_height)
 {
-    unsigned int rev = 0;
-    for (int i = 0; i < 6; i++)
-    {
-        rev = (rev << 1) | (x & 1);
-        x >>= 1;
-    }
-    return rev;
+    //     
+    if (x > filter->width) x = filter->width;
+    if (y > filter->height) y = filter->height;
+    if (roi_width > filter->width - x) roi_width = filter->width - x;
+    if (roi_height > filter->height - y) roi_height = filter->height - y;
+
+    filter->roi_x = x;
+    filter->roi_y = y;
+    filter->roi_width = roi_width;
+    filter->roi_height = roi_height;
+    filter->frames = 0;     //     
 }
 
-//   32 
-void fft32(const double complex input[32], double complex output[32])
+/**      */
+void ImageProcessing_temporal_filter_update(ImageProcessing_Temporal_Filter_t *filter, uint8_t *lines,
+                                            uint32_t first_line, uint32_t line_count)
 {
-    // 1.       
-    double complex temp[32];
-    for (int i = 0; i < 32; ++i)
-    {
-        temp[bit_reverse_5bit(i)] = input[i];
-    }
+    if (filter == NULL || filter->state == NULL || lines == NULL) return;
+
+    const uint32_t k = filter->shift;
+    const uint32_t roi_end = filter->roi_y + filter->roi_height;
+    const uint8_t first_frame = (filter->frames == 0);
 
-    // 2.   
-    for (int stage = 1; stage <= 5; ++stage)
+    //      
+    uint32_t y_begin = (first_line > filter->roi_y) ? first_line : filter->roi_y;
+    uint32_t y_end = (first_line + line_count < roi_end) ? first_line + line_count : roi_end;
+
+    for (uint32_t y = y_begin; y < y_end; y++)
     {
-        int len = 1 << stage;          //    (2, 4, 8, 16, 32)
-        int half = len >> 1;           //   (1, 2, 4, 8, 16)
-        int twiddle_step = 32 / len;   //    
+        uint8_t *pixel = lines + (y - first_line) * filter->width + filter->roi_x;
+        uint32_t state_offset = (y - filter->roi_y) * filter->roi_width;
 
-        //        
-        for (int i = 0; i < 32; i += len)
+        if (filter->bits == 16)
         {
-            for (int j = 0; j < half; ++j)
+            //   8  :  ( - ) >> k      
+            uint16_t *average = (uint16_t*)filter->state + state_offset;
+
+            for (uint32_t x = 0; x < filter->roi_width; x++)
             {
-                int top_idx = i + j;
-                int bot_idx = i + j + half;
+                int32_t target = (int32_t)pixel[x] << 8;
+                int32_t value = first_frame ? target : average[x];
 
-                //    r
-                int r = j * twiddle_step;
-                double complex W = W32[r];
+                value += (target - value) >> k;
+                average[x] = (uint16_t)value;
+                pixel[x] = (uint8_t)((value + 128) >> 8);
+            }
+        }
+        else
+        {
+            uint8_t *average = (uint8_t*)filter->state + state_offset;
 
-                // :    temp,       
-                double complex A = temp[top_idx];
-                double complex B_turned = temp[bot_idx] * W;
+            for (uint32_t x = 0; x < filter->roi_width; x++)
+            {
+                int32_t value = first_frame ? pixel[x] : average[x];
 
-                output[top_idx] = A + B_turned;
-                output[bot_idx] = A - B_turned;
+                value += ((int32_t)pixel[x] - value) >> k;
+                average[x] = (uint8_t)value;
+                pixel[x] = (uint8_t)value;
             }
         }
+    }
+
+    //  ,     
+    if (first_line < roi_end && first_line + line_count >= roi_end) filter->frames++;
+}
 
-        //       temp   
-        for (int i = 0; i < 32; ++i)
+/**    :       +   +-noise */
+static void temporal_generate_frame(uint8_t *frame, uint32_t width, uint32_t height, uint32_t seed, uint8_t noise)
+{
+    uint32_t random = seed * 0x9E3779B9U + 1;
+
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
         {
-            temp[i] = output[i];
+            int32_t value = ((x % 16) < 4) ? 40 : 110 + (int32_t)(y * 40 / height);
+
+            if (noise)
+            {
+                random ^= random << 13;     // xorshift32
+                random ^= random >> 17;
+                random ^= random << 5;
+                value += (int32_t)(random % (2U * noise + 1)) - noise;
+            }
+            if (value < 0) value = 0;
+            if (value > 255) value = 255;
+            *frame++ = (uint8_t)value;
         }
     }
 }
 
-//   64 
-void fft64(const double complex input[64], double complex output[64])
+/**      (history -  ),     */
+static uint32_t temporal_count_flips(const uint8_t *frame, uint8_t *history, uint32_t pixels, uint8_t count)
 {
-    // 1.       
-    double complex temp[64];
-    for (int i = 0; i < 64; ++i)
+    uint32_t flips = 0;
+
+    for (uint32_t i = 0; i < pixels; i++)
     {
-        temp[bit_reverse_6bit(i)] = input[i];
+        uint8_t mask = (uint8_t)(1 << (i & 7));
+        uint8_t white = (frame[i] != 0);
+        uint8_t was_white = (history[i >> 3] & mask) != 0;
+
+        if (count && white != was_white) flips++;
+
+        if (white) history[i >> 3] |= mask;
+        else history[i >> 3] &= (uint8_t)~mask;
     }
+    return flips;
+}
+
+/**       */
+void ImageProcessing_temporal_filter_benchmark(ImageProcessing_Temporal_Filter_t *filter, uint8_t *frame,
+                                               uint8_t *history, uint32_t frames, uint8_t noise,
+                                               ImageProcessing_Temporal_Benchmark_t *result)
+{
+    const uint32_t width = filter->width;
+    const uint32_t height = filter->height;
+    const uint32_t pixels = width * height;
+    const uint32_t warmup = 1U << filter->shift;   //    
+
+    uint64_t filter_cycles = 0;
+    uint64_t binarize_cycles = 0;
+    uint64_t flips_single = 0;
+    uint64_t flips_filtered = 0;
+    uint64_t compared = 0;
+
+    filter->frames = 0;
 
-    // 2.   
-    for (int stage = 1; stage <= 6; ++stage)    // ' Log2(64)=6' (2, 4, 8, 16, 32.   64)
+    for (uint32_t f = 0; f < frames; f++)
     {
-        int len = 1 << stage;          //    (2, 4, 8, 16, 32.   64)
-        int half = len >> 1;           //   (1, 2, 4, 8, 16.   32)
-        int twiddle_step = 64 / len;   //    
+        uint8_t count = (f > warmup);
+
+        //  :   
+        temporal_generate_frame(frame, width, height, f, noise);
+        uint32_t start = Benchmark_Time();
+        ImageProcessing_binarize_adaptive_local(frame, (int)width, (int)height);
+        binarize_cycles += Benchmark_Time() - start;
+        flips_single += temporal_count_flips(frame, history, pixels, count);
+
+        //     
+        temporal_generate_frame(frame, width, height, f, noise);
+        start = Benchmark_Time();
+        ImageProcessing_temporal_filter_update(filter, frame, 0, height);
+        filter_cycles += Benchmark_Time() - start;
+        ImageProcessing_binarize_adaptive_local(frame, (int)width, (int)height);
+        flips_filtered += temporal_count_flips(frame, history + pixels / 8, pixels, count);
+
+        if (count) compared += pixels;
+    }
+
+    uint64_t processed = (uint64_t)frames * pixels;
+    result->filter_cycles_x100 = processed ? (uint32_t)(filter_cycles * 100 / processed) : 0;
+    result->binarize_cycles_x100 = processed ? (uint32_t)(binarize_cycles * 100 / processed) : 0;
+    result->flips_single_ppm = compared ? (uint32_t)(flips_single * 1000000 / compared) : 0;
+    result->flips_filtered_ppm = compared ? (uint32_t)(flips_filtered * 1000000 / compared) : 0;
+}
+/**********************************************************************************************************************/
 
-        //        
-        for (int i = 0; i < 64; i += len)
+
+/**************************************************************************************   () */
+
+/**      :    ,   - window[x] * window[y] */
+static float focus_window[IMAGE_FOCUS_TILE];
+static uint8_t focus_window_ready = 0;
+
+/**        */
+float ImageProcessing_focus_fft(const uint8_t *tile, uint32_t stride, float complex *work)
+{
+    const uint32_t size = IMAGE_FOCUS_TILE;
+    const int32_t cutoff2 = IMAGE_FOCUS_CUTOFF * IMAGE_FOCUS_CUTOFF;
+    float complex *column = work + size * size;
+
+    if (!focus_window_ready)
+    {
+        for (uint32_t i = 0; i < size; i++)
         {
-            for (int j = 0; j < half; ++j)
-            {
-                int top_idx = i + j;
-                int bot_idx = i + j + half;
+            focus_window[i] = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * ((float)i + 0.5f) / (float)size);
+        }
+        focus_window_ready = 1;
+    }
 
-                //    r
-                int r = j * twiddle_step;
-                double complex W = W64[r];
+    //   (     ),   -   
+    //     
+    uint32_t sum = 0;
+    for (uint32_t y = 0; y < size; y++)
+        for (uint32_t x = 0; x < size; x++) sum += tile[y * stride + x];
+    float mean = (float)sum / (float)(size * size);
 
-                // :    temp,       
-                double complex A = temp[top_idx];
-                double complex B_turned = temp[bot_idx] * W;
+    for (uint32_t y = 0; y < size; y++)
+    {
+        float wy = focus_window[y];
+        for (uint32_t x = 0; x < size; x++)
+        {
+            work[y * size + x] = ((float)tile[y * stride + x] - mean) * focus_window[x] * wy;
+        }
+    }
+
+    FFT_Forward_2D_F32(work, size, size, column);
+
+    //   (  size/2)      -      ,
+    //             
+    const int32_t noise2 = (int32_t)(size / 2) * (int32_t)(size / 2);
+    float total = 0.0f, high = 0.0f, noise = 0.0f;
+    uint32_t total_bins = 0, high_bins = 0, noise_bins = 0;
+
+    for (uint32_t v = 0; v < size; v++)
+    {
+        int32_t fy = (v < size / 2) ? (int32_t)v : (int32_t)v - (int32_t)size;
+        for (uint32_t u = 0; u < size; u++)
+        {
+            int32_t fx = (u < size / 2) ? (int32_t)u : (int32_t)u - (int32_t)size;
+            int32_t radius2 = fx * fx + fy * fy;
+            float complex value = work[v * size + u];
+            float energy = crealf(value) * crealf(value) + cimagf(value) * cimagf(value);
 
-                output[top_idx] = A + B_turned;
-                output[bot_idx] = A - B_turned;
+            if (radius2 >= noise2)
+            {
+                noise += energy;
+                noise_bins++;
+                continue;
+            }
+            total += energy;
+            total_bins++;
+            if (radius2 >= cutoff2)
+            {
+                high += energy;
+                high_bins++;
             }
         }
+    }
+
+    float noise_floor = noise / (float)noise_bins;
+    total -= noise_floor * (float)total_bins;
+    high -= noise_floor * (float)high_bins;
+    if (high < 0.0f) high = 0.0f;
+
+    return (total > 0.0f) ? high / total : 0.0f;
+}
+
+/**   (4 )     width x height */
+float ImageProcessing_focus_laplacian(const uint8_t *tile, uint32_t stride, uint32_t width, uint32_t height)
+{
+    if (width < 3 || height < 3) return 0.0f;
 
-        //       temp   
-        for (int i = 0; i < 64; ++i)
+    int64_t sum = 0;
+    uint64_t sum_squares = 0;
+
+    for (uint32_t y = 1; y < height - 1; y++)
+    {
+        const uint8_t *above = tile + (y - 1) * stride;
+        const uint8_t *p = above + stride;
+        const uint8_t *below = p + stride;
+
+        for (uint32_t x = 1; x < width - 1; x++)
         {
-            temp[i] = output[i];
+            int32_t laplacian = 4 * (int32_t)p[x] - p[x - 1] - p[x + 1] - above[x] - below[x];
+            sum += laplacian;
+            sum_squares += (uint64_t)(laplacian * laplacian);
         }
     }
+
+    float count = (float)((width - 2) * (height - 2));
+    float mean = (float)sum / count;
+    return (float)sum_squares / count - mean * mean;
 }
 
+/**         */
+void ImageProcessing_focus_update(ImageProcessing_Focus_t *focus, const uint8_t *tile, uint32_t stride,
+                                  float complex *work)
+{
+    uint32_t start = Benchmark_Time();
+    focus->fft_ratio = ImageProcessing_focus_fft(tile, stride, work);
+    focus->fft_cycles = Benchmark_Time() - start;
+
+    start = Benchmark_Time();
+    focus->laplacian_variance = ImageProcessing_focus_laplacian(tile, stride, IMAGE_FOCUS_TILE, IMAGE_FOCUS_TILE);
+    focus->laplacian_cycles = Benchmark_Time() - start;
+
+    focus->frames++;
+}
 /**********************************************************************************************************************/
@@ -12,20 +12,96 @@ void ImageProcessing_binarize_adaptive_local(uint8_t *buffer, int width, int hei
 *             ( 0.0  1.0) */
 float ImageProcessing_compare_packed_with_tolerance(uint8_t *current_packed, uint32_t example_address, uint32_t width, uint32_t height);
 
+/**************************************************************************   () */
+
+/**      :  += ( - ) >> shift
+*           OV2640      .    
+*     8  16     ROI (   -  ):
+*   - 8 : width*height ,  ; -       2^shift - 1 ;
+*   - 16 : width*height*2 ,   8  ,    */
+typedef struct
+{
+    void     *state;        // uint8_t[]  uint16_t[]      
+    uint8_t  bits;          // 8  16
+    uint8_t  shift;         //  : 1 -  , 3 - ~8 , 4 - ~16 
+    uint16_t width;         //  
+    uint16_t height;        //  
+    uint16_t roi_x;         //     
+    uint16_t roi_y;
+    uint16_t roi_width;
+    uint16_t roi_height;
+    uint32_t frames;        //  ,    (      )
+}
+ImageProcessing_Temporal_Filter_t;
+
+/**  ImageProcessing_temporal_filter_benchmark */
+typedef struct
+{
+    uint32_t filter_cycles_x100;        //    * 100 (  -    * 100):  
+    uint32_t binarize_cycles_x100;      //    ImageProcessing_binarize_adaptive_local
+    uint32_t flips_single_ppm;          //  ,    ,  :  
+    uint32_t flips_filtered_ppm;        //    
+}
+ImageProcessing_Temporal_Benchmark_t;
+
+/**     , state -  width*height*bits/8  */
+void ImageProcessing_temporal_filter_init(ImageProcessing_Temporal_Filter_t *filter, void *state, uint8_t bits,
+                                          uint8_t shift, uint16_t width, uint16_t height);
+
+/**    ( - roi_width*roi_height ),    */
+void ImageProcessing_temporal_filter_set_roi(ImageProcessing_Temporal_Filter_t *filter,
+                                             uint16_t x, uint16_t y, uint16_t roi_width, uint16_t roi_height);
+
+/**     :  first_line ... first_line + line_count - 1, lines -  
+*         (    ).
+*          (ov2640_capture_fragment_filtered),  
+*   ,      */
+void ImageProcessing_temporal_filter_update(ImageProcessing_Temporal_Filter_t *filter, uint8_t *lines,
+                                            uint32_t first_line, uint32_t line_count);
+
+/**          ( +  +-noise, frames )
+*   frame -  width*height , history - width*height/4 .   DWT ( DWT_Init),
+*       (HOST_BUILD) -   (Benchmark_Time, systick.h).
+*      - make -C tests bench */
+void ImageProcessing_temporal_filter_benchmark(ImageProcessing_Temporal_Filter_t *filter, uint8_t *frame,
+                                               uint8_t *history, uint32_t frames, uint8_t noise,
+                                               ImageProcessing_Temporal_Benchmark_t *result);
+
 /**********************************************************************************************************************/
-//        
+//         (fft32, fft64     N = 16 ... 4096)
+
+#include "fft.h"
+
+/**************************************************************************************   () */
+
+/**    IMAGE_FOCUS_TILE x IMAGE_FOCUS_TILE  ,   -  :
+*   - fft_ratio:     ( ,  )    
+*     IMAGE_FOCUS_CUTOFF   (  64 / 8 = 8 )    ,  
+*      .       ;
+*   - laplacian_variance:  ,     ,      .
+*             ( ),    */
+#define IMAGE_FOCUS_TILE        64
+#define IMAGE_FOCUS_CUTOFF      8
 
-#include <math.h>
-#include <complex.h>
+typedef struct
+{
+    float    fft_ratio;             //    0 ... 1
+    float    laplacian_variance;    //  
+    uint32_t fft_cycles;            //   ( DWT,    HOST_BUILD - )
+    uint32_t laplacian_cycles;
+    uint32_t frames;                //   
+}
+ImageProcessing_Focus_t;
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+/**    , tile -      , stride -  
+*   work - IMAGE_FOCUS_TILE * (IMAGE_FOCUS_TILE + 1)   (33 ) */
+float ImageProcessing_focus_fft(const uint8_t *tile, uint32_t stride, float complex *work);
 
-//   32 
-void fft32(const double complex input[32], double complex output[32]);
+/**     width x height */
+float ImageProcessing_focus_laplacian(const uint8_t *tile, uint32_t stride, uint32_t width, uint32_t height);
 
-//   64 
-void fft64(const double complex input[64], double complex output[64]);
+/**        ( -  focus) */
+void ImageProcessing_focus_update(ImageProcessing_Focus_t *focus, const uint8_t *tile, uint32_t stride,
+                                  float complex *work);
 
 #endif /* __IMAGE_PROCESSING_H__ */
\ No newline at end of file
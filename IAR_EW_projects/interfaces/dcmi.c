@@ -120,4 +120,72 @@ void DCMI_ClearFrameStatus(void) {
     //        
     DMA2->LIFCR = 0x00000F40;
     DCMI->ICR = 0x0000001F;
-}
\ No newline at end of file
+}
+
+/**
+  * @brief     JPEG  
+  *         max_words -    32-  (DMA ,    )
+  */
+void DCMI_StartCapture_JPEG(uint32_t *buffer, uint32_t max_words) {
+    DCMI->CR &= ~DCMI_CR_CAPTURE;
+
+    DMA2_Stream1->CR &= ~DMA_SxCR_EN;
+    while(DMA2_Stream1->CR & DMA_SxCR_EN);
+
+    //   :         JPEG
+
+    DMA2_Stream1->M0AR = (uint32_t)buffer;
+    DMA2_Stream1->NDTR = max_words;
+
+    DMA2->LIFCR = 0x00000F40;
+    DCMI->ICR = 0x0000001F;
+
+    //  JPEG: DCMI  HSYNC    ,   VSYNC.
+    //   CR (JPEG, CM)    ENABLE = 0
+    DCMI->CR &= ~DCMI_CR_ENABLE;
+    DCMI->CR |= DCMI_CR_JPEG;
+    DCMI->CR |= DCMI_CR_CM;            // Snapshot
+    DCMI->CR |= DCMI_CR_ENABLE;
+
+    DMA2_Stream1->CR |= DMA_SxCR_EN;
+    DCMI->CR |= DCMI_CR_CAPTURE;
+}
+
+/**
+  * @brief     JPEG (    while)
+  */
+uint8_t DCMI_IsJPEGFrameReady(void) {
+    uint32_t dmc_flags = DCMI->RISR;
+    uint32_t dma_flags = DMA2->LISR;
+
+    if (dma_flags & DMA_LISR_TEIF1) return 4;  // DMA Transfer Error
+    if (dmc_flags & DCMI_RISR_OVR_RIS) return 2;  // Overrun
+
+    //   ( VSYNC)      -      
+    if (dmc_flags & DCMI_RISR_FRAME_RIS) return 1;
+    if (dma_flags & DMA_LISR_TCIF1) return 1;
+
+    return 0;
+}
+
+/**
+  * @brief    JPEG,    32- 
+  */
+uint32_t DCMI_GetReceivedWords(uint32_t max_words) {
+    DCMI->CR &= ~DCMI_CR_CAPTURE;
+
+    //    DMA  FIFO   ,    NDTR 
+    DMA2_Stream1->CR &= ~DMA_SxCR_EN;
+    while(DMA2_Stream1->CR & DMA_SxCR_EN);
+
+    uint32_t received_words = max_words - DMA2_Stream1->NDTR;
+
+    //      -    DCMI
+    DCMI->CR &= ~DCMI_CR_ENABLE;
+    DCMI->CR &= ~DCMI_CR_JPEG;
+    DCMI->CR |= DCMI_CR_ENABLE;
+    DMA2->LIFCR = 0x00000F40;
+    DCMI->ICR = 0x0000001F;
+
+    return received_words;
+}
@@ -32,9 +32,11 @@ DMA 
 
 #include "stm32f4xx.h"
 
+#ifndef CAM_WIDTH  //        ov2640.h
 #define CAM_WIDTH        160
 #define CAM_HEIGHT       120
 #define CAM_FRAME_BYTES  (CAM_WIDTH * CAM_HEIGHT)
+#endif
 
 //  
 void DCMI_Init(void);
@@ -42,5 +44,15 @@ void DCMI_StartCapture(uint32_t *buffer);
 uint8_t DCMI_IsFrameReady(void);
 void DCMI_ClearFrameStatus(void);
 
+/**  JPEG:    , DMA    max_words ,
+*        FRAME ( VSYNC),      DMA */
+void DCMI_StartCapture_JPEG(uint32_t *buffer, uint32_t max_words);
+
+/**   JPEG: 0 -   , 1 -  ,     DCMI_IsFrameReady */
+uint8_t DCMI_IsJPEGFrameReady(void);
+
+/**  DMA (  FIFO  )      32-  */
+uint32_t DCMI_GetReceivedWords(uint32_t max_words);
+
 
 #endif /* __DCMI_H__ */
@@ -77,6 +77,21 @@ void SPI_Init_Mode_2(SPI_TypeDef* SPIx)
 
 /** Functions *********************************************************************************************************/
 
+// Инициализация модуля SPI в двунаправленном режиме (Mode 0: CPOL 0; CPHA 0; LSB first), модуль остается выключенным
+void SPI_Init_Bidirectional(SPI_TypeDef* SPIx, uint16_t SPI_baud_rate)
+{
+    SPI_RCC_Enable(SPIx);
+
+    SPIx->CR1 = 0;
+    SPIx->CR1 |= SPI_CR1_BIDIMODE;                  // Одна линия данных (MOSI у мастера) на прием и передачу
+    SPIx->CR1 |= SPI_CR1_BIDIOE;                    // Исходное направление - передача
+    SPIx->CR1 |= SPI_CR1_SSM;                       // Software slave management
+    SPIx->CR1 |= SPI_CR1_SSI;                       // Internal slave select
+    SPIx->CR1 |= SPI_CR1_LSBFIRST;                  // LSB first
+    SPIx->CR1 |= (SPI_baud_rate & SPI_CR1_BR);      // Делитель частоты
+    SPIx->CR1 |= SPI_CR1_MSTR;                      // Master mode
+}
+
 // Включение выбранного модуля SPI
 void SPI_Enable(SPI_TypeDef* SPIx)
 {
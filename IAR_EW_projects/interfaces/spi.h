@@ -70,6 +70,14 @@ typedef enum
 
 void SPI_Init_Mode_2(SPI_TypeDef* SPIx);
 
+	/**
+	! Настройка модуля SPI в двунаправленном режиме с одной линией данных (MOSI мастера): Mode 0, LSB first, 8 бит.
+		Модуль не включается (SPE = 0): направление BIDIOE и SPE переключает вызывающий код перед каждым обменом.
+	- SPIx - модуль SPI (SPI1, SPI2, SPI3)
+	- SPI_baud_rate - биты делителя SPI_CR1_BR (например SPI_CR1_BR_1 | SPI_CR1_BR_0 - Fpclk/16)
+	*/
+void SPI_Init_Bidirectional(SPI_TypeDef* SPIx, uint16_t SPI_baud_rate);
+
 	/**
 	! Включение выбранного модуля SPI (тактирование и настройка регистров)
 	- SPIx - модуль SPI (SPI1, SPI2, SPI3)
@@ -49,6 +49,53 @@ static void get_prescalers()
     freq_APB2 = SystemCoreClock / ppre2;
 }
 
+// Поток и канал DMA передатчика модуля UART/USART (RM0090, таблицы 42, 43)
+typedef struct
+{
+	DMA_TypeDef*		DMAx;
+	DMA_Stream_TypeDef*	stream;
+	uint32_t			stream_number;
+	uint32_t			channel;
+	uint32_t			rcc;
+}USART_DMA_t;
+
+static const USART_DMA_t* USART_Get_DMA(USART_TypeDef* USARTx)
+{
+	static const USART_DMA_t usart1 = {DMA2, DMA2_Stream7, 7, 4, RCC_AHB1ENR_DMA2EN};
+	static const USART_DMA_t usart2 = {DMA1, DMA1_Stream6, 6, 4, RCC_AHB1ENR_DMA1EN};
+	static const USART_DMA_t usart3 = {DMA1, DMA1_Stream3, 3, 4, RCC_AHB1ENR_DMA1EN};
+	static const USART_DMA_t uart4  = {DMA1, DMA1_Stream4, 4, 4, RCC_AHB1ENR_DMA1EN};
+	static const USART_DMA_t uart5  = {DMA1, DMA1_Stream7, 7, 4, RCC_AHB1ENR_DMA1EN};
+	static const USART_DMA_t usart6 = {DMA2, DMA2_Stream6, 6, 5, RCC_AHB1ENR_DMA2EN};
+
+	switch ((uint32_t)USARTx)
+	{
+		case ((uint32_t)USART1):	return &usart1;
+		case ((uint32_t)USART2):	return &usart2;
+		case ((uint32_t)USART3):	return &usart3;
+		case ((uint32_t)UART4):		return &uart4;
+		case ((uint32_t)UART5):		return &uart5;
+		case ((uint32_t)USART6):	return &usart6;
+	}
+	return 0;
+}
+
+// Флаги потока DMA (FEIF, DMEIF, TEIF, HTIF, TCIF): потоки 0-3 в LISR, 4-7 в HISR, сдвиг 0, 6, 16, 22
+static uint32_t USART_DMA_Flags(const USART_DMA_t* dma)
+{
+	static const uint8_t shift[4] = {0, 6, 16, 22};
+	uint32_t isr = (dma->stream_number < 4) ? dma->DMAx->LISR : dma->DMAx->HISR;
+	return (isr >> shift[dma->stream_number & 0x3]) & 0x3D;
+}
+
+static void USART_DMA_Clear_Flags(const USART_DMA_t* dma)
+{
+	static const uint8_t shift[4] = {0, 6, 16, 22};
+	uint32_t flags = 0x3DU << shift[dma->stream_number & 0x3];
+	if (dma->stream_number < 4)	dma->DMAx->LIFCR = flags;
+	else						dma->DMAx->HIFCR = flags;
+}
+
 // Включение тактирования модуля UART/USART
 static void USART_RCC_Enable(USART_TypeDef* USARTx)
 {
@@ -96,13 +143,17 @@ void USART_Enable(USART_Init_Struct* Init_Struct)
 	// Включение тактирования USARTx
 	USART_RCC_Enable(Init_Struct->USARTx);
 
+	// GPIO_port_Rx = NULL - только передатчик: пин приемника остается свободным (вместо него повторно настраивается Tx)
+	GPIO_TypeDef* port_Rx = Init_Struct->GPIO_port_Rx ? Init_Struct->GPIO_port_Rx : Init_Struct->GPIO_port_Tx;
+	int pin_Rx = Init_Struct->GPIO_port_Rx ? Init_Struct->GPIO_pin_Rx : Init_Struct->GPIO_pin_Tx;
+
 	// Включение тактирования GPIO, настройка заданных пинов приемника и передатчика в режиме AF (регистры MODER и AFR)
 	GPIO_Enable_USART(
 		Init_Struct->USARTx,
 		Init_Struct->GPIO_port_Tx,
 		Init_Struct->GPIO_pin_Tx,
-		Init_Struct->GPIO_port_Rx,
-		Init_Struct->GPIO_pin_Rx
+		port_Rx,
+		pin_Rx
 	);
 
 	// Настройка регистра BRR и включение модуля USARTx
@@ -192,6 +243,50 @@ USART_Status_t USART_Transmit_UINT8(USART_TypeDef* USARTx, uint8_t* data, uint32
 	return USART_OK;
 }
 
+// Запуск передачи size байт данных по USART через DMA
+USART_Status_t USART_Transmit_DMA(USART_TypeDef* USARTx, uint8_t* data, uint32_t size)
+{
+	const USART_DMA_t* dma = USART_Get_DMA(USARTx);
+	if ((dma == 0) || (size == 0) || (size > 0xFFFF)) return USART_ERROR_TRANSMIT;
+
+	// Предыдущая передача этого USART должна закончиться: поток DMA один
+	USART_Status_t status = USART_Wait_DMA(USARTx);
+
+	RCC->AHB1ENR |= dma->rcc;
+	dma->stream->CR &= ~DMA_SxCR_EN;
+	while (dma->stream->CR & DMA_SxCR_EN);
+	USART_DMA_Clear_Flags(dma);
+
+	dma->stream->CR = (dma->channel << DMA_SxCR_CHSEL_Pos)
+					| DMA_SxCR_MINC							// Инкремент адреса памяти
+					| (0x01 << DMA_SxCR_DIR_Pos);			// Направление: из памяти в периферию
+	dma->stream->FCR = 0;									// Прямой режим, байт за байтом в DR
+	dma->stream->PAR = (uint32_t)&(USARTx->DR);
+	dma->stream->M0AR = (uint32_t)data;
+	dma->stream->NDTR = size;
+
+	USARTx->CR3 |= USART_CR3_DMAT;		// Запросы DMA по TXE
+	dma->stream->CR |= DMA_SxCR_EN;
+	return status;
+}
+
+// Ожидание окончания передачи DMA
+USART_Status_t USART_Wait_DMA(USART_TypeDef* USARTx)
+{
+	const USART_DMA_t* dma = USART_Get_DMA(USARTx);
+	if (dma == 0) return USART_ERROR_TRANSMIT;
+	if (!(RCC->AHB1ENR & dma->rcc)) return USART_OK;		// DMA еще не включался
+
+	// При ошибке передачи (TEIF) поток выключается сам
+	while (dma->stream->CR & DMA_SxCR_EN);
+
+	if (USART_DMA_Flags(dma) & DMA_LISR_TEIF0)
+	{
+		USART_DMA_Clear_Flags(dma);
+		return USART_ERROR_TRANSMIT;
+	}
+	return USART_OK;
+}
 
 // Побайтный прием из USART до стопового байта
 USART_Status_t USART_Receive(USART_TypeDef* USARTx, char* buffer, char STOP_BYTE)
@@ -58,6 +58,7 @@ typedef enum
 	/**
 	! Включение и настройка модуля UART/USART с помощью созданной структуры инициализации.
 	- Init_Struct - структура инициализации, содержит всю информацию о включаемом модуле USART.
+	  GPIO_port_Rx = NULL - только передатчик, пин приемника не занимается.
 	*/
 void USART_Enable(USART_Init_Struct* Init_Struct);
 
@@ -90,6 +91,24 @@ USART_Status_t USART_Transmit(
 
 USART_Status_t USART_Transmit_UINT8(USART_TypeDef* USARTx, uint8_t* data, uint32_t size);
 
+	/**
+	! Передача данных по UART/USART через DMA (USART1 - DMA2 Stream7, USART2 - DMA1 Stream6, USART3 - DMA1 Stream3,
+	! UART4 - DMA1 Stream4, UART5 - DMA1 Stream7, USART6 - DMA2 Stream6). Функция только запускает передачу
+	! и сразу возвращается: data не должен меняться до завершения USART_Wait_DMA. Перед запуском дожидается
+	! предыдущей передачи этого USART.
+	- USARTx - выбранный модуль UART/USART.
+	- data - указатель на массив данных для передачи (SRAM: DMA не имеет доступа к CCM RAM).
+	- size - количество передаваемых байт (1 - 65535).
+	*/
+USART_Status_t USART_Transmit_DMA(USART_TypeDef* USARTx, uint8_t* data, uint32_t size);
+
+	/**
+	! Ожидание окончания передачи DMA, запущенной USART_Transmit_DMA. После возврата буфер можно менять
+	! (последний байт еще может сдвигаться передатчиком USART).
+	- USARTx - выбранный модуль UART/USART.
+	*/
+USART_Status_t USART_Wait_DMA(USART_TypeDef* USARTx);
+
 
 	/**
 	! Прием данных по UART/USART.
@@ -12,6 +12,23 @@
 #include "ov2640.h"
 #include "image_processing.h"
 #include "flash.h"
+#include "dcmi.h"
+
+/** 1 - камера выдает JPEG, кадр принимается через DCMI + DMA (подключение камеры по схеме из dcmi.h)
+*   0 - камера выдает YUV, кадр принимается программно через GPIO */
+#define CAMERA_JPEG_MODE    0
+
+/** 1 - после каждого кадра YUV оценка резкости центрального тайла отправляется по USART2 строкой
+*   "FOCUS <кадр> <fft_ratio * 10000> <дисперсия лапласиана>\r\n" (прием и развертка фокуса - focus_monitor.py)
+*   Только для настройки объектива: текст идет в тот же USART2, что и двоичные кадры по кнопке, и нужен
+*   рабочий буфер БПФ 33 КБ */
+#define FOCUS_STREAM        0
+
+/** 1 - при старте замер всех вариантов БПФ по счетчику DWT (FFT_Benchmark для N = 16 ... 1024), результат -
+*   в fft_benchmark (смотреть в отладчике): такты на одно прямое БПФ и отношение сигнал/шум. Затем пакетное БПФ
+*   256 точек x 8 каналов против 8 вызовов одиночного (FFT_Benchmark_Batch) - в fft_benchmark_batch.
+*   Рабочий буфер 32 КБ нужен только на время замера */
+#define FFT_BENCHMARK       0
 
 //uint8_t camera_packed_buffer[CAM_FRAME_BYTES / 8];  // 800 * 600 / 8 = 60000 байт
 
@@ -22,11 +39,34 @@ uint8_t camera_frame_fragment2[CAM_FRAME_BYTES / 5];
 uint8_t camera_frame_fragment3[CAM_FRAME_BYTES / 5];
 uint8_t camera_frame_fragment4[CAM_FRAME_BYTES / 5];
 
+#if FOCUS_STREAM
+// Тайл из только что захваченного фрагмента 0 (строки 0 ... CAM_HEIGHT / 5 - 1): по центру строки и высоты фрагмента
+#define FOCUS_TILE_X        ((CAM_WIDTH - IMAGE_FOCUS_TILE) / 2)
+#define FOCUS_TILE_Y        ((CAM_HEIGHT / 5 - IMAGE_FOCUS_TILE) / 2)
+
+ImageProcessing_Focus_t focus;                                          // последняя оценка резкости
+float complex focus_work[IMAGE_FOCUS_TILE * (IMAGE_FOCUS_TILE + 1)];    // рабочий буфер БПФ тайла
+#endif
+
+#if FFT_BENCHMARK
+#define FFT_BENCHMARK_MAX_SIZE  1024
+
+FFT_Benchmark_Result_t fft_benchmark[FFT_MAX_LOG2];                     // по размерам N = 16, 32, ... 1024
+uint32_t fft_benchmark_count = 0;                                       // заполнено элементов fft_benchmark
+FFT_Batch_Benchmark_t fft_benchmark_batch;                              // преобразований в секунду
+uint64_t fft_benchmark_work[32 * FFT_BENCHMARK_MAX_SIZE / 8];           // 32*N байт, выравнивание 8
+#endif
+
+#if CAMERA_JPEG_MODE
+uint32_t camera_jpeg_buffer[OV2640_JPEG_MAX_BYTES / 4];    // сжатый кадр, слова пишет DMA
+uint32_t camera_jpeg_length = 0;                            // длина последнего кадра JPEG в байтах
+#endif
+
 
 
 uint32_t lines_processed = 0;
 
-uint8_t camera_restart = 0;         // Сброс и повторная инициализация камеры (если камера ослепла после смены освещения ее достаточно сбросить и она все видит)
+uint8_t camera_restart = 0;         // Сброс и повторная инициализация камеры (выставляется, если регулятор экспозиции не смог вернуть камере нормальную яркость)
 uint8_t save_frame_to_FLASH = 0;    // Флаг, по которому образец запишется в Flash память
 
 float comparison_result = 0.0f; // результат сравнения текущего кадра с образцом в памяти
@@ -54,6 +94,32 @@ void RELEASE_Save_File(uint8_t *buffer, uint32_t size, const char* filename)
     USART_Transmit(USART2, (char*)buffer, size);
 }
 
+/** Отправить кадр JPEG на ПК
+*       Сначала 4 байта длины кадра (little-endian), затем сам кадр - приемнику не нужно искать конец файла */
+void RELEASE_Save_JPEG(uint8_t *buffer, uint32_t size)
+{
+    uint8_t header[4];
+    header[0] = size & 0xFF;
+    header[1] = (size >> 8) & 0xFF;
+    header[2] = (size >> 16) & 0xFF;
+    header[3] = (size >> 24) & 0xFF;
+
+    USART_Transmit_UINT8(USART2, header, 4);
+    USART_Transmit_UINT8(USART2, buffer, size);
+}
+
+
+/** Отправить оценку резкости на ПК одной текстовой строкой */
+void RELEASE_Send_Focus(const ImageProcessing_Focus_t *focus)
+{
+    char line[64];
+    int length = snprintf(line, sizeof(line), "FOCUS %lu %lu %lu\r\n",
+                          (unsigned long)focus->frames,
+                          (unsigned long)(focus->fft_ratio * 10000.0f + 0.5f),
+                          (unsigned long)(focus->laplacian_variance + 0.5f));
+
+    if (length > 0) USART_Transmit(USART2, line, (uint32_t)length);
+}
 
 
 int main(void)
@@ -61,10 +127,33 @@ int main(void)
     {   // Настройка STM32
     Clock_Config_168MHz_HSI();  // Тактовая частота процессора 168 МГц
     SysTick_Init();             // Включение системного таймера
+    DWT_Init();                 // Включение счетчика тактов (замеры скорости захвата и обработки)
 
     EXTI_Enable_Pin(EXTI_PortA, 0, EXTI_TRIGGER_FALLING);   // Включение обработки прерываний по нажатию кнопки
     }
 
+#if FFT_BENCHMARK
+    fft_benchmark_count = FFT_Benchmark(fft_benchmark_work, sizeof(fft_benchmark_work), fft_benchmark, FFT_MAX_LOG2);
+    FFT_Benchmark_Batch(fft_benchmark_work, sizeof(fft_benchmark_work), 256, 8, &fft_benchmark_batch);
+#endif
+
+#if CAMERA_JPEG_MODE
+    {   // Настройка выводов DCMI
+    GPIO_Enable_DCMI(GPIOB, 7);     // VSYNC
+    GPIO_Enable_DCMI(GPIOA, 4);     // HSYNC
+    GPIO_Enable_DCMI(GPIOA, 6);     // PIXCLK
+    GPIO_Enable_DCMI(GPIOC, 6);     // D0
+    GPIO_Enable_DCMI(GPIOA, 10);    // D1
+    GPIO_Enable_DCMI(GPIOC, 8);     // D2
+    GPIO_Enable_DCMI(GPIOC, 9);     // D3
+    GPIO_Enable_DCMI(GPIOC, 11);    // D4
+    GPIO_Enable_DCMI(GPIOB, 6);     // D5
+    GPIO_Enable_DCMI(GPIOB, 8);     // D6
+    GPIO_Enable_DCMI(GPIOB, 9);     // D7
+
+    DCMI_Init();
+    }
+#else
     {   // Настройка выводов, подключенных к камере
     // Входы синхронизации
     GPIO_Camera_Input_Enable(GPIOB, 5);    // VSYNC
@@ -81,6 +170,7 @@ int main(void)
     GPIO_Camera_Input_Enable(GPIOE, 14);  // D6
     GPIO_Camera_Input_Enable(GPIOE, 15);  // D7
     }
+#endif
 
     {   // Инициализация I2C2
     I2C_Enable(I2C2);
@@ -103,44 +193,82 @@ int main(void)
 /**********************************************************************************************************************/
     // Сброс и инициализация OV2640
     ov2640_Init(0x30);
+#if CAMERA_JPEG_MODE
+    ov2640_Set_JPEG_Mode(0x30);     // экспозицию ведет автомат камеры: регулятору нужны байты яркости
+#else
+    ov2640_Exposure_Init(0x30);
+    ov2640_Measure_Fast_Kernel();   // стоимость пикселя быстрого захвата -> ov2640_fast_max_pclk_khz (смотреть в отладчике)
+#endif
 /**********************************************************************************************************************/
 
-/*    // БПФ 64 точки
+/*    // БПФ 64 точки вещественного сигнала (33 уникальных бина, остальные - комплексно сопряженные)
     while (1)
     {
-        double complex signal[64];      // Сигнал, который нужно разложить на спектр
-        double complex spectrum[64];    // Спектр исходного сигнала
+        float signal[64];               // Сигнал, который нужно разложить на спектр
+        float complex spectrum[33];     // Спектр исходного сигнала: X[0] ... X[32]
 
         // Генерируем тестовый сигнал: гармоника на частоте k=3
-        // Формула: x(n) = sin(2*pi*3*n/32)
+        // Формула: x(n) = sin(2*pi*3*n/64)
         for (int n = 0; n < 64; ++n)
         {
-            double angle = 2.0 * M_PI * 3.0 * n / 64.0;
-            signal[n] = 1+sin(angle) + 0.0 * I;
+            float angle = 2.0f * (float)M_PI * 3.0f * n / 64.0f;
+            signal[n] = 1 + sinf(angle);
         }
 
-        fft64(signal, spectrum);
+        FFT_Forward_Real_F32(signal, spectrum, 64);
 
-        printf("--- Точный спектр 64-точечного БПФ ---\n");
-        for (int k = 0; k < 64; ++k)
+        printf("--- Спектр 64-точечного БПФ вещественного сигнала ---\n");
+        for (int k = 0; k <= 32; ++k)
         {
-            double re = creal(spectrum[k]);
-            double im = cimag(spectrum[k]);
+            float re = crealf(spectrum[k]);
+            float im = cimagf(spectrum[k]);
 
-            // Убираем шумы окружения float чисел (все что меньше 1e-5 приравниваем к 0)
-            if (fabs(re) < 1e-5) re = 0.0;
-            if (fabs(im) < 1e-5) im = 0.0;
+            // Убираем шумы окружения float чисел (все что меньше 1e-4 приравниваем к 0)
+            if (fabsf(re) < 1e-4f) re = 0.0f;
+            if (fabsf(im) < 1e-4f) im = 0.0f;
 
-            printf("X[%2d] = %8.4f %s %8.4fj\n", k, re, (im >= 0 ? "+" : "-"), fabs(im));
+            printf("X[%2d] = %8.4f %s %8.4fj\n", k, re, (im >= 0 ? "+" : "-"), fabsf(im));
         }
     }
 */
 
+#if CAMERA_JPEG_MODE
+    while(1)
+    {
+        camera_jpeg_length = ov2640_capture_jpeg(camera_jpeg_buffer, OV2640_JPEG_MAX_BYTES / 4);
+
+        // По нажатию кнопки сжатый кадр отправляется на ПК (20-30 КБ вместо 480 КБ яркости)
+        if (Interrupt_EXTI0_Occured)
+        {
+            if (camera_jpeg_length) RELEASE_Save_JPEG((uint8_t*)camera_jpeg_buffer, camera_jpeg_length);
+            Interrupt_EXTI0_Occured = 0;
+        }
+
+        if (camera_restart)
+        {
+            ov2640_Init(0x30);
+            ov2640_Set_JPEG_Mode(0x30);
+            camera_restart = 0;
+        }
+    }
+#endif
+
     while(1)
     {
         ov2640_count_pixels_in_frame();
         //int rec = ov2640_capture_and_process(camera_packed_buffer, CAM_WIDTH, CAM_HEIGHT, 1);   // захват кадра с обработкой на месте
         int result0 = ov2640_capture_fragment(camera_frame_fragment0, CAM_WIDTH, CAM_HEIGHT);
+
+        // Подстройка экспозиции по захваченному фрагменту; полный сброс камеры - только если регулятор не справился
+        ov2640_AE_Status_t exposure_status = ov2640_Exposure_Update(0x30, camera_frame_fragment0, sizeof(camera_frame_fragment0));
+        if (exposure_status == OV2640_AE_NOT_CONVERGED || exposure_status == OV2640_AE_I2C_ERROR) camera_restart = 1;
+
+#if FOCUS_STREAM
+        // Резкость по каждому кадру - для ручной настройки объектива или автоматической развертки фокуса с ПК
+        ImageProcessing_focus_update(&focus, &camera_frame_fragment0[FOCUS_TILE_Y * CAM_WIDTH + FOCUS_TILE_X],
+                                     CAM_WIDTH, focus_work);
+        RELEASE_Send_Focus(&focus);
+#endif
 //        int result1 = ov2640_capture_fragment(camera_frame_fragment1, CAM_WIDTH, CAM_HEIGHT);
 //        int result2 = ov2640_capture_fragment(camera_frame_fragment2, CAM_WIDTH, CAM_HEIGHT);
 //        int result3 = ov2640_capture_fragment(camera_frame_fragment3, CAM_WIDTH, CAM_HEIGHT);
@@ -170,6 +298,7 @@ int main(void)
         if (camera_restart)
         {
             ov2640_Init(0x30);
+            ov2640_Exposure_Init(0x30);
             camera_restart = 0;
         }
     }
@@ -1,7 +1,11 @@
+#include <stddef.h>
 #include "ov2640.h"
+#ifndef OV2640_DVP_EMULATOR
 #include "i2c.h"
 #include "gpio.h"
 #include "systick.h"
+#include "dcmi.h"
+#endif
 
 uint32_t frame_start_us = 0;        //      (VSYNC  )
 uint32_t frame_end_us = 0;          //      (VSYNC  )
@@ -228,6 +232,76 @@ void ov2640_Init(uint8_t device_address)
 
 
 
+/**  DSP    JPEG */
+void ov2640_Set_JPEG_Mode(uint8_t device_address)
+{
+    I2C_Status_t I2C_status;    //   /  I2C
+
+    I2C_status = I2C_Write_Reg(I2C2, device_address, 0xff, 0x00); delay_ms(5);	//     Table 0
+    I2C_status = I2C_Write_Reg(I2C2, device_address, 0x05, 0x00); delay_ms(5);	// R_BYPASS ( DSP,     )
+    I2C_status = I2C_Write_Reg(I2C2, device_address, 0xe0, 0x14); delay_ms(5);	// RESET ( JPEG + DVP)
+    I2C_status = I2C_Write_Reg(I2C2, device_address, 0xe1, 0x77); delay_ms(5);	// RESERVED (    JPEG)
+    I2C_status = I2C_Write_Reg(I2C2, device_address, 0xe5, 0x1f); delay_ms(5);	// RESERVED (    JPEG)
+    I2C_status = I2C_Write_Reg(I2C2, device_address, 0xd7, 0x03); delay_ms(5);	// RESERVED (    JPEG)
+    I2C_status = I2C_Write_Reg(I2C2, device_address, 0xda, 0x10); delay_ms(5);	// IMAGE_MODE:  JPEG
+    I2C_status = I2C_Write_Reg(I2C2, device_address, 0x44, 0x0c); delay_ms(5);	// QS:   ( -      )
+    I2C_status = I2C_Write_Reg(I2C2, device_address, 0xe0, 0x00); delay_ms(5);	// RESET ( JPEG + DVP)
+
+    if (I2C_status != I2C_OK)
+    {
+        GPIO_set_HIGH(GPIOD, 14);   //  -     JPEG
+    }
+}
+
+/**    JPEG (0xFF 0xD9)  */
+uint32_t ov2640_jpeg_find_end(const uint32_t *buffer, uint32_t words)
+{
+    if (buffer == 0 || words == 0) return 0;
+
+    //      SOI 0xFF 0xD8 (      little-endian)
+    if ((buffer[0] & 0xFFFF) != 0xD8FF) return 0;
+
+    uint8_t previous_is_FF = 0; //     0xFF -      
+
+    for (uint32_t i = 0; i < words; i++)
+    {
+        uint32_t word = buffer[i];
+
+        if (previous_is_FF && (word & 0xFF) == 0xD9) return i * 4 + 1;
+
+        //  :      , ..  0xFF   .
+        //    0xFF  ,       
+        uint32_t inverted = ~word;
+        if ((inverted - 0x01010101U) & ~inverted & 0x80808080U)
+        {
+            if ((word & 0x0000FFFFU) == 0x0000D9FFU) return i * 4 + 2;
+            if ((word & 0x00FFFF00U) == 0x00D9FF00U) return i * 4 + 3;
+            if ((word & 0xFFFF0000U) == 0xD9FF0000U) return i * 4 + 4;
+        }
+        previous_is_FF = ((word >> 24) == 0xFF);
+    }
+    return 0;
+}
+
+/**   JPEG  DCMI + DMA */
+uint32_t ov2640_capture_jpeg(uint32_t *buffer, uint32_t max_words)
+{
+    uint8_t status = 0;
+
+    DCMI_StartCapture_JPEG(buffer, max_words);
+
+    uint32_t start_time_ms = get_current_ms();
+    while ((status = DCMI_IsJPEGFrameReady()) == 0)
+    {
+        if (is_time_passed_ms(start_time_ms, OV2640_JPEG_TIMEOUT_MS)) break;
+    }
+
+    uint32_t received_words = DCMI_GetReceivedWords(max_words);
+    if (status != 1) return 0;
+
+    return ov2640_jpeg_find_end(buffer, received_words);
+}
+
 
 
 /**      */
@@ -256,7 +330,7 @@ int ov2640_capture_snapshot(uint8_t *buffer, int width, int height)
         {
             //   ( )
             while (!DCLK_IS_HIGH);
-            *p_buf++ = (uint8_t)((DATA_PORT->IDR >> 8) & 0xFF);
+            *p_buf++ = DVP_READ_DATA();
             while (DCLK_IS_HIGH);
 
             //   ( )
@@ -304,7 +378,7 @@ int ov2640_capture_and_process(uint8_t *packed_buffer,              // 
         {
             //   ( )
             while (!DCLK_IS_HIGH);
-            uint8_t current_pixel = (uint8_t)((DATA_PORT->IDR >> 8) & 0xFF);
+            uint8_t current_pixel = DVP_READ_DATA();
             while (DCLK_IS_HIGH);
 
             if (get_binary)
@@ -341,6 +415,124 @@ int ov2640_capture_and_process(uint8_t *packed_buffer,              // 
 }
 
 
+/**********************************************************************************     */
+
+uint32_t ov2640_fast_cycles_per_pixel = 0;  //    1  ( ov2640_Measure_Fast_Kernel)
+uint32_t ov2640_fast_max_pclk_khz = 0;      //   PCLK  ov2640_capture_and_process_fast
+
+/**    : p < 150 => p*p/150,  255 (     ) */
+static const uint8_t fast_tone_curve[256] =
+{
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,
+      1,   1,   2,   2,   2,   2,   3,   3,   3,   4,   4,   4,   5,   5,   6,   6,
+      6,   7,   7,   8,   8,   9,   9,  10,  10,  11,  11,  12,  12,  13,  14,  14,
+     15,  16,  16,  17,  18,  18,  19,  20,  20,  21,  22,  23,  24,  24,  25,  26,
+     27,  28,  29,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  41,
+     42,  43,  44,  45,  47,  48,  49,  50,  51,  52,  54,  55,  56,  57,  58,  60,
+     61,  62,  64,  65,  66,  68,  69,  70,  72,  73,  74,  76,  77,  79,  80,  82,
+     83,  85,  86,  88,  89,  91,  92,  94,  96,  97,  99, 100, 102, 104, 105, 107,
+    109, 110, 112, 114, 116, 117, 119, 121, 123, 125, 126, 128, 130, 132, 134, 136,
+    138, 140, 142, 144, 146, 148, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+};
+
+/**  0.85   : (x * 1741) >> 11 == x * 85 / 100   x = 0..255 */
+#define FAST_THRESHOLD_MUL      1741
+#define FAST_THRESHOLD_SHIFT    11
+#define FAST_AVERAGE_SHIFT      5
+
+/**          bit  ( ) */
+#define FAST_PACK_PIXEL(data, bit)                                                                              \
+{                                                                                                               \
+    uint32_t pixel = fast_tone_curve[(data)];                                                                   \
+    running_average += pixel - (running_average >> FAST_AVERAGE_SHIFT);                                         \
+    uint32_t threshold = ((running_average >> FAST_AVERAGE_SHIFT) * FAST_THRESHOLD_MUL) >> FAST_THRESHOLD_SHIFT; \
+    accumulator |= (uint32_t)(pixel > threshold) << (bit);                                                      \
+}
+
+/**    DVP:     DCLK,  ,  DCLK 
+*   WAIT_HIGH/WAIT_LOW -     DCLK (     ) */
+#define FAST_CAPTURE_PIXEL(bit, WAIT_HIGH, WAIT_LOW)    \
+{                                                       \
+    WAIT_HIGH;                                          \
+    uint32_t data = DVP_READ_DATA_FAST();               \
+    WAIT_LOW;                                           \
+    FAST_PACK_PIXEL(data, bit)                          \
+}
+
+/** 8      ,   -   (  ov2640_capture_and_process) */
+#define FAST_CAPTURE_BYTE(WAIT_HIGH, WAIT_LOW)          \
+{                                                       \
+    uint32_t accumulator = 0;                           \
+    FAST_CAPTURE_PIXEL(7, WAIT_HIGH, WAIT_LOW)          \
+    FAST_CAPTURE_PIXEL(6, WAIT_HIGH, WAIT_LOW)          \
+    FAST_CAPTURE_PIXEL(5, WAIT_HIGH, WAIT_LOW)          \
+    FAST_CAPTURE_PIXEL(4, WAIT_HIGH, WAIT_LOW)          \
+    FAST_CAPTURE_PIXEL(3, WAIT_HIGH, WAIT_LOW)          \
+    FAST_CAPTURE_PIXEL(2, WAIT_HIGH, WAIT_LOW)          \
+    FAST_CAPTURE_PIXEL(1, WAIT_HIGH, WAIT_LOW)          \
+    FAST_CAPTURE_PIXEL(0, WAIT_HIGH, WAIT_LOW)          \
+    *p_packed++ = (uint8_t)accumulator;                 \
+}
+
+/**   +    + ,    8  */
+int ov2640_capture_and_process_fast(uint8_t *packed_buffer, int width, int height)
+{
+    int lines_processed = 0;
+    uint8_t *p_packed = packed_buffer;
+    uint32_t running_average = 30 << FAST_AVERAGE_SHIFT;    //    30
+
+    while (VSYNC_IS_HIGH)   { SysTick_Update_us(); }    //     -   
+    while (!VSYNC_IS_HIGH)  { SysTick_Update_us(); }    //    
+
+    for (int y = 0; y < height; y++)
+    {
+        while (!HREF_IS_HIGH);  //   
+
+        for (int x = 0; x < width; x += 8)
+        {
+            FAST_CAPTURE_BYTE(while (!DCLK_IS_HIGH) {}, while (DCLK_IS_HIGH) {})
+        }
+        lines_processed++;
+
+        while (HREF_IS_HIGH);   //   
+    }
+    return lines_processed;
+}
+
+/**      */
+uint32_t ov2640_Measure_Fast_Kernel(void)
+{
+    static uint8_t packed_line[CAM_WIDTH / 8];
+    uint8_t *p_packed = packed_line;
+    uint32_t running_average = 30 << FAST_AVERAGE_SHIFT;
+
+    uint32_t start = DWT_Get_Cycles();
+    for (int x = 0; x < CAM_WIDTH; x += 8)
+    {
+        FAST_CAPTURE_BYTE((void)DCLK_IS_HIGH, (void)DCLK_IS_HIGH)     //   DCLK   
+    }
+    uint32_t cycles = DWT_Get_Cycles() - start;
+
+    ov2640_fast_cycles_per_pixel = (cycles + CAM_WIDTH - 1) / CAM_WIDTH;
+    ov2640_fast_max_pclk_khz = 168000 / ov2640_fast_cycles_per_pixel;     //   168 
+    return ov2640_fast_cycles_per_pixel;
+}
+
+/**   PCLK */
+void ov2640_Set_PCLK_Divider(uint8_t device_address, uint8_t divider)
+{
+    I2C_Write_Reg(I2C2, device_address, 0xff, 0x00); delay_ms(5);              //     Table 0
+    I2C_Write_Reg(I2C2, device_address, 0xd3, divider & 0x7f); delay_ms(5);    // R_DVP_SP: PCLK = sysclk / (divider + 1),  
+}
+/**********************************************************************************************************************/
+
+
 //      ,       +   
 ///**   +    +     */
 //int ov2640_capture_and_process(uint8_t *buffer,                     //  
@@ -518,8 +710,8 @@ void ov2640_Reset()
 
 
 
-/**     */
-int ov2640_capture_fragment(uint8_t *buffer, int width, int height)
+/**    , filter != NULL -        */
+static int capture_fragment(uint8_t *buffer, int width, int height, ImageProcessing_Temporal_Filter_t *filter)
 {
     int lines_processed = 0;
     uint8_t *p_buf = buffer;
@@ -555,11 +747,17 @@ int ov2640_capture_fragment(uint8_t *buffer, int width, int height)
             for (int x = 0; x < width; x++)
             {
                 while (!DCLK_IS_HIGH);
-                *p_buf++ = (uint8_t)((DATA_PORT->IDR >> 8) & 0xFF);
+                *p_buf++ = DVP_READ_DATA();
                 while (DCLK_IS_HIGH);
             }
             while (HREF_IS_HIGH);   //   
         }
+        //      -       
+        if (filter != NULL)
+        {
+            ImageProcessing_temporal_filter_update(filter, p_buf - fragment_height * width, start_line_number, fragment_height);
+        }
+
         start_line_number += fragment_height;   //       50 
         lines_processed += fragment_height;     //  50   
 
@@ -569,6 +767,28 @@ int ov2640_capture_fragment(uint8_t *buffer, int width, int height)
     return lines_processed;
 }
 
+/**     */
+int ov2640_capture_fragment(uint8_t *buffer, int width, int height)
+{
+    return capture_fragment(buffer, width, height, NULL);
+}
+
+/**     +       */
+int ov2640_capture_fragment_filtered(uint8_t *buffer, int width, int height, ImageProcessing_Temporal_Filter_t *filter)
+{
+    return capture_fragment(buffer, width, height, filter);
+}
+
+
+
+
+
+
+
+
+
+
+
 
 
 
@@ -582,11 +802,134 @@ int ov2640_capture_fragment(uint8_t *buffer, int width, int height)
 
 
 
+/****************************************     (AEC/AGC) ***********************************/
+ov2640_exposure_t ov2640_exposure = {0};
 
+//  GAIN:   7..4  ,  3..0   1/16
+static const uint8_t gain_octave_bits[5] = {0x00, 0x10, 0x30, 0x70, 0xF0};
 
+/**   gain_index  1/16  (16 == x1) */
+static uint32_t gain_index_to_x16(uint8_t gain_index)
+{
+    return (16U + (gain_index & 0x0F)) << (gain_index >> 4);
+}
+
+/**        1/16  */
+static uint8_t gain_x16_to_index(uint32_t gain_x16)
+{
+    uint8_t octave = 0;
+    while (gain_x16 >= 32 && octave < 4)
+    {
+        gain_x16 >>= 1;
+        octave++;
+    }
+    if (gain_x16 < 16) gain_x16 = 16;
+    if (gain_x16 > 31) gain_x16 = 31;
+    return (octave << 4) | (gain_x16 - 16);
+}
+
+/**        */
+static I2C_Status_t write_exposure(uint8_t device_address, uint16_t exposure, uint8_t gain_index)
+{
+    I2C_Status_t I2C_status = I2C_Write_Reg(I2C2, device_address, 0xff, 0x01);                          // Table 1
+    if (I2C_status == I2C_OK) I2C_status = I2C_Write_Reg(I2C2, device_address, 0x45, (exposure >> 10) & 0x3F);  // REG45: AEC[15:10]
+    if (I2C_status == I2C_OK) I2C_status = I2C_Write_Reg(I2C2, device_address, 0x10, (exposure >> 2) & 0xFF);   // AEC: AEC[9:2]
+    if (I2C_status == I2C_OK) I2C_status = I2C_Write_Reg(I2C2, device_address, 0x04, 0xc8 | (exposure & 0x03)); // REG04: HREF +    ov2640_Init, AEC[1:0]
+    if (I2C_status == I2C_OK) I2C_status = I2C_Write_Reg(I2C2, device_address, 0x00,
+                                                         gain_octave_bits[gain_index >> 4] | (gain_index & 0x0F)); // GAIN
+    return I2C_status;
+}
+
+/**         */
+void ov2640_Exposure_Init(uint8_t device_address)
+{
+    uint8_t gain = 0, aec = 0, reg04 = 0, reg45 = 0;
 
+    //   - ,     
+    I2C_Status_t I2C_status = I2C_Write_Reg(I2C2, device_address, 0xff, 0x01);     // Table 1
+    if (I2C_status == I2C_OK) I2C_status = I2C_Read_Reg(I2C2, device_address, 0x00, &gain);
+    if (I2C_status == I2C_OK) I2C_status = I2C_Read_Reg(I2C2, device_address, 0x10, &aec);
+    if (I2C_status == I2C_OK) I2C_status = I2C_Read_Reg(I2C2, device_address, 0x04, &reg04);
+    if (I2C_status == I2C_OK) I2C_status = I2C_Read_Reg(I2C2, device_address, 0x45, &reg45);
 
+    uint32_t exposure = ((uint32_t)(reg45 & 0x3F) << 10) | ((uint32_t)aec << 2) | (reg04 & 0x03);
+    if (exposure < OV2640_AEC_MIN) exposure = OV2640_AEC_MIN;
+    if (exposure > OV2640_AEC_MAX) exposure = OV2640_AEC_MAX;
 
+    uint8_t octave = 0;
+    for (uint8_t bit = 4; bit < 8; bit++)
+    {
+        if (gain & (1 << bit)) octave++;
+    }
 
+    ov2640_exposure.exposure = exposure;
+    ov2640_exposure.gain_index = (octave << 4) | (gain & 0x0F);
+    ov2640_exposure.unstable_frames = 0;
 
+    // COM8:   AEC ( 0)  AGC ( 2),    ov2640_Exposure_Update;
+    //     50/60  ( 5)  
+    I2C_Write_Reg(I2C2, device_address, 0x13, 0xe0);
+    write_exposure(device_address, ov2640_exposure.exposure, ov2640_exposure.gain_index);
+}
 
+/**         */
+ov2640_AE_Status_t ov2640_Exposure_Update(uint8_t device_address, const uint8_t *buffer, uint32_t size)
+{
+    if (buffer == 0 || size == 0) return OV2640_AE_OK;
+
+    //    4- :     ,    4  
+    uint32_t sum = 0;
+    uint32_t count = 0;
+    for (uint8_t i = 0; i < 16; i++) ov2640_exposure.histogram[i] = 0;
+    for (uint32_t i = 0; i < size; i += 4)
+    {
+        uint8_t pixel = buffer[i];
+        ov2640_exposure.histogram[pixel >> 4]++;
+        sum += pixel;
+        count++;
+    }
+    uint32_t mean = sum / count;
+    ov2640_exposure.mean = mean;
+
+    int32_t error = (int32_t)mean - OV2640_AE_TARGET;
+    if (error <= OV2640_AE_TOLERANCE && error >= -OV2640_AE_TOLERANCE)
+    {
+        ov2640_exposure.unstable_frames = 0;
+        return OV2640_AE_OK;
+    }
+
+    //     (     ) -  ,   
+    ov2640_exposure.unstable_frames++;
+    if (ov2640_exposure.unstable_frames > OV2640_AE_MAX_UNSTABLE) return OV2640_AE_NOT_CONVERGED;
+
+    //   ( * )       ,
+    //      2   ,    
+    uint32_t total = ov2640_exposure.exposure * gain_index_to_x16(ov2640_exposure.gain_index);
+    uint32_t new_total = (mean == 0) ? total * 2 : total * OV2640_AE_TARGET / mean;
+    if (new_total > total * 2) new_total = total * 2;
+    if (new_total < total / 2) new_total = total / 2;
+
+    //    (  ),  -     
+    uint32_t exposure;
+    uint8_t gain_index;
+    if (new_total <= OV2640_AEC_MAX * 16)
+    {
+        exposure = new_total / 16;
+        gain_index = 0;
+    }
+    else
+    {
+        exposure = OV2640_AEC_MAX;
+        gain_index = gain_x16_to_index(new_total / OV2640_AEC_MAX);
+    }
+    if (exposure < OV2640_AEC_MIN) exposure = OV2640_AEC_MIN;
+    if (gain_index > OV2640_GAIN_INDEX_MAX) gain_index = OV2640_GAIN_INDEX_MAX;
+
+    if (exposure != ov2640_exposure.exposure || gain_index != ov2640_exposure.gain_index)
+    {
+        ov2640_exposure.exposure = exposure;
+        ov2640_exposure.gain_index = gain_index;
+        if (write_exposure(device_address, exposure, gain_index) != I2C_OK) return OV2640_AE_I2C_ERROR;
+    }
+    return OV2640_AE_ADJUSTING;
+}
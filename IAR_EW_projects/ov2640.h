@@ -2,11 +2,27 @@
 #define __OV2640_H__
 
 #include <stdint.h>
+#include "image_processing.h"
 
 #define CAM_WIDTH        800
 #define CAM_HEIGHT       600
 #define CAM_FRAME_BYTES  (CAM_WIDTH * CAM_HEIGHT)   //      1 
 
+/**  DVP 
+*             GPIO.      OV2640_DVP_EMULATOR
+*         (ov2640_dvp_emulator.c),     */
+#ifdef OV2640_DVP_EMULATOR
+
+#include "ov2640_dvp_emulator.h"
+
+#define VSYNC_IS_HIGH   (DVP_Emulator_VSYNC())
+#define HREF_IS_HIGH    (DVP_Emulator_HREF())
+#define DCLK_IS_HIGH    (DVP_Emulator_DCLK())
+#define DVP_READ_DATA() (DVP_Emulator_Data())
+#define DVP_READ_DATA_FAST() (DVP_Emulator_Data())
+
+#else
+
 #define VSYNC_PORT      GPIOB
 #define VSYNC_PIN       (1 << 5)
 #define VSYNC_IS_HIGH   (VSYNC_PORT->IDR & VSYNC_PIN)
@@ -20,7 +36,17 @@
 #define DCLK_IS_HIGH    (DCLK_PORT->IDR & DCLK_PIN)
 
 #define DATA_PORT       GPIOE
+#define DVP_READ_DATA() ((uint8_t)((DATA_PORT->IDR >> 8) & 0xFF))   // D0..D7   PE8..PE15
 
+//      LDRB:     IDR (   GPIO ),
+//    .   ov2640_capture_and_process_fast
+#define DVP_READ_DATA_FAST() (*((volatile uint8_t*)&DATA_PORT->IDR + 1))
+
+#endif
+
+/**  JPEG (  DCMI + DMA,      dcmi.h) */
+#define OV2640_JPEG_MAX_BYTES   40960   //      SVGA ( QS = 0x0C   15-30 )
+#define OV2640_JPEG_TIMEOUT_MS  500     //      JPEG
 
 
 typedef struct
@@ -30,6 +56,35 @@ typedef struct
 }
 ov2640_reg_t;
 
+/**     (AEC/AGC)    */
+#define OV2640_AE_TARGET            100     //    
+#define OV2640_AE_TOLERANCE         12      //      
+#define OV2640_AE_MAX_UNSTABLE      12      //      -   
+#define OV2640_AEC_MIN              4       //    
+#define OV2640_AEC_MAX              1200    //     (    SVGA)
+#define OV2640_GAIN_INDEX_MAX       79      //  x1 ... x31 (5   16 )
+
+typedef enum
+{
+    OV2640_AE_OK = 0,               //   ,   
+    OV2640_AE_ADJUSTING = 1,        // / ,   
+    OV2640_AE_NOT_CONVERGED = 2,    //    -    
+    OV2640_AE_I2C_ERROR = 3         //     I2C -    
+}
+ov2640_AE_Status_t;
+
+typedef struct
+{
+    uint16_t exposure;          // AEC[15:0],   
+    uint8_t  gain_index;        //    (0 - x1)
+    uint8_t  mean;              //    
+    uint8_t  unstable_frames;   //     
+    uint32_t histogram[16];     //     (16   16 )
+}
+ov2640_exposure_t;
+
+extern ov2640_exposure_t ov2640_exposure;
+
 
 /**  ID  */
 void ov2640_Read_ID(uint8_t device_address);
@@ -61,11 +116,59 @@ int ov2640_capture_and_process(uint8_t *packed_buffer,  // 
 //                                           uint8_t get_binary);     //  "  "
 
 
+/**    +    +  ( ,  ov2640_capture_and_process  get_binary = 1)
+*      8  (1   ), width    8.
+*       ov2640_Measure_Fast_Kernel */
+int ov2640_capture_and_process_fast(uint8_t *packed_buffer, int width, int height);
+
+/**     ov2640_capture_and_process_fast   DWT ( DWT_Init)
+*             DCLK,   
+*     DCLK (  ,    ).
+*     ov2640_fast_cycles_per_pixel  ov2640_fast_max_pclk_khz.
+*        :    (tests/ov2640_test.c)      .
+*       , ov2640_Init  PCLK 750 .
+*   return:     (  ) */
+uint32_t ov2640_Measure_Fast_Kernel(void);
+
+extern uint32_t ov2640_fast_cycles_per_pixel;   //    1  ( DVP)
+extern uint32_t ov2640_fast_max_pclk_khz;       //   PCLK,      
+
+/**   PCLK ( R_DVP_SP): PCLK = sysclk / (divider + 1), divider = 0..127
+*   ov2640_Init  0x0F (750 ).   ,   PCLK <= ov2640_fast_max_pclk_khz */
+void ov2640_Set_PCLK_Divider(uint8_t device_address, uint8_t divider);
+
 /**     */
 int ov2640_capture_fragment(uint8_t *buffer, int width, int height);
 
+/**        (  )
+*      50    ImageProcessing_temporal_filter_update   ,
+*       .  buffer -   */
+int ov2640_capture_fragment_filtered(uint8_t *buffer, int width, int height, ImageProcessing_Temporal_Filter_t *filter);
+
+
+
+
+/**  DSP    JPEG (  ov2640_Init) */
+void ov2640_Set_JPEG_Mode(uint8_t device_address);
+
+/**   JPEG  DCMI + DMA
+*   buffer -    , max_words -    32- 
+*   return:  JPEG   (0 -        ) */
+uint32_t ov2640_capture_jpeg(uint32_t *buffer, uint32_t max_words);
+
+/**    JPEG (0xFF 0xD9)   
+*   return:  JPEG     , 0 -    */
+uint32_t ov2640_jpeg_find_end(const uint32_t *buffer, uint32_t words);
+
 
+/**        
+*        (,     )
+*      ov2640_Exposure_Update   :   JPEG     */
+void ov2640_Exposure_Init(uint8_t device_address);
 
+/**         ( )
+*      ,  AEC/AGC      2    */
+ov2640_AE_Status_t ov2640_Exposure_Update(uint8_t device_address, const uint8_t *buffer, uint32_t size);
 
 /**   ,  ,        */
 void ov2640_count_pixels_in_frame();
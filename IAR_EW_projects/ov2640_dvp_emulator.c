@@ -0,0 +1,271 @@
+/***********************************************************************************************************************
+*   Эмулятор камеры OV2640 для сборки на ПК (см. ov2640_dvp_emulator.h)
+***********************************************************************************************************************/
+
+#ifdef OV2640_DVP_EMULATOR
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ov2640_dvp_emulator.h"
+
+static DVP_Emulator_Config_t emulator_config;
+static uint8_t *stream_data = NULL;     // байты шины данных, прочитанные из файла
+static uint32_t stream_size = 0;
+static uint64_t virtual_cycles = 0;     // виртуальное время в тактах процессора
+
+static uint8_t  i2c_registers[2][256];  // регистры камеры (банки Table 0 и Table 1) для замены I2C
+static uint8_t  i2c_bank = 0;
+
+static const uint8_t *jpeg_data = NULL; // кадр JPEG для замены DCMI (DVP_Emulator_Set_JPEG)
+static uint32_t jpeg_size = 0;
+static uint32_t jpeg_words = 0;         // слов, "принятых" последним захватом
+
+/************************************************************************************************ Временная диаграмма */
+
+/** Состояние линий DVP в момент времени t */
+typedef struct
+{
+    uint32_t vsync;
+    uint32_t href;
+    uint32_t dclk;
+    uint64_t data_index;    // номер байта потока, который сейчас выставлен на шину
+}
+DVP_State_t;
+
+/** Детерминированный сдвиг фронта DCLK (одинаковый при каждом обращении к одному и тому же такту) */
+static uint32_t jitter_offset(uint64_t frame, uint32_t line, uint32_t clock)
+{
+    if (emulator_config.jitter == 0) return 0;
+
+    uint32_t x = emulator_config.seed;
+    x ^= (uint32_t)frame * 0x9E3779B1U;
+    x ^= line * 0x85EBCA77U;
+    x ^= clock * 0xC2B2AE3DU;
+    x ^= x >> 16;
+    x *= 0x7FEB352DU;
+    x ^= x >> 15;
+    return x % (emulator_config.jitter + 1);
+}
+
+static DVP_State_t dvp_state(uint64_t t)
+{
+    DVP_State_t state = {0, 0, 0, 0};
+    const DVP_Emulator_Config_t *c = &emulator_config;
+
+    uint64_t line_period = (uint64_t)c->line_clocks * c->dclk_period + c->hblank;
+    uint64_t active = line_period * c->lines;
+    uint64_t frame_period = c->vsync_low + c->vblank_front + active + c->vblank_back;
+
+    uint64_t frame = t / frame_period;
+    uint64_t u = t % frame_period;
+
+    if (u < c->vsync_low) return state;     // между кадрами VSYNC низкий
+    u -= c->vsync_low;
+    state.vsync = 1;
+
+    if (u < c->vblank_front) return state;
+    u -= c->vblank_front;
+    if (u >= active) return state;
+
+    uint32_t line = (uint32_t)(u / line_period);
+    uint64_t v = u % line_period;
+    if (v >= (uint64_t)c->line_clocks * c->dclk_period) return state;  // строчный гасящий интервал
+
+    // COM10: DCLK идет только при высоком HREF
+    uint32_t clock = (uint32_t)(v / c->dclk_period);
+    uint32_t phase = (uint32_t)(v % c->dclk_period);
+    uint32_t rise = c->dclk_period / 2 + jitter_offset(frame, line, clock);
+
+    state.href = 1;
+    state.dclk = (phase >= rise);
+    state.data_index = (frame * c->lines + line) * c->line_clocks + clock;
+    return state;
+}
+
+/** Каждое обращение к линии стоит cycles_per_read тактов */
+static DVP_State_t dvp_read(void)
+{
+    virtual_cycles += emulator_config.cycles_per_read;
+    return dvp_state(virtual_cycles);
+}
+
+/** Байт потока: из файла или синтезированный градиент (яркость на четных тактах, цветность 0x80 на нечетных) */
+static uint8_t stream_byte(uint64_t index)
+{
+    if (stream_data != NULL) return stream_data[index % stream_size];
+
+    uint64_t clock = index % emulator_config.line_clocks;
+    uint64_t line = index / emulator_config.line_clocks;
+    if (clock & 1) return 0x80;
+    return (uint8_t)((clock / 2) + line);
+}
+/**********************************************************************************************************************/
+
+
+/*************************************************************************************************** Функции эмулятора */
+
+void DVP_Emulator_Default_Config(DVP_Emulator_Config_t *config)
+{
+    config->cpu_frequency   = 168000000;
+    config->line_clocks     = 1600;                 // 800 пикселей YUV422
+    config->lines           = 600;
+    config->dclk_period     = 224;                  // PCLK 750 кГц (R_DVP_SP = 0x0F)
+    config->hblank          = 224 * 322;            // ~1922 такта PCLK на строку вместе с гашением
+    config->vblank_front    = 224 * 1922 * 4;       // 4 пустые строки в начале кадра
+    config->vblank_back     = 224 * 1922 * 2;       // 2 пустые строки в конце кадра
+    config->vsync_low       = 224 * 1922 * 4;
+    config->jitter          = 0;
+    config->seed            = 1;
+    config->cycles_per_read = 5;                    // LDR из GPIO + сравнение + переход
+}
+
+int DVP_Emulator_Start(const DVP_Emulator_Config_t *config, const char *filename)
+{
+    DVP_Emulator_Stop();
+
+    emulator_config = *config;
+    if (emulator_config.dclk_period < 2) emulator_config.dclk_period = 2;
+    if (emulator_config.jitter >= emulator_config.dclk_period / 2) emulator_config.jitter = emulator_config.dclk_period / 2 - 1;
+    if (emulator_config.cycles_per_read == 0) emulator_config.cycles_per_read = 1;
+    virtual_cycles = 0;
+
+    if (filename == NULL) return 0;
+
+    FILE *f = fopen(filename, "rb");
+    if (f == NULL) return -1;
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    if (size > 0) stream_data = (uint8_t*)malloc((size_t)size);
+    if (stream_data == NULL || fread(stream_data, 1, (size_t)size, f) != (size_t)size)
+    {
+        fclose(f);
+        DVP_Emulator_Stop();
+        return -1;
+    }
+    fclose(f);
+
+    stream_size = (uint32_t)size;
+    return 0;
+}
+
+void DVP_Emulator_Stop(void)
+{
+    free(stream_data);
+    stream_data = NULL;
+    stream_size = 0;
+}
+
+int DVP_Emulator_Synthesize_File(const DVP_Emulator_Config_t *config, const char *filename, uint32_t frames)
+{
+    FILE *f = fopen(filename, "wb");
+    if (f == NULL) return -1;
+
+    for (uint32_t frame = 0; frame < frames; frame++)
+    {
+        for (uint32_t line = 0; line < config->lines; line++)
+        {
+            for (uint32_t clock = 0; clock < config->line_clocks; clock++)
+            {
+                uint8_t value = (clock & 1) ? 0x80 : (uint8_t)(clock / 2 + line + frame);
+                fputc(value, f);
+            }
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+uint32_t DVP_Emulator_VSYNC(void)  { return dvp_read().vsync; }
+uint32_t DVP_Emulator_HREF(void)   { return dvp_read().href; }
+uint32_t DVP_Emulator_DCLK(void)   { return dvp_read().dclk; }
+uint8_t  DVP_Emulator_Data(void)   { return stream_byte(dvp_read().data_index); }
+
+uint64_t DVP_Emulator_Get_Cycles(void)
+{
+    return virtual_cycles;
+}
+
+void DVP_Emulator_Set_JPEG(const uint8_t *data, uint32_t size)
+{
+    jpeg_data = data;
+    jpeg_size = size;
+}
+/**********************************************************************************************************************/
+
+
+/********************************************************************************************** Замены периферии МК */
+
+I2C_Status_t I2C_Write_Reg(void *I2Cx, uint8_t I2C_device_addr, uint8_t reg_addr, uint8_t value)
+{
+    if (reg_addr == 0xff) i2c_bank = value & 0x01;
+    else i2c_registers[i2c_bank][reg_addr] = value;
+    return I2C_OK;
+}
+
+I2C_Status_t I2C_Read_Reg(void *I2Cx, uint8_t I2C_device_addr, uint8_t reg_addr, uint8_t *reg_data)
+{
+    // ID камеры, чтобы ov2640_Read_ID не уходил в аварийный цикл
+    if (i2c_bank == 1 && reg_addr == 0x0A) *reg_data = 0x26;
+    else if (i2c_bank == 1 && reg_addr == 0x0B) *reg_data = 0x42;
+    else *reg_data = i2c_registers[i2c_bank][reg_addr];
+    return I2C_OK;
+}
+
+void I2C_Enable(void *I2Cx) {}
+void GPIO_Enable_I2C(void *GPIO_port, uint8_t GPIO_pin) {}
+void GPIO_set_HIGH(void *GPIO_port, uint8_t GPIO_pin) {}
+void GPIO_set_LOW(void *GPIO_port, uint8_t GPIO_pin) {}
+void GPIO_toggle_Pin(void *GPIO_port, uint8_t GPIO_pin) {}
+
+void delay_ms(uint32_t ms)
+{
+    virtual_cycles += (uint64_t)ms * (emulator_config.cpu_frequency / 1000);
+}
+
+void SysTick_Update_us(void) {}
+
+uint32_t get_current_us(void)
+{
+    return (uint32_t)(virtual_cycles / (emulator_config.cpu_frequency / 1000000));
+}
+
+uint32_t get_current_ms(void)
+{
+    return (uint32_t)(virtual_cycles / (emulator_config.cpu_frequency / 1000));
+}
+
+uint32_t is_time_passed_ms(uint32_t start_time_ms, uint32_t delay_time_ms)
+{
+    virtual_cycles += emulator_config.cycles_per_read;
+    return (get_current_ms() - start_time_ms) >= delay_time_ms;
+}
+
+// Счетчик тактов DWT - виртуальное время эмулятора
+void DWT_Init(void) {}
+
+uint32_t DWT_Get_Cycles(void)
+{
+    return (uint32_t)virtual_cycles;
+}
+
+// DCMI: кадр JPEG из DVP_Emulator_Set_JPEG копируется в буфер целиком, без него захват завершается ошибкой
+void DCMI_StartCapture_JPEG(uint32_t *buffer, uint32_t max_words)
+{
+    jpeg_words = 0;
+    if (jpeg_data == NULL) return;
+
+    // DMA пишет словами: хвост последнего слова заполнен нулями
+    uint32_t bytes = (jpeg_size < max_words * 4) ? jpeg_size : max_words * 4;
+    jpeg_words = (bytes + 3) / 4;
+    if (jpeg_words) buffer[jpeg_words - 1] = 0;
+    memcpy(buffer, jpeg_data, bytes);
+}
+
+uint8_t DCMI_IsJPEGFrameReady(void) { return (jpeg_data != NULL) ? 1 : 4; }
+uint32_t DCMI_GetReceivedWords(uint32_t max_words) { return (jpeg_words < max_words) ? jpeg_words : max_words; }
+
+#endif /* OV2640_DVP_EMULATOR */
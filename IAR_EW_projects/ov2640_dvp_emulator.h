@@ -0,0 +1,93 @@
+/***********************************************************************************************************************
+*   Эмулятор камеры OV2640 для сборки на ПК
+*       Воспроизводит сигналы VSYNC, HREF, DCLK и шину данных D0..D7 по записанному или синтезированному потоку байт.
+*       Время виртуальное: каждое обращение к сигналу стоит заданное число тактов процессора, поэтому результат
+*   захвата и время работы функций ov2640_capture_* детерминированы и повторяются от запуска к запуску.
+*
+*       Подключается в ov2640.h при сборке с OV2640_DVP_EMULATOR, на МК не используется. Проверки ov2640.c
+*   на эмуляторе - tests/ov2640_test.c (make -C tests check).
+***********************************************************************************************************************/
+
+#ifndef __OV2640_DVP_EMULATOR_H__
+#define __OV2640_DVP_EMULATOR_H__
+
+#include <stdint.h>
+
+/** Временная диаграмма кадра (все длительности в тактах процессора) */
+typedef struct
+{
+    uint32_t cpu_frequency;     // частота процессора, Гц (для перевода тактов в мкс)
+    uint32_t line_clocks;       // количество тактов DCLK в строке (байт в строке, для YUV422 - 2 байта на пиксель)
+    uint32_t lines;             // количество строк в кадре
+    uint32_t dclk_period;       // период DCLK
+    uint32_t hblank;            // строчный гасящий интервал (HREF низкий между строками)
+    uint32_t vblank_front;      // от начала кадра (фронт VSYNC) до первой строки
+    uint32_t vblank_back;       // от последней строки до конца кадра (спад VSYNC)
+    uint32_t vsync_low;         // длительность низкого уровня VSYNC между кадрами
+    uint32_t jitter;            // максимальный случайный сдвиг фронта DCLK
+    uint32_t seed;              // зерно генератора джиттера (одно зерно - одна и та же диаграмма)
+    uint32_t cycles_per_read;   // стоимость одного чтения сигнала или шины данных
+}
+DVP_Emulator_Config_t;
+
+/** Диаграмма по умолчанию: SVGA YUV422, PCLK 750 кГц при 168 МГц (как после ov2640_Init) */
+void DVP_Emulator_Default_Config(DVP_Emulator_Config_t *config);
+
+/** Запуск эмулятора
+*   filename - файл с потоком байт шины данных (байт на каждый такт DCLK, кадр за кадром),
+*   при нехватке данных поток повторяется с начала. NULL - синтезированный градиент.
+*   return: 0 - успешно, -1 - файл не удалось прочитать */
+int DVP_Emulator_Start(const DVP_Emulator_Config_t *config, const char *filename);
+
+/** Освободить данные эмулятора */
+void DVP_Emulator_Stop(void);
+
+/** Записать в файл синтезированный поток: frames кадров с яркостью-градиентом и цветностью 0x80 */
+int DVP_Emulator_Synthesize_File(const DVP_Emulator_Config_t *config, const char *filename, uint32_t frames);
+
+/** Сигналы для макросов VSYNC_IS_HIGH, HREF_IS_HIGH, DCLK_IS_HIGH, DVP_READ_DATA */
+uint32_t DVP_Emulator_VSYNC(void);
+uint32_t DVP_Emulator_HREF(void);
+uint32_t DVP_Emulator_DCLK(void);
+uint8_t  DVP_Emulator_Data(void);
+
+/** Виртуальное время в тактах процессора (для замеров скорости функций захвата) */
+uint64_t DVP_Emulator_Get_Cycles(void);
+
+/** Кадр JPEG, который "принимает" замена DCMI: ov2640_capture_jpeg получает size байт (не больше буфера,
+*   хвост последнего слова - нули). NULL - захват завершается ошибкой DCMI */
+void DVP_Emulator_Set_JPEG(const uint8_t *data, uint32_t size);
+
+
+/***************************************************************** Замены периферии МК, которые использует ov2640.c */
+typedef enum
+{
+    I2C_OK = 0
+}
+I2C_Status_t;
+
+#define I2C2    ((void*)0)
+#define GPIOB   ((void*)0)
+#define GPIOD   ((void*)0)
+
+I2C_Status_t I2C_Write_Reg(void *I2Cx, uint8_t I2C_device_addr, uint8_t reg_addr, uint8_t value);
+I2C_Status_t I2C_Read_Reg(void *I2Cx, uint8_t I2C_device_addr, uint8_t reg_addr, uint8_t *reg_data);
+void I2C_Enable(void *I2Cx);
+void GPIO_Enable_I2C(void *GPIO_port, uint8_t GPIO_pin);
+void GPIO_set_HIGH(void *GPIO_port, uint8_t GPIO_pin);
+void GPIO_set_LOW(void *GPIO_port, uint8_t GPIO_pin);
+void GPIO_toggle_Pin(void *GPIO_port, uint8_t GPIO_pin);
+
+void delay_ms(uint32_t ms);
+void SysTick_Update_us(void);
+uint32_t get_current_us(void);
+uint32_t get_current_ms(void);
+uint32_t is_time_passed_ms(uint32_t start_time_ms, uint32_t delay_time_ms);
+void DWT_Init(void);
+uint32_t DWT_Get_Cycles(void);
+
+void DCMI_StartCapture_JPEG(uint32_t *buffer, uint32_t max_words);
+uint8_t DCMI_IsJPEGFrameReady(void);
+uint32_t DCMI_GetReceivedWords(uint32_t max_words);
+
+#endif /* __OV2640_DVP_EMULATOR_H__ */
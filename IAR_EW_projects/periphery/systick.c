@@ -14,6 +14,11 @@
 #define ticks_per_us		(SysTick_FREQUENCY / 1000000)       //    1  (168)
 #define LOAD_max_val		(ticks_per_ms * ms_per_interrupt)	//  LOAD (8.400.000)
 
+//  DWT ( core_cm4.h   CMSIS  DWT )
+#define DWT_CTRL            (*(volatile uint32_t*)0xE0001000)  //   DWT
+#define DWT_CYCCNT          (*(volatile uint32_t*)0xE0001004)  //   
+#define DWT_CTRL_CYCCNTENA  (0x1 << 0)                          //   
+
 /** Variables *********************************************************************************************************/
 volatile uint32_t systick_counter = 0;  //   SysTick_Handler()
 static uint32_t ms_counter = 0;         //  
@@ -191,6 +196,20 @@ void delay_ticks(uint32_t ticks)
     }
 }
 
+/**     */
+void DWT_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; //    (  DWT  )
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;                 //   
+}
+
+/**      */
+uint32_t DWT_Get_Cycles(void)
+{
+    return DWT_CYCCNT;
+}
+
 /**     */
 void SysTick_Handler(void)
 {
@@ -83,6 +83,38 @@ void SysTick_Update_ms(void);
 /** Обновление счетчика микросекунд */
 void SysTick_Update_us(void);
 
+	/**
+	! Функция DWT_Init включает счетчик тактов процессора DWT->CYCCNT (для замеров длительности участков кода).
+	*/
+void DWT_Init(void);
+
+	/**
+	! Функция DWT_Get_Cycles используется для получения текущего значения счетчика тактов процессора.
+	return: количество тактов от вызова DWT_Init (переполнение через ~25,5 с при 168 МГц).
+	*/
+uint32_t DWT_Get_Cycles(void);
+
+/**      (,  ):   -  DWT ( DWT_Init),  
+*     (HOST_BUILD, tests/Makefile) -   ,   DWT_Get_Cycles   */
+#ifdef HOST_BUILD
+#include <time.h>
+#define BENCHMARK_TIME_FREQUENCY    1000000000U     //     
+
+static inline uint32_t Benchmark_Time(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec);
+}
+#else
+#define BENCHMARK_TIME_FREQUENCY    168000000U      //  DWT  168 
+
+static inline uint32_t Benchmark_Time(void)
+{
+    return DWT_Get_Cycles();
+}
+#endif
+
 
 
 
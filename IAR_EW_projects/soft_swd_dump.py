@@ -0,0 +1,134 @@
+import sys
+import struct
+import zlib
+import argparse
+
+# Прием выгрузки памяти таргета, которую МК отправляет функцией SoftSWD_Dump (Soft_SWD/soft_SWD_dump.h), и сборка
+# образа в файл. Кадр: заголовок <magic, seq, flags, address, length, crc> (little-endian) и length байт данных,
+# crc - zlib.crc32 от 16 байт заголовка до crc и данных. Кадр с битой CRC или с length больше SOFT_SWD_DUMP_CHUNK
+# пропускается с поиском следующего magic, пропущенные куски в образе остаются 0xFF и перечисляются в конце.
+#     python soft_swd_dump.py flash.bin --port COM5            прием с порта
+#     python soft_swd_dump.py flash.bin --file capture.bin     разбор сохраненного потока (модель soft_SWD_sim)
+
+PORT = 'COM5'
+BAUDRATE = 2250000          # SOFT_SWD_DUMP_BAUDRATE
+
+MAGIC = 0x44445753          # SOFT_SWD_DUMP_MAGIC, "SWDD"
+CHUNK = 1024                # SOFT_SWD_DUMP_CHUNK, максимум данных в кадре
+HEADER = struct.Struct('<IHHIII')
+FLAG_LAST = 0x0001
+FLAG_ERROR = 0x0002
+
+SWD_STATUS = {1: 'WAIT', 2: 'FAULT', 3: 'ошибка четности', 4: 'ошибка протокола', 5: 'таймаут'}
+
+def read_frames(read):
+    """Кадры из потока: read(n) возвращает до n байт, b'' - конец потока или таймаут"""
+    buffer = b''
+    magic = struct.pack('<I', MAGIC)
+
+    while True:
+        # Синхронизация по magic
+        position = buffer.find(magic)
+        if position < 0:
+            buffer = buffer[-3:]
+        else:
+            buffer = buffer[position:]
+
+        if len(buffer) < HEADER.size:
+            chunk = read(HEADER.size - len(buffer) if position >= 0 else 4096)
+            if not chunk:
+                return
+            buffer += chunk
+            continue
+
+        _, seq, flags, address, length, crc = HEADER.unpack_from(buffer)
+        if length > CHUNK:
+            # magic в данных или битый заголовок: не ждать мегабайты несуществующего кадра
+            print(f"кадр с длиной {length} > {CHUNK} (seq {seq}), поиск следующего")
+            buffer = buffer[1:]
+            continue
+
+        while len(buffer) < HEADER.size + length:
+            chunk = read(HEADER.size + length - len(buffer))
+            if not chunk:
+                return
+            buffer += chunk
+
+        data = buffer[HEADER.size:HEADER.size + length]
+        if zlib.crc32(buffer[:HEADER.size - 4] + data) != crc:
+            print(f"кадр с битой CRC (seq {seq}), поиск следующего")
+            buffer = buffer[1:]
+            continue
+
+        buffer = buffer[HEADER.size + length:]
+        yield seq, flags, address, data
+
+def receive_dump(read):
+    """Сборка образа: возвращает (начальный адрес, образ, список пропусков, код ошибки SWD или 0)"""
+    chunks = {}
+    expected_seq = 0
+    gaps = []
+    error = 0
+
+    for seq, flags, address, data in read_frames(read):
+        if seq != expected_seq:
+            gaps.append(f"кадры {expected_seq}...{seq - 1}")
+        expected_seq = (seq + 1) & 0xFFFF
+        if data:
+            chunks[address] = data
+            print(f"\rкадр {seq:5d}  0x{address:08X}  {sum(len(c) for c in chunks.values())} Б", end='')
+
+        if flags & FLAG_ERROR:
+            error = flags >> 8
+            print(f"\nошибка SWD по адресу 0x{address:08X}: {SWD_STATUS.get(error, error)}")
+        if flags & FLAG_LAST:
+            break
+    else:
+        gaps.append("нет последнего кадра (таймаут)")
+    print()
+
+    if not chunks:
+        return 0, bytearray(), gaps, error
+
+    start = min(chunks)
+    end = max(address + len(data) for address, data in chunks.items())
+    image = bytearray(b'\xFF' * (end - start))
+    for address, data in chunks.items():
+        image[address - start:address - start + len(data)] = data
+
+    # Дыры между кусками (кадры с битой CRC)
+    position = start
+    for address in sorted(chunks):
+        if address > position:
+            gaps.append(f"0x{position:08X}...0x{address - 1:08X}")
+        position = max(position, address + len(chunks[address]))
+
+    return start, image, gaps, error
+
+def main():
+    parser = argparse.ArgumentParser(description='Прием выгрузки памяти таргета SoftSWD_Dump')
+    parser.add_argument('output', nargs='?', default='dump.bin', help='файл образа')
+    parser.add_argument('--port', default=PORT, help='COM-порт')
+    parser.add_argument('--baudrate', type=int, default=BAUDRATE)
+    parser.add_argument('--file', help='разобрать сохраненный поток вместо приема с порта')
+    args = parser.parse_args()
+
+    if args.file:
+        with open(args.file, 'rb') as stream:
+            start, image, gaps, error = receive_dump(stream.read)
+    else:
+        import serial
+        with serial.Serial(args.port, args.baudrate, timeout=2) as uart:
+            print(f"Прием с {args.port}, запустите SoftSWD_Dump на МК")
+            start, image, gaps, error = receive_dump(uart.read)
+
+    with open(args.output, 'wb') as file:
+        file.write(image)
+    print(f"{args.output}: 0x{start:08X}, {len(image)} Б, CRC-32 0x{zlib.crc32(image):08X}")
+
+    for gap in gaps:
+        print(f"пропуск: {gap}")
+    return 1 if (gaps or error) else 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,134 @@
+/***********************************************************************************************************************
+*   Потоковый анализатор спектра (см. spectrum_analyzer.h)
+***********************************************************************************************************************/
+
+#include "spectrum_analyzer.h"
+#include "systick.h"
+
+/** Настройка анализатора */
+Spectrum_Status_t Spectrum_Init(Spectrum_Analyzer_t *analyzer, uint32_t size, Spectrum_Window_t window,
+                                uint32_t overlap, uint32_t averages)
+{
+    if (size < 32 || size > SPECTRUM_MAX_SIZE || FFT_Log2(size) == 0) return SPECTRUM_ERROR_SIZE;
+    if (overlap >= size) return SPECTRUM_ERROR_OVERLAP;
+    if (averages == 0) averages = 1;
+
+    analyzer->size = size;
+    analyzer->hop = size - overlap;
+    analyzer->averages = averages;
+
+    // Периодическое окно (знаменатель size, а не size - 1) - без искажения при перекрытии кадров
+    float window_energy = 0.0f;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        float phase = 2.0f * (float)M_PI * (float)i / (float)size;
+        float w;
+
+        if (window == SPECTRUM_WINDOW_HANN)             w = 0.5f - 0.5f * cosf(phase);
+        else if (window == SPECTRUM_WINDOW_BLACKMAN)    w = 0.42f - 0.5f * cosf(phase) + 0.08f * cosf(2.0f * phase);
+        else                                            w = 1.0f;
+
+        analyzer->window[i] = w;
+        window_energy += w * w;
+    }
+    analyzer->power_scale = 1.0f / ((float)size * window_energy * (float)averages);
+
+    analyzer->frames = 0;
+    analyzer->spectra = 0;
+    analyzer->frame_cycles = 0;
+    analyzer->max_frames_per_second = 0;
+    for (uint32_t k = 0; k < SPECTRUM_MAX_BINS; k++) analyzer->power[k] = 0.0f;
+
+    Spectrum_Reset(analyzer);
+    return SPECTRUM_OK;
+}
+
+/** Сбросить накопленные отсчеты и серию усреднения */
+void Spectrum_Reset(Spectrum_Analyzer_t *analyzer)
+{
+    analyzer->write_index = 0;
+    analyzer->until_frame = analyzer->size;     // первый кадр - когда кольцо заполнится целиком
+    analyzer->averaged_frames = 0;
+    for (uint32_t k = 0; k < SPECTRUM_MAX_BINS; k++) analyzer->accumulator[k] = 0.0f;
+}
+
+/** Обработка кадра из последних size отсчетов кольца, return: 1 - готов усредненный спектр */
+static uint32_t spectrum_process_frame(Spectrum_Analyzer_t *analyzer)
+{
+    const uint32_t size = analyzer->size;
+    const uint32_t bins = size / 2 + 1;
+    uint32_t start = Benchmark_Time();
+
+    // Самый старый отсчет лежит по write_index: кадр из двух непрерывных кусков кольца
+    uint32_t first = size - analyzer->write_index;
+    for (uint32_t i = 0; i < first; i++)
+    {
+        analyzer->frame[i] = analyzer->ring[analyzer->write_index + i] * analyzer->window[i];
+    }
+    for (uint32_t i = first; i < size; i++)
+    {
+        analyzer->frame[i] = analyzer->ring[i - first] * analyzer->window[i];
+    }
+
+    FFT_Forward_Real_F32(analyzer->frame, analyzer->bins, size);
+
+    for (uint32_t k = 0; k < bins; k++)
+    {
+        float re = crealf(analyzer->bins[k]);
+        float im = cimagf(analyzer->bins[k]);
+        analyzer->accumulator[k] += re * re + im * im;
+    }
+
+    analyzer->frames++;
+    uint32_t ready = 0;
+
+    if (++analyzer->averaged_frames >= analyzer->averages)
+    {
+        // Односторонний спектр: мощность отрицательных частот добавляется к положительным (кроме 0 и size/2)
+        for (uint32_t k = 0; k < bins; k++)
+        {
+            float scale = (k == 0 || k == bins - 1) ? analyzer->power_scale : 2.0f * analyzer->power_scale;
+            analyzer->power[k] = analyzer->accumulator[k] * scale;
+            analyzer->accumulator[k] = 0.0f;
+        }
+        analyzer->averaged_frames = 0;
+        analyzer->spectra++;
+        ready = 1;
+    }
+
+    analyzer->frame_cycles = Benchmark_Time() - start;
+    if (analyzer->frame_cycles) analyzer->max_frames_per_second = BENCHMARK_TIME_FREQUENCY / analyzer->frame_cycles;
+
+    return ready;
+}
+
+/** Подать count отсчетов */
+uint32_t Spectrum_Push(Spectrum_Analyzer_t *analyzer, const float *samples, uint32_t count)
+{
+    uint32_t ready = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        analyzer->ring[analyzer->write_index] = samples[i];
+        if (++analyzer->write_index == analyzer->size) analyzer->write_index = 0;
+
+        if (--analyzer->until_frame == 0)
+        {
+            ready += spectrum_process_frame(analyzer);
+            analyzer->until_frame = analyzer->hop;
+        }
+    }
+    return ready;
+}
+
+/** Номер бина с максимальной мощностью */
+uint32_t Spectrum_Peak_Bin(const Spectrum_Analyzer_t *analyzer)
+{
+    uint32_t peak = 1;
+
+    for (uint32_t k = 2; k <= analyzer->size / 2; k++)
+    {
+        if (analyzer->power[k] > analyzer->power[peak]) peak = k;
+    }
+    return peak;
+}
@@ -0,0 +1,86 @@
+/***********************************************************************************************************************
+*   Потоковый анализатор спектра
+*       Отсчеты (например, АЦП с выхода генератора AD9833) подаются порциями любой длины в кольцевой буфер.
+*   Каждые hop = size - overlap отсчетов последние size отсчетов умножаются на окно (Ханна или Блэкмана)
+*   и проходят через БПФ вещественного сигнала (FFT_Forward_Real_F32). Спектры мощности averages кадров
+*   подряд усредняются (метод Уэлча), готовый усредненный спектр лежит в power.
+*
+*       Вся память - внутри структуры анализатора (размер задается SPECTRUM_MAX_SIZE), динамической памяти нет.
+*   Время обработки кадра меряется счетчиком DWT (нужен DWT_Init), по нему считается максимальная частота
+*   кадров, которую анализатор выдерживает: она должна быть не меньше sample_rate / hop.
+*
+*   Пример (fs = 100 кГц, 512 точек, перекрытие 50%, усреднение 8 кадров):
+*       static Spectrum_Analyzer_t analyzer;
+*       Spectrum_Init(&analyzer, 512, SPECTRUM_WINDOW_HANN, 256, 8);
+*       ...
+*       if (Spectrum_Push(&analyzer, samples, count)) { ... analyzer.power[k], частота бина k = k * fs / 512 ... }
+***********************************************************************************************************************/
+
+#ifndef __SPECTRUM_ANALYZER_H__
+#define __SPECTRUM_ANALYZER_H__
+
+#include <stdint.h>
+#include "fft.h"
+
+#define SPECTRUM_MAX_SIZE       512     // максимальный размер кадра (определяет объем памяти анализатора)
+#define SPECTRUM_MAX_BINS       (SPECTRUM_MAX_SIZE / 2 + 1)
+
+typedef enum
+{
+    SPECTRUM_WINDOW_RECTANGULAR = 0,
+    SPECTRUM_WINDOW_HANN = 1,           // боковые лепестки -31 дБ, ширина главного лепестка 4 бина
+    SPECTRUM_WINDOW_BLACKMAN = 2        // боковые лепестки -58 дБ, ширина главного лепестка 6 бинов
+}
+Spectrum_Window_t;
+
+typedef enum
+{
+    SPECTRUM_OK = 0,
+    SPECTRUM_ERROR_SIZE = 1,            // размер не степень двойки или вне 32 ... SPECTRUM_MAX_SIZE
+    SPECTRUM_ERROR_OVERLAP = 2          // перекрытие не меньше размера кадра
+}
+Spectrum_Status_t;
+
+typedef struct
+{
+    float ring[SPECTRUM_MAX_SIZE];              // кольцевой буфер входных отсчетов
+    float window[SPECTRUM_MAX_SIZE];            // таблица окна
+    float frame[SPECTRUM_MAX_SIZE];             // кадр после окна (вход БПФ)
+    float complex bins[SPECTRUM_MAX_BINS];      // спектр текущего кадра
+    float accumulator[SPECTRUM_MAX_BINS];       // сумма спектров мощности текущей серии
+    float power[SPECTRUM_MAX_BINS];             // результат: усредненный односторонний спектр мощности
+                                                // (сумма по всем бинам = средний квадрат сигнала)
+
+    uint32_t size;                  // размер кадра
+    uint32_t hop;                   // шаг между кадрами (size - overlap)
+    uint32_t averages;              // кадров в одном усреднении
+    float    power_scale;           // нормировка: 1 / (size * sum(window^2) * averages)
+
+    uint32_t write_index;           // куда запишется следующий отсчет
+    uint32_t until_frame;           // отсчетов до следующего кадра
+    uint32_t averaged_frames;       // кадров в текущей серии
+
+    uint32_t frames;                // всего обработано кадров
+    uint32_t spectra;               // всего выдано усредненных спектров
+    uint32_t frame_cycles;          // время обработки последнего кадра (такты DWT, на ПК с HOST_BUILD - нс)
+    uint32_t max_frames_per_second; // сколько кадров в секунду анализатор успевает обработать
+}
+Spectrum_Analyzer_t;
+
+/** Настройка анализатора
+*   size - размер кадра (степень двойки 32 ... SPECTRUM_MAX_SIZE), overlap - перекрытие кадров в отсчетах
+*   (0 ... size - 1, обычно size/2 для Ханна и 2*size/3 для Блэкмана), averages - кадров в одном усреднении */
+Spectrum_Status_t Spectrum_Init(Spectrum_Analyzer_t *analyzer, uint32_t size, Spectrum_Window_t window,
+                                uint32_t overlap, uint32_t averages);
+
+/** Подать count отсчетов. Кадры обрабатываются сразу, как только набирается hop новых отсчетов
+*   return: количество готовых усредненных спектров за этот вызов (обычно 0 или 1) */
+uint32_t Spectrum_Push(Spectrum_Analyzer_t *analyzer, const float *samples, uint32_t count);
+
+/** Сбросить накопленные отсчеты и серию усреднения (настройки сохраняются) */
+void Spectrum_Reset(Spectrum_Analyzer_t *analyzer);
+
+/** Номер бина с максимальной мощностью (без постоянной составляющей) */
+uint32_t Spectrum_Peak_Bin(const Spectrum_Analyzer_t *analyzer);
+
+#endif /* __SPECTRUM_ANALYZER_H__ */
@@ -0,0 +1,128 @@
+/***********************************************************************************************************************
+*   Замеры скорости на ПК (HOST_BUILD), сборка и запуск - make -C tests bench
+*       БПФ: FFT_Benchmark для всех размеров FFT_MIN_SIZE ... FFT_MAX_SIZE - время одного прямого БПФ каждого типа
+*   (нс часов ПК) и отношение сигнал/шум относительно эталона F64.
+*       Пакетное БПФ: FFT_Benchmark_Batch - преобразований в секунду для K каналов в обеих раскладках против K
+*   вызовов одиночного БПФ, F32 и Q15.
+*       Временной фильтр: ImageProcessing_temporal_filter_benchmark на шумном синтетическом кадре - нс на пиксель
+*   фильтра и бинаризации и доля пикселей, сменивших цвет между соседними кадрами, без фильтра и с фильтром
+*   (8 и 16 бит на пиксель, разная инерция).
+*       Числа ПК только для сравнения вариантов между собой; такты на МК дает тот же замер по DWT (FFT_BENCHMARK
+*   в main.c). Проверок нет, код возврата не 0 - только если замер не выполнился.
+***********************************************************************************************************************/
+
+#include <stdio.h>
+#include "fft.h"
+#include "image_processing.h"
+
+/** Рабочий буфер FFT_Benchmark: 32*N байт для N = FFT_MAX_SIZE, выравнивание 8 */
+static uint64_t fft_work[32 * FFT_MAX_SIZE / sizeof(uint64_t)];
+
+static const char *const fft_type_names[FFT_TYPE_COUNT] = {"F64", "F32", "Q15", "Q31"};
+
+static int bench_fft(void)
+{
+    FFT_Benchmark_Result_t results[FFT_MAX_LOG2];
+    uint32_t count = FFT_Benchmark(fft_work, sizeof(fft_work), results, FFT_MAX_LOG2);
+
+    printf("FFT_Benchmark: нс на одно прямое БПФ / отношение сигнал/шум, дБ\n");
+    printf("%6s", "N");
+    for (uint32_t t = 0; t < FFT_TYPE_COUNT; t++) printf("  %9s %6s", fft_type_names[t], "SNR");
+    printf("\n");
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        printf("%6u", (unsigned)results[i].n);
+        for (uint32_t t = 0; t < FFT_TYPE_COUNT; t++)
+        {
+            printf("  %9u %6.1f", (unsigned)results[i].cycles[t], results[i].snr_db[t]);
+        }
+        printf("\n");
+    }
+    return (count == FFT_MAX_LOG2 - FFT_Log2(FFT_MIN_SIZE) + 1) ? 0 : 1;
+}
+
+/** Пакетное БПФ: размеры и число каналов, как у многоканального АЦП */
+static int bench_fft_batch(void)
+{
+    static const uint32_t sizes[] = {64, 256};
+    static const uint32_t channels[] = {2, 4, 8};
+    static const char *const type_names[2] = {"F32", "Q15"};
+    int errors = 0;
+
+    printf("\nFFT_Benchmark_Batch: преобразований в секунду, K вызовов одиночного / пакет раздельно / пакет чередуясь\n");
+    for (uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        for (uint32_t c = 0; c < sizeof(channels) / sizeof(channels[0]); c++)
+        {
+            FFT_Batch_Benchmark_t result;
+            if (FFT_Benchmark_Batch(fft_work, sizeof(fft_work), sizes[s], channels[c], &result) != FFT_OK)
+            {
+                errors++;
+                continue;
+            }
+
+            for (uint32_t t = 0; t < 2; t++)
+            {
+                printf("N %4u  K %u  %s  %9u  %9u (x%.2f)  %9u (x%.2f)\n", (unsigned)result.n,
+                       (unsigned)result.channels, type_names[t], (unsigned)result.single_per_second[t],
+                       (unsigned)result.planar_per_second[t],
+                       (double)result.planar_per_second[t] / result.single_per_second[t],
+                       (unsigned)result.interleaved_per_second[t],
+                       (double)result.interleaved_per_second[t] / result.single_per_second[t]);
+            }
+        }
+    }
+    return errors;
+}
+
+/** Кадр замера временного фильтра: четверть кадра камеры, шумный темный кадр */
+#define TEMPORAL_WIDTH      400
+#define TEMPORAL_HEIGHT     300
+#define TEMPORAL_FRAMES     64
+#define TEMPORAL_NOISE      48
+
+static uint8_t  temporal_frame[TEMPORAL_WIDTH * TEMPORAL_HEIGHT];
+static uint8_t  temporal_history[TEMPORAL_WIDTH * TEMPORAL_HEIGHT / 4];
+static uint16_t temporal_state[TEMPORAL_WIDTH * TEMPORAL_HEIGHT];
+
+static int bench_temporal_filter(void)
+{
+    static const uint8_t bits[] = {8, 16, 16};
+    static const uint8_t shifts[] = {2, 2, 4};
+    int errors = 0;
+
+    printf("\nImageProcessing_temporal_filter_benchmark: %ux%u, %u кадров, шум +-%u\n", TEMPORAL_WIDTH,
+           TEMPORAL_HEIGHT, TEMPORAL_FRAMES, TEMPORAL_NOISE);
+    printf("бит  shift  фильтр нс/пикс  бинаризация нс/пикс  смены цвета ppm: один кадр / с фильтром\n");
+    for (uint32_t i = 0; i < sizeof(bits) / sizeof(bits[0]); i++)
+    {
+        ImageProcessing_Temporal_Filter_t filter;
+        ImageProcessing_Temporal_Benchmark_t result;
+
+        ImageProcessing_temporal_filter_init(&filter, temporal_state, bits[i], shifts[i], TEMPORAL_WIDTH,
+                                             TEMPORAL_HEIGHT);
+        ImageProcessing_temporal_filter_benchmark(&filter, temporal_frame, temporal_history, TEMPORAL_FRAMES,
+                                                  TEMPORAL_NOISE, &result);
+
+        printf("%3u  %5u  %14.2f  %19.2f  %8u / %u\n", (unsigned)bits[i], (unsigned)shifts[i],
+               result.filter_cycles_x100 / 100.0, result.binarize_cycles_x100 / 100.0,
+               (unsigned)result.flips_single_ppm, (unsigned)result.flips_filtered_ppm);
+
+        // Фильтр, который не уменьшает мерцание после бинаризации, - ошибка замера, а не просто медленный код
+        if (result.flips_filtered_ppm >= result.flips_single_ppm) errors++;
+    }
+    return errors;
+}
+
+
+int main(void)
+{
+    int errors = 0;
+
+    errors += bench_fft();
+    errors += bench_fft_batch();
+    errors += bench_temporal_filter();
+
+    return errors;
+}
@@ -0,0 +1,311 @@
+/***********************************************************************************************************************
+*   Проверки fft.c на ПК (HOST_BUILD), сборка и запуск - tests/Makefile
+*       Каждый вариант БПФ сравнивается с прямым ДПФ по тем же (квантованным) входным отсчетам для всех размеров
+*   FFT_MIN_SIZE ... FFT_MAX_SIZE: F64 и F32 - прямое и обратное, Q15 и Q31 - прямое с учетом exponent.
+*   Q15/Q31 еще и на полной шкале, на четверти шкалы и на бабочке с наибольшим ростом (1 + sqrt(2)) у границ
+*   выбора сдвига блочной плавающей точки - переполнение на любом этапе обрушивает отношение сигнал/шум.
+*   Пакетные БПФ - по каждому каналу в обеих раскладках, Q15 - с громким каналом у границы сдвига.
+*   Точность - отношение сигнал/шум результата относительно ДПФ в дБ. Код возврата - число ошибок.
+***********************************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "fft.h"
+
+/** Нижние границы отношения сигнал/шум, дБ (с запасом от измеренного на всех размерах) */
+#define SNR_MIN_F64         250.0
+#define SNR_MIN_F32         120.0
+#define SNR_MIN_Q31         130.0
+#define SNR_MIN_Q15         45.0
+#define SNR_MIN_Q15_QUIET   30.0        // канал пакета в 4 раза тише громкого: общий exponent съедает 2 бита
+
+static uint32_t failures;
+
+static void check(int ok, const char *what)
+{
+    if (ok) return;
+    failures++;
+    printf("FAIL: %s\n", what);
+}
+
+static double complex source[FFT_MAX_SIZE];         // сигнал до квантования
+static double complex signal[FFT_MAX_SIZE];         // входные отсчеты (после квантования - у Q15/Q31 свои)
+static double complex reference[FFT_MAX_SIZE];      // прямое ДПФ
+static double complex dft_twiddle[FFT_MAX_SIZE];    // exp(-2*pi*i*m/n)
+
+static double complex data_f64[FFT_MAX_SIZE];
+static float complex  data_f32[FFT_MAX_SIZE];
+static FFT_Q15_t      data_q15[FFT_MAX_SIZE];
+static FFT_Q31_t      data_q31[FFT_MAX_SIZE];
+
+/** Шум и две гармоники (одна между бинами), компоненты не больше 0.85 * amplitude */
+static void make_signal(uint32_t n, double amplitude)
+{
+    uint32_t seed = 0xFF7 + n;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        double noise_re = (double)((seed >> 8) & 0xFFFF) / 65536.0 - 0.5;
+        seed = seed * 1103515245U + 12345U;
+        double noise_im = (double)((seed >> 8) & 0xFFFF) / 65536.0 - 0.5;
+
+        double re = 0.4 * cos(2.0 * M_PI * 3.0 * i / n) + 0.3 * sin(2.0 * M_PI * (n / 4 + 0.5) * i / n) + 0.3 * noise_re;
+        double im = 0.4 * sin(2.0 * M_PI * 3.0 * i / n) + 0.3 * noise_im;
+        source[i] = amplitude * re + amplitude * im * I;
+    }
+}
+
+/** Худший случай для блочной плавающей точки: на последнем этапе бабочка с W = exp(-i*pi/4) получает
+*   top = -i*c и bottom = c*(1 - i), |top + bottom*W| = (1 + sqrt(2))*c. До этапа компоненты не больше c (доля
+*   полной шкалы), во времени - тоны с амплитудой c/(n/2) в четных и нечетных отсчетах */
+static void make_worst_signal(uint32_t n, double c)
+{
+    const uint32_t half = n / 2;
+    const uint32_t bin = n / 8;     // W_n^bin = exp(-i*pi/4)
+    const double complex top = -c * I;
+    const double complex bottom = c - c * I;
+
+    for (uint32_t m = 0; m < half; m++)
+    {
+        double complex tone = cexp(2.0 * M_PI * I * (double)bin * m / (double)half) / (double)half;
+        source[2 * m] = top * tone;
+        source[2 * m + 1] = bottom * tone;
+    }
+}
+
+/** Прямое ДПФ signal -> reference за n^2 умножений */
+static void direct_dft(uint32_t n)
+{
+    for (uint32_t m = 0; m < n; m++) dft_twiddle[m] = cexp(-2.0 * M_PI * I * (double)m / (double)n);
+
+    for (uint32_t k = 0; k < n; k++)
+    {
+        double complex sum = 0;
+        for (uint32_t i = 0; i < n; i++) sum += signal[i] * dft_twiddle[((uint64_t)k * i) % n];
+        reference[k] = sum;
+    }
+}
+
+/** Отношение энергии expected к энергии ошибки, дБ */
+static double snr_db(const double complex *expected, const double complex *actual, uint32_t n)
+{
+    double signal_energy = 0.0;
+    double error_energy = 0.0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double complex e = actual[i] - expected[i];
+        signal_energy += creal(expected[i]) * creal(expected[i]) + cimag(expected[i]) * cimag(expected[i]);
+        error_energy += creal(e) * creal(e) + cimag(e) * cimag(e);
+    }
+    if (error_energy == 0.0) return 400.0;
+    return 10.0 * log10(signal_energy / error_energy);
+}
+
+static void check_snr(double snr, double min, const char *name, uint32_t n)
+{
+    char what[160];
+    snprintf(what, sizeof(what), "%s N=%u: SNR %.1f dB < %.1f dB", name, (unsigned)n, snr, min);
+    check(snr >= min, what);
+}
+
+static void test_float(uint32_t n)
+{
+    static double complex result[FFT_MAX_SIZE];
+
+    make_signal(n, 1.0);
+    memcpy(signal, source, n * sizeof(double complex));
+    direct_dft(n);
+
+    // F64: прямое против ДПФ, обратное от ДПФ возвращает сигнал
+    memcpy(data_f64, signal, n * sizeof(double complex));
+    check(FFT_Forward_F64(data_f64, n) == FFT_OK, "F64 forward status");
+    check_snr(snr_db(reference, data_f64, n), SNR_MIN_F64, "F64 forward", n);
+
+    memcpy(data_f64, reference, n * sizeof(double complex));
+    check(FFT_Inverse_F64(data_f64, n) == FFT_OK, "F64 inverse status");
+    check_snr(snr_db(signal, data_f64, n), SNR_MIN_F64, "F64 inverse", n);
+
+    // F32: вход квантуется в float, эталон - ДПФ по квантованным отсчетам
+    for (uint32_t i = 0; i < n; i++)
+    {
+        data_f32[i] = (float)creal(signal[i]) + (float)cimag(signal[i]) * I;
+        signal[i] = crealf(data_f32[i]) + cimagf(data_f32[i]) * I;
+    }
+    direct_dft(n);
+
+    check(FFT_Forward_F32(data_f32, n) == FFT_OK, "F32 forward status");
+    for (uint32_t i = 0; i < n; i++) result[i] = crealf(data_f32[i]) + cimagf(data_f32[i]) * I;
+    check_snr(snr_db(reference, result, n), SNR_MIN_F32, "F32 forward", n);
+
+    for (uint32_t i = 0; i < n; i++) data_f32[i] = (float)creal(reference[i]) + (float)cimag(reference[i]) * I;
+    check(FFT_Inverse_F32(data_f32, n) == FFT_OK, "F32 inverse status");
+    for (uint32_t i = 0; i < n; i++) result[i] = crealf(data_f32[i]) + cimagf(data_f32[i]) * I;
+    check_snr(snr_db(signal, result, n), SNR_MIN_F32, "F32 inverse", n);
+}
+
+/** Q15/Q31 по сигналу source (доли полной шкалы) */
+static void test_fixed(uint32_t n, const char *name)
+{
+    static double complex result[FFT_MAX_SIZE];
+    char what[64];
+    int32_t exponent;
+
+    // Q15: X[k] = data[k] * 2^exponent в единицах входа
+    for (uint32_t i = 0; i < n; i++)
+    {
+        data_q15[i].re = (int16_t)lrint(creal(source[i]) * 32767.0);
+        data_q15[i].im = (int16_t)lrint(cimag(source[i]) * 32767.0);
+        signal[i] = data_q15[i].re + data_q15[i].im * I;
+    }
+    direct_dft(n);
+
+    check(FFT_Forward_Q15(data_q15, n, &exponent) == FFT_OK, "Q15 forward status");
+    check(exponent >= 0 && exponent <= 2 * (int32_t)FFT_Log2(n), "Q15 exponent range");
+    for (uint32_t i = 0; i < n; i++) result[i] = ldexp(data_q15[i].re, exponent) + ldexp(data_q15[i].im, exponent) * I;
+    snprintf(what, sizeof(what), "Q15 forward %s", name);
+    check_snr(snr_db(reference, result, n), SNR_MIN_Q15, what, n);
+
+    // Q31
+    for (uint32_t i = 0; i < n; i++)
+    {
+        data_q31[i].re = (int32_t)llrint(creal(source[i]) * 2147483647.0);
+        data_q31[i].im = (int32_t)llrint(cimag(source[i]) * 2147483647.0);
+        signal[i] = (double)data_q31[i].re + (double)data_q31[i].im * I;
+    }
+    direct_dft(n);
+
+    check(FFT_Forward_Q31(data_q31, n, &exponent) == FFT_OK, "Q31 forward status");
+    check(exponent >= 0 && exponent <= 2 * (int32_t)FFT_Log2(n), "Q31 exponent range");
+    for (uint32_t i = 0; i < n; i++) result[i] = ldexp(data_q31[i].re, exponent) + ldexp(data_q31[i].im, exponent) * I;
+    snprintf(what, sizeof(what), "Q31 forward %s", name);
+    check_snr(snr_db(reference, result, n), SNR_MIN_Q31, what, n);
+}
+
+/** Пакетные БПФ: F32 в обеих раскладках совпадает с FFT_Forward_F32 по каждому каналу; Q15 - каналы с бабочкой
+*   наибольшего роста у границы сдвига (worst) или шум на полной шкале, громкий канал не переполняется, остальные
+*   (общий exponent) теряют не больше нескольких бит */
+#define BATCH_CHANNELS      3
+
+static void test_batch(uint32_t n, int worst)
+{
+    static float complex batch_f32[BATCH_CHANNELS * FFT_MAX_SIZE];
+    static FFT_Q15_t batch_q15[BATCH_CHANNELS * FFT_MAX_SIZE];
+    static double complex channel_source[BATCH_CHANNELS][FFT_MAX_SIZE];
+    static double complex result[FFT_MAX_SIZE];
+    const double worst_level[BATCH_CHANNELS] = {0.49, 0.45, 0.24};
+    const double noise_level[BATCH_CHANNELS] = {1.0 / 0.85, 0.9 / 0.85, 0.3};
+    const char *kind = worst ? "worst" : "full scale";
+    char what[80];
+
+    for (uint32_t c = 0; c < BATCH_CHANNELS; c++)
+    {
+        if (worst) make_worst_signal(n, worst_level[c]);
+        else make_signal(n, noise_level[c]);
+        memcpy(channel_source[c], source, n * sizeof(double complex));
+    }
+
+    for (uint32_t layout = FFT_LAYOUT_PLANAR; layout <= FFT_LAYOUT_INTERLEAVED; layout++)
+    {
+        const uint32_t sample_stride = (layout == FFT_LAYOUT_INTERLEAVED) ? BATCH_CHANNELS : 1;
+        const uint32_t channel_stride = (layout == FFT_LAYOUT_INTERLEAVED) ? 1 : n;
+        const char *name = (layout == FFT_LAYOUT_INTERLEAVED) ? "interleaved" : "planar";
+        int32_t exponent;
+
+        // F32: тот же результат, что у одиночного БПФ (тот же порядок операций)
+        for (uint32_t c = 0; c < BATCH_CHANNELS; c++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                batch_f32[i * sample_stride + c * channel_stride] =
+                    (float)creal(channel_source[c][i]) + (float)cimag(channel_source[c][i]) * I;
+            }
+        }
+        check(FFT_Forward_Batch_F32(batch_f32, n, BATCH_CHANNELS, (FFT_Layout_t)layout) == FFT_OK, "batch F32 status");
+        for (uint32_t c = 0; c < BATCH_CHANNELS; c++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                data_f32[i] = (float)creal(channel_source[c][i]) + (float)cimag(channel_source[c][i]) * I;
+            }
+            FFT_Forward_F32(data_f32, n);
+
+            int same = 1;
+            for (uint32_t i = 0; i < n; i++) same &= (batch_f32[i * sample_stride + c * channel_stride] == data_f32[i]);
+            snprintf(what, sizeof(what), "batch F32 %s %s N=%u channel %u", kind, name, (unsigned)n, (unsigned)c);
+            check(same, what);
+        }
+
+        // Q15: общий exponent по самому громкому каналу
+        for (uint32_t c = 0; c < BATCH_CHANNELS; c++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                FFT_Q15_t *sample = &batch_q15[i * sample_stride + c * channel_stride];
+                sample->re = (int16_t)lrint(creal(channel_source[c][i]) * 32767.0);
+                sample->im = (int16_t)lrint(cimag(channel_source[c][i]) * 32767.0);
+            }
+        }
+        check(FFT_Forward_Batch_Q15(batch_q15, n, BATCH_CHANNELS, (FFT_Layout_t)layout, &exponent) == FFT_OK,
+              "batch Q15 status");
+        for (uint32_t c = 0; c < BATCH_CHANNELS; c++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                signal[i] = lrint(creal(channel_source[c][i]) * 32767.0) + lrint(cimag(channel_source[c][i]) * 32767.0) * I;
+                const FFT_Q15_t *sample = &batch_q15[i * sample_stride + c * channel_stride];
+                result[i] = ldexp(sample->re, exponent) + ldexp(sample->im, exponent) * I;
+            }
+            direct_dft(n);
+            snprintf(what, sizeof(what), "batch Q15 %s %s channel %u", kind, name, (unsigned)c);
+            double level = worst ? worst_level[c] / worst_level[0] : noise_level[c] / noise_level[0];
+            check_snr(snr_db(reference, result, n), (level > 0.5) ? SNR_MIN_Q15 : SNR_MIN_Q15_QUIET, what, n);
+        }
+    }
+}
+
+/** Недопустимые размеры отклоняются всеми вариантами */
+static void test_sizes(void)
+{
+    static const uint32_t bad[] = {0, 1, 8, FFT_MIN_SIZE + 1, 48, FFT_MAX_SIZE * 2};
+    int32_t exponent;
+
+    for (uint32_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++)
+    {
+        check(FFT_Log2(bad[i]) == 0, "FFT_Log2 of bad size");
+        check(FFT_Forward_F64(data_f64, bad[i]) == FFT_ERROR_SIZE, "F64 bad size");
+        check(FFT_Inverse_F64(data_f64, bad[i]) == FFT_ERROR_SIZE, "F64 inverse bad size");
+        check(FFT_Forward_F32(data_f32, bad[i]) == FFT_ERROR_SIZE, "F32 bad size");
+        check(FFT_Inverse_F32(data_f32, bad[i]) == FFT_ERROR_SIZE, "F32 inverse bad size");
+        check(FFT_Forward_Q15(data_q15, bad[i], &exponent) == FFT_ERROR_SIZE, "Q15 bad size");
+        check(FFT_Forward_Q31(data_q31, bad[i], &exponent) == FFT_ERROR_SIZE, "Q31 bad size");
+    }
+}
+
+
+int main(void)
+{
+    test_sizes();
+
+    for (uint32_t n = FFT_MIN_SIZE; n <= FFT_MAX_SIZE; n <<= 1)
+    {
+        test_float(n);
+
+        // Q15/Q31: обычный уровень, четверть и полная шкала, бабочка с наибольшим ростом у границ сдвига
+        make_signal(n, 0.1);
+        test_fixed(n, "1/10 scale");
+        make_signal(n, 0.3);
+        test_fixed(n, "quarter scale");
+        make_signal(n, 1.0 / 0.85);
+        test_fixed(n, "full scale");
+        make_worst_signal(n, 0.24);
+        test_fixed(n, "worst butterfly below 1/4");
+        make_worst_signal(n, 0.49);
+        test_fixed(n, "worst butterfly below 1/2");
+
+        test_batch(n, 1);
+        test_batch(n, 0);
+    }
+
+    printf("%s: %u failures\n", failures ? "FAILED" : "OK", (unsigned)failures);
+    return (int)failures;
+}
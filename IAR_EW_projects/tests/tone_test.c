@@ -0,0 +1,168 @@
+/***********************************************************************************************************************
+*   Проверки tone_detector.c на ПК, сборка и запуск - tests/Makefile
+*       Синтезированные тоны для обоих методов (Герцель и скользящее ДПФ): тон в центре бина (амплитуда, фаза,
+*   соседние бины пустые), тон между бинами (дробный бин Герцеля и провал амплитуды целого бина), слабый тон
+*   в шуме ниже порога обнаружения и сильный - выше. Код возврата - число ошибок.
+***********************************************************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "tone_detector.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define SAMPLE_RATE         100000.0f
+#define WINDOW              1000                // бин 100 Гц
+#define THRESHOLD           0.05f               // порог обнаружения тона по амплитуде
+
+static uint32_t failures;
+
+static void check(int ok, const char *what)
+{
+    if (ok) return;
+    failures++;
+    printf("FAIL: %s\n", what);
+}
+
+static Tone_Detector_t detector;
+static float samples[3 * WINDOW];
+
+static const char *method_name[] = {"Goertzel", "sliding DFT"};
+
+/** count отсчетов: amplitude * cos(2*pi*frequency*n/fs + phase) и равномерный шум +/- noise */
+static void make_tone(float frequency, float amplitude, float phase, float noise, uint32_t count)
+{
+    uint32_t seed = 0x70E;
+    for (uint32_t n = 0; n < count; n++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        double random = (double)((seed >> 8) & 0xFFFF) / 32768.0 - 1.0;
+        samples[n] = (float)(amplitude * cos(2.0 * M_PI * frequency * n / SAMPLE_RATE + phase) + noise * random);
+    }
+}
+
+/** Разность фаз в -pi ... pi */
+static float phase_error(float actual, float expected)
+{
+    double d = fmod((double)actual - (double)expected, 2.0 * M_PI);
+    if (d > M_PI) d -= 2.0 * M_PI;
+    if (d < -M_PI) d += 2.0 * M_PI;
+    return (float)fabs(d);
+}
+
+/** Подать 3 окна: у Герцеля результат - последний блок, у скользящего ДПФ - окно с самым старым отсчетом
+*   2*WINDOW, то есть фаза та же, что у первого отсчета (целый бин) */
+static void run(Tone_Method_t method, const float *bins, uint32_t count)
+{
+    Tone_Init(&detector, method, WINDOW);
+    for (uint32_t i = 0; i < count; i++) Tone_Add_Bin(&detector, bins[i]);
+
+    uint32_t ready = Tone_Push(&detector, samples, 3 * WINDOW);
+    check(ready == ((method == TONE_METHOD_GOERTZEL) ? 3 : 2 * WINDOW + 1), "results ready count");
+}
+
+static float amplitude_of(uint32_t index)
+{
+    float amplitude = -1.0f;
+    check(Tone_Get_Result(&detector, index, &amplitude, NULL) == TONE_OK, "result status");
+    return amplitude;
+}
+
+static void test_on_bin(Tone_Method_t method)
+{
+    const float bins[] = {125.0f, 124.0f, 130.0f, 0.0f};
+    char what[96];
+    float amplitude, phase;
+
+    make_tone(12500.0f, 0.8f, 0.7f, 0.0f, 3 * WINDOW);
+    run(method, bins, 4);
+
+    check(Tone_Get_Result(&detector, 0, &amplitude, &phase) == TONE_OK, "on-bin result status");
+    snprintf(what, sizeof(what), "%s on-bin amplitude %.4f", method_name[method], amplitude);
+    check(fabsf(amplitude - 0.8f) < 0.002f, what);
+    snprintf(what, sizeof(what), "%s on-bin phase %.4f", method_name[method], phase);
+    check(phase_error(phase, 0.7f) < 0.005f, what);
+
+    // Прямоугольное окно: целый тон не попадает в другие целые бины и в постоянную составляющую
+    for (uint32_t i = 1; i < 4; i++)
+    {
+        snprintf(what, sizeof(what), "%s leakage to bin %.0f: %.5f", method_name[method], bins[i], amplitude_of(i));
+        check(amplitude_of(i) < 0.002f, what);
+    }
+
+    // Постоянная составляющая: амплитуда без удвоения
+    make_tone(0.0f, 0.3f, 0.0f, 0.0f, 3 * WINDOW);
+    run(method, bins, 4);
+    snprintf(what, sizeof(what), "%s DC amplitude %.4f", method_name[method], amplitude_of(3));
+    check(fabsf(amplitude_of(3) - 0.3f) < 0.002f, what);
+}
+
+static void test_off_bin(Tone_Method_t method)
+{
+    const float bins[] = {125.0f, Tone_Frequency_To_Bin(12550.0f, SAMPLE_RATE, WINDOW)};
+    const float scalloping = 0.8f * 2.0f / (float)M_PI;     // тон на полбина от центра: |sin(pi/2) / (pi/2)|
+    char what[96];
+
+    make_tone(12550.0f, 0.8f, 0.3f, 0.0f, 3 * WINDOW);
+    run(method, bins, 2);
+
+    snprintf(what, sizeof(what), "%s half-bin scalloping %.4f", method_name[method], amplitude_of(0));
+    check(fabsf(amplitude_of(0) - scalloping) < 0.01f, what);
+
+    // Герцель считает дробный бин точно, скользящее ДПФ округляет его до 126 (тот же провал с другой стороны)
+    float expected = (method == TONE_METHOD_GOERTZEL) ? 0.8f : scalloping;
+    snprintf(what, sizeof(what), "%s fractional bin %.4f", method_name[method], amplitude_of(1));
+    check(fabsf(amplitude_of(1) - expected) < 0.01f, what);
+}
+
+static void test_threshold(Tone_Method_t method)
+{
+    const float bins[] = {200.0f, 300.0f};
+    char what[96];
+
+    // Слабый тон в шуме +/- 0.1: шум в бине ~0.003, тон 0.02 - ниже порога, пустой бин - тем более
+    make_tone(20000.0f, 0.02f, 1.0f, 0.1f, 3 * WINDOW);
+    run(method, bins, 2);
+    snprintf(what, sizeof(what), "%s weak tone %.4f below threshold", method_name[method], amplitude_of(0));
+    check(amplitude_of(0) < THRESHOLD && fabsf(amplitude_of(0) - 0.02f) < 0.01f, what);
+    snprintf(what, sizeof(what), "%s empty bin %.4f below threshold", method_name[method], amplitude_of(1));
+    check(amplitude_of(1) < THRESHOLD, what);
+
+    // Тот же шум, тон 0.2 - выше порога
+    make_tone(20000.0f, 0.2f, 1.0f, 0.1f, 3 * WINDOW);
+    run(method, bins, 2);
+    snprintf(what, sizeof(what), "%s tone %.4f above threshold", method_name[method], amplitude_of(0));
+    check(amplitude_of(0) > THRESHOLD && fabsf(amplitude_of(0) - 0.2f) < 0.01f, what);
+    check(amplitude_of(1) < THRESHOLD, "empty bin next to detected tone");
+}
+
+static void test_errors(void)
+{
+    check(Tone_Init(&detector, TONE_METHOD_GOERTZEL, 0) == TONE_ERROR_WINDOW, "zero window");
+    check(Tone_Init(&detector, TONE_METHOD_GOERTZEL, TONE_MAX_WINDOW + 1) == TONE_ERROR_WINDOW, "window too long");
+    check(Tone_Init(&detector, TONE_METHOD_GOERTZEL, WINDOW) == TONE_OK, "window");
+
+    check(Tone_Add_Bin(&detector, -1.0f) == TONE_ERROR_BIN, "negative bin");
+    check(Tone_Add_Bin(&detector, WINDOW / 2 + 1) == TONE_ERROR_BIN, "bin above window/2");
+    for (uint32_t i = 0; i < TONE_MAX_BINS; i++) check(Tone_Add_Bin(&detector, (float)i) == TONE_OK, "add bin");
+    check(Tone_Add_Bin(&detector, 1.0f) == TONE_ERROR_FULL, "bank full");
+    check(Tone_Get_Result(&detector, TONE_MAX_BINS, NULL, NULL) == TONE_ERROR_BIN, "result of missing bin");
+}
+
+
+int main(void)
+{
+    test_errors();
+
+    for (uint32_t method = TONE_METHOD_GOERTZEL; method <= TONE_METHOD_SLIDING_DFT; method++)
+    {
+        test_on_bin((Tone_Method_t)method);
+        test_off_bin((Tone_Method_t)method);
+        test_threshold((Tone_Method_t)method);
+    }
+
+    printf("%s: %u failures\n", failures ? "FAILED" : "OK", (unsigned)failures);
+    return (int)failures;
+}
@@ -0,0 +1,192 @@
+/***********************************************************************************************************************
+*   Детектор тонов: банк одиночных бинов ДПФ (см. tone_detector.h)
+***********************************************************************************************************************/
+
+#include "tone_detector.h"
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/** Настройка банка */
+Tone_Status_t Tone_Init(Tone_Detector_t *detector, Tone_Method_t method, uint32_t window)
+{
+    if (window == 0 || window > TONE_MAX_WINDOW) return TONE_ERROR_WINDOW;
+
+    detector->method = (uint8_t)method;
+    detector->window = window;
+    detector->count = 0;
+    detector->damping_n = powf(TONE_SDFT_DAMPING, (float)window);
+
+    Tone_Reset(detector);
+    return TONE_OK;
+}
+
+/** Сбросить состояние всех бинов */
+void Tone_Reset(Tone_Detector_t *detector)
+{
+    detector->position = 0;
+    detector->blocks = 0;
+
+    for (uint32_t i = 0; i < detector->window; i++) detector->history[i] = 0.0f;
+
+    for (uint32_t b = 0; b < detector->count; b++)
+    {
+        Tone_Bin_t *bin = &detector->bins[b];
+        bin->s1 = 0.0f;
+        bin->s2 = 0.0f;
+        bin->re = 0.0f;
+        bin->im = 0.0f;
+    }
+}
+
+/** Добавить бин */
+Tone_Status_t Tone_Add_Bin(Tone_Detector_t *detector, float bin)
+{
+    if (detector->count >= TONE_MAX_BINS) return TONE_ERROR_FULL;
+    if (bin < 0.0f || bin > (float)detector->window * 0.5f) return TONE_ERROR_BIN;
+
+    // Скользящее ДПФ точно сокращает выбывающий отсчет только для целого бина
+    if (detector->method == TONE_METHOD_SLIDING_DFT) bin = floorf(bin + 0.5f);
+
+    Tone_Bin_t *entry = &detector->bins[detector->count];
+    double w = 2.0 * M_PI * (double)bin / (double)detector->window;
+
+    entry->bin = bin;
+    entry->coefficient = (float)(2.0 * cos(w));
+    entry->w_re = (float)cos(w);
+    entry->w_im = (float)sin(w);
+    entry->fix_re = (float)cos(-w * (double)(detector->window - 1));
+    entry->fix_im = (float)sin(-w * (double)(detector->window - 1));
+    entry->s1 = 0.0f;
+    entry->s2 = 0.0f;
+    entry->re = 0.0f;
+    entry->im = 0.0f;
+
+    detector->count++;
+    return TONE_OK;
+}
+
+/** Номер бина для частоты */
+float Tone_Frequency_To_Bin(float frequency, float sample_rate, uint32_t window)
+{
+    return frequency * (float)window / sample_rate;
+}
+
+/** Герцель: s[n] = x[n] + 2*cos(w)*s[n-1] - s[n-2], в конце блока
+*   X = exp(-i*w*(N-1)) * (s[N-1] - exp(-i*w) * s[N-2]) */
+static uint32_t tone_push_goertzel(Tone_Detector_t *detector, const float *samples, uint32_t count)
+{
+    uint32_t ready = 0;
+
+    while (count)
+    {
+        // Кусок до конца блока: внутренний цикл по отсчетам без проверок
+        uint32_t chunk = detector->window - detector->position;
+        if (chunk > count) chunk = count;
+
+        for (uint32_t b = 0; b < detector->count; b++)
+        {
+            Tone_Bin_t *bin = &detector->bins[b];
+            float coefficient = bin->coefficient;
+            float s1 = bin->s1;
+            float s2 = bin->s2;
+
+            for (uint32_t i = 0; i < chunk; i++)
+            {
+                float s = samples[i] + coefficient * s1 - s2;
+                s2 = s1;
+                s1 = s;
+            }
+            bin->s1 = s1;
+            bin->s2 = s2;
+        }
+
+        samples += chunk;
+        count -= chunk;
+        detector->position += chunk;
+
+        if (detector->position == detector->window)
+        {
+            for (uint32_t b = 0; b < detector->count; b++)
+            {
+                Tone_Bin_t *bin = &detector->bins[b];
+                float y_re = bin->s1 - bin->w_re * bin->s2;
+                float y_im = bin->w_im * bin->s2;
+
+                bin->re = y_re * bin->fix_re - y_im * bin->fix_im;
+                bin->im = y_re * bin->fix_im + y_im * bin->fix_re;
+                bin->s1 = 0.0f;
+                bin->s2 = 0.0f;
+            }
+            detector->position = 0;
+            detector->blocks++;
+            ready++;
+        }
+    }
+    return ready;
+}
+
+/** Скользящее ДПФ: X[n] = exp(i*w) * (r*X[n-1] + x[n] - r^N * x[n-N])
+*   Для целого бина это ДПФ окна с фазой относительно самого старого отсчета (при r = 1) */
+static uint32_t tone_push_sliding(Tone_Detector_t *detector, const float *samples, uint32_t count)
+{
+    const float r = TONE_SDFT_DAMPING;
+    const float r_n = detector->damping_n;
+    uint32_t ready = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        float x = samples[i];
+        float delta = x - r_n * detector->history[detector->position];
+        detector->history[detector->position] = x;
+
+        for (uint32_t b = 0; b < detector->count; b++)
+        {
+            Tone_Bin_t *bin = &detector->bins[b];
+            float re = r * bin->re + delta;
+            float im = r * bin->im;
+
+            bin->re = re * bin->w_re - im * bin->w_im;
+            bin->im = re * bin->w_im + im * bin->w_re;
+        }
+
+        if (++detector->position == detector->window)
+        {
+            detector->position = 0;
+            detector->blocks++;
+        }
+        if (detector->blocks) ready++;      // пока окно не заполнено, результат неполный
+    }
+    return ready;
+}
+
+/** Подать count отсчетов */
+uint32_t Tone_Push(Tone_Detector_t *detector, const float *samples, uint32_t count)
+{
+    if (detector->method == TONE_METHOD_SLIDING_DFT) return tone_push_sliding(detector, samples, count);
+    return tone_push_goertzel(detector, samples, count);
+}
+
+/** Амплитуда и фаза бина */
+Tone_Status_t Tone_Get_Result(const Tone_Detector_t *detector, uint32_t index, float *amplitude, float *phase)
+{
+    if (index >= detector->count) return TONE_ERROR_BIN;
+
+    const Tone_Bin_t *bin = &detector->bins[index];
+    float scale = 2.0f / (float)detector->window;
+
+    // Постоянная составляющая и бин window/2 не раздваиваются на +/- частоты
+    if (bin->bin == 0.0f || bin->bin == (float)detector->window * 0.5f) scale *= 0.5f;
+
+    // Затухание скользящего ДПФ: вес окна sum(r^m) = (1 - r^N) / (1 - r) вместо N
+    if (detector->method == TONE_METHOD_SLIDING_DFT)
+    {
+        scale *= (float)detector->window * (1.0f - TONE_SDFT_DAMPING) / (1.0f - detector->damping_n);
+    }
+
+    if (amplitude) *amplitude = sqrtf(bin->re * bin->re + bin->im * bin->im) * scale;
+    if (phase) *phase = atan2f(bin->im, bin->re);
+    return TONE_OK;
+}
@@ -0,0 +1,90 @@
+/***********************************************************************************************************************
+*   Детектор тонов: банк одиночных бинов ДПФ
+*       Когда нужны лишь несколько частот (например, проверить, что AD9833 выдает заданную частоту), полное БПФ
+*   не нужно: каждый бин обновляется за O(1) на отсчет.
+*
+*   - TONE_METHOD_GOERTZEL: алгоритм Герцеля по блокам из window отсчетов. Номер бина может быть дробным
+*     (любая частота), результат обновляется в конце каждого блока.
+*   - TONE_METHOD_SLIDING_DFT: скользящее ДПФ по последним window отсчетам, результат готов после каждого отсчета.
+*     Номер бина округляется до целого. Для устойчивости в float используется затухание r = TONE_SDFT_DAMPING.
+*
+*       Результат бина - амплитуда синусоиды (для тона точно в центре бина 2*|X|/window) и фаза X в радианах
+*   относительно первого отсчета блока (окна).
+*
+*   Пример (fs = 100 кГц, блок 1000 отсчетов => бин 100 Гц):
+*       static Tone_Detector_t detector;
+*       Tone_Init(&detector, TONE_METHOD_GOERTZEL, 1000);
+*       Tone_Add_Bin(&detector, Tone_Frequency_To_Bin(12500.0f, 100000.0f, 1000));
+*       if (Tone_Push(&detector, samples, count)) Tone_Get_Result(&detector, 0, &amplitude, &phase);
+***********************************************************************************************************************/
+
+#ifndef __TONE_DETECTOR_H__
+#define __TONE_DETECTOR_H__
+
+#include <stdint.h>
+
+#define TONE_MAX_BINS           8           // бинов в банке
+#define TONE_MAX_WINDOW         1024        // максимальная длина окна (история отсчетов скользящего ДПФ)
+#define TONE_SDFT_DAMPING       0.99999f    // затухание скользящего ДПФ (ошибки округления не накапливаются)
+
+typedef enum
+{
+    TONE_METHOD_GOERTZEL = 0,
+    TONE_METHOD_SLIDING_DFT = 1
+}
+Tone_Method_t;
+
+typedef enum
+{
+    TONE_OK = 0,
+    TONE_ERROR_WINDOW = 1,      // длина окна 0 или больше TONE_MAX_WINDOW
+    TONE_ERROR_FULL = 2,        // в банке уже TONE_MAX_BINS бинов
+    TONE_ERROR_BIN = 3          // бин вне 0 ... window/2 или номер бина в банке не существует
+}
+Tone_Status_t;
+
+/** Один бин банка */
+typedef struct
+{
+    float bin;              // номер бина (частота = bin * fs / window)
+    float coefficient;      // Герцель: 2*cos(w)
+    float w_re, w_im;       // exp(+i*w), w = 2*pi*bin/window
+    float fix_re, fix_im;   // Герцель: поворот результата к началу блока exp(-i*w*(window-1))
+    float s1, s2;           // Герцель: состояние фильтра
+    float re, im;           // последний результат X (Герцель - по концу блока, скользящее ДПФ - текущее)
+}
+Tone_Bin_t;
+
+typedef struct
+{
+    Tone_Bin_t bins[TONE_MAX_BINS];
+    float history[TONE_MAX_WINDOW];     // скользящее ДПФ: последние window отсчетов
+    float damping_n;                    // r^window
+    uint32_t window;
+    uint32_t count;                     // бинов в банке
+    uint32_t position;                  // номер отсчета в блоке / в истории
+    uint32_t blocks;                    // завершенных блоков (Герцель) или окон (скользящее ДПФ)
+    uint8_t  method;                    // Tone_Method_t
+}
+Tone_Detector_t;
+
+/** Настройка банка (бины удаляются) */
+Tone_Status_t Tone_Init(Tone_Detector_t *detector, Tone_Method_t method, uint32_t window);
+
+/** Добавить бин (для скользящего ДПФ округляется до целого), return: TONE_OK */
+Tone_Status_t Tone_Add_Bin(Tone_Detector_t *detector, float bin);
+
+/** Номер бина для частоты frequency при частоте дискретизации sample_rate */
+float Tone_Frequency_To_Bin(float frequency, float sample_rate, uint32_t window);
+
+/** Подать count отсчетов, каждый бин обновляется за O(1) на отсчет
+*   return: сколько раз за вызов обновились результаты (Герцель - конец блока, скользящее ДПФ - заполненное окно) */
+uint32_t Tone_Push(Tone_Detector_t *detector, const float *samples, uint32_t count);
+
+/** Амплитуда и фаза (радианы) бина index по последнему результату */
+Tone_Status_t Tone_Get_Result(const Tone_Detector_t *detector, uint32_t index, float *amplitude, float *phase);
+
+/** Сбросить состояние всех бинов (бины сохраняются) */
+void Tone_Reset(Tone_Detector_t *detector);
+
+#endif /* __TONE_DETECTOR_H__ */